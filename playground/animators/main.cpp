@@ -0,0 +1,401 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    A headless benchmark for the animators: N windows with M animators
+    each are rendered offscreen, while the animators are driven by
+    a virtual clock in fixed frame steps. This way the results do not
+    depend on the speed of the machine or the scheduling of the frames.
+
+    For each frame the time for advancing the animators, polishing
+    and synchronizing the scene graph is measured. When a window does
+    not deliver its frame within a second the run is aborted.
+
+    Polishing happens at the beginning of a frame - before
+    QQuickWindow::afterAnimating - and is taken from the Layout
+    events of the controls, that are recorded by QskFrameProfiler.
+
+    Usage: animators [ windows ] [ animators ] [ frames ]
+ */
+
+#include <QskAnimationHint.h>
+#include <QskAnimator.h>
+#include <QskBox.h>
+#include <QskFlickAnimator.h>
+#include <QskFrameProfiler.h>
+#include <QskGradient.h>
+#include <QskLinearBox.h>
+#include <QskPushButton.h>
+#include <QskSkin.h>
+#include <QskSkinManager.h>
+#include <QskStackBox.h>
+#include <QskStackBoxAnimator.h>
+#include <QskWindow.h>
+
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QHash>
+#include <QTimer>
+#include <QDebug>
+
+#include <vector>
+
+static const int qskFrameStep = 16; // ms
+static const int qskCycle = 30; // frames between starting new animations
+static const int qskDuration = 400; // ms
+
+static qint64 qskVirtualTime = 0;
+
+static qint64 qskVirtualClock()
+{
+    return qskVirtualTime;
+}
+
+namespace
+{
+    class FlickAnimator final : public QskFlickAnimator
+    {
+      public:
+        FlickAnimator( QQuickItem* item )
+            : m_item( item )
+        {
+            setWindow( item->window() );
+        }
+
+      protected:
+        void translate( qreal dx, qreal dy ) override
+        {
+            m_item->setPosition( m_item->position() + QPointF( dx, dy ) );
+        }
+
+      private:
+        QQuickItem* m_item;
+    };
+
+    class Timings
+    {
+      public:
+        void add( qint64 nsecs )
+        {
+            total += nsecs;
+            maximum = qMax( maximum, nsecs );
+        }
+
+        qint64 total = 0;
+        qint64 maximum = 0;
+    };
+
+    class Benchmark : public QObject
+    {
+        Q_OBJECT
+
+      public:
+        Benchmark( int windowCount, int animatorCount );
+        ~Benchmark() override;
+
+        bool run( int frameCount );
+
+      private Q_SLOTS:
+        void advanced( QQuickWindow* );
+
+      private:
+        void populate( QskWindow*, int animatorCount );
+        void startAnimations( int cycle );
+        bool renderFrame();
+        void addPolishTimings();
+
+        void connectWindow( QskWindow* );
+
+        std::vector< QskWindow* > m_windows;
+
+        std::vector< QskPushButton* > m_buttons;
+        std::vector< QskStackBox* > m_stackBoxes;
+        std::vector< FlickAnimator* > m_flickAnimators;
+
+        QElapsedTimer m_timer;
+        QEventLoop m_eventLoop;
+        QTimer m_timeout;
+        int m_pendingFrames = 0;
+
+        Timings m_advance;
+        Timings m_polish;
+        Timings m_sync;
+        int m_frameCount = 0;
+    };
+}
+
+Benchmark::Benchmark( int windowCount, int animatorCount )
+{
+    // a safety net, when the platform does not deliver frames
+    m_timeout.setSingleShot( true );
+    m_timeout.setInterval( 1000 );
+    connect( &m_timeout, &QTimer::timeout,
+        &m_eventLoop, [ this ]() { m_eventLoop.exit( 1 ); } );
+
+    QskAnimator::addAdvanceHandler( this,
+        SLOT(advanced(QQuickWindow*)), Qt::DirectConnection );
+
+    for ( int i = 0; i < windowCount; i++ )
+    {
+        auto window = new QskWindow();
+        window->resize( 800, 600 );
+
+        connectWindow( window );
+        populate( window, animatorCount );
+
+        window->show();
+
+        m_windows.push_back( window );
+    }
+}
+
+Benchmark::~Benchmark()
+{
+    qDeleteAll( m_flickAnimators );
+    qDeleteAll( m_windows );
+}
+
+void Benchmark::connectWindow( QskWindow* window )
+{
+    /*
+        Our connection to afterAnimating is made before the animators
+        register the window, so that we are called before they are advanced.
+        As we are using the software renderer, everything happens in the
+        GUI thread.
+     */
+    connect( window, &QQuickWindow::afterAnimating,
+        this, [ this ]() { m_timer.start(); }, Qt::DirectConnection );
+
+    connect( window, &QQuickWindow::beforeSynchronizing,
+        this, [ this ]() { m_timer.start(); }, Qt::DirectConnection );
+
+    connect( window, &QQuickWindow::afterSynchronizing, this,
+        [ this ]() { m_sync.add( m_timer.nsecsElapsed() ); }, Qt::DirectConnection );
+
+    connect( window, &QQuickWindow::frameSwapped, this,
+        [ this ]()
+        {
+            if ( --m_pendingFrames <= 0 )
+                m_eventLoop.quit();
+        } );
+}
+
+void Benchmark::populate( QskWindow* window, int animatorCount )
+{
+    // the kinds of animators are distributed in a round robin way
+
+    auto box = new QskLinearBox( Qt::Horizontal, 10 );
+    window->addItem( box );
+
+    for ( int i = 0; i < animatorCount; i++ )
+    {
+        switch( i % 5 )
+        {
+            case 0:
+            {
+                // hint animators
+                auto button = new QskPushButton( "Button", box );
+
+                const auto aspect = QskPushButton::Panel | QskAspect::Color;
+
+                button->setAnimationHint( aspect, QskAnimationHint( qskDuration ) );
+                button->setGradientHint( QskPushButton::Panel, Qt::lightGray );
+                button->setGradientHint( QskPushButton::Panel | QskControl::Hovered,
+                    QskGradient( Qt::darkGray, Qt::gray ) );
+
+                m_buttons.push_back( button );
+                break;
+            }
+            case 1:
+            case 2:
+            case 3:
+            {
+                auto stackBox = new QskStackBox( box );
+                stackBox->setPanel( true );
+
+                QskStackBoxAnimator* animator;
+
+                if ( i % 5 == 1 )
+                    animator = new QskStackBoxAnimator1( stackBox );
+                else if ( i % 5 == 2 )
+                    animator = new QskStackBoxAnimator2( stackBox );
+                else
+                    animator = new QskStackBoxAnimator3( stackBox );
+
+                animator->setDuration( qskDuration );
+                stackBox->setAnimator( animator );
+
+                for ( int j = 0; j < 2; j++ )
+                {
+                    auto page = new QskBox( true );
+                    page->setFillGradient( j ? Qt::darkCyan : Qt::darkYellow );
+
+                    stackBox->addItem( page );
+                }
+
+                m_stackBoxes.push_back( stackBox );
+                break;
+            }
+            case 4:
+            {
+                auto item = new QskBox( true, box );
+                item->setFillGradient( Qt::darkRed );
+
+                m_flickAnimators.push_back( new FlickAnimator( item ) );
+                break;
+            }
+        }
+    }
+}
+
+void Benchmark::startAnimations( int cycle )
+{
+    const bool on = cycle % 2;
+
+    for ( auto button : m_buttons )
+        button->setSkinStateFlag( QskControl::Hovered, on );
+
+    for ( auto stackBox : m_stackBoxes )
+        stackBox->setCurrentIndex( on ? 1 : 0 );
+
+    for ( auto animator : m_flickAnimators )
+        animator->flick( on ? 0.0 : 180.0, 500.0 );
+
+    if ( cycle % 4 == 3 )
+    {
+        // skin transition
+        if ( auto skin = qskSkinManager->skin() )
+        {
+            const auto scheme = ( skin->colorScheme() == QskSkin::DarkScheme )
+                ? QskSkin::LightScheme : QskSkin::DarkScheme;
+
+            skin->setColorScheme( scheme );
+        }
+    }
+}
+
+bool Benchmark::renderFrame()
+{
+    qskVirtualTime += qskFrameStep;
+
+    m_pendingFrames = int( m_windows.size() );
+
+    for ( auto window : m_windows )
+        window->update();
+
+    m_timeout.start();
+    const auto status = m_eventLoop.exec();
+    m_timeout.stop();
+
+    if ( status != 0 )
+    {
+        /*
+            The timings of a frame are collected window by window, while
+            the frame is in progress. Those of an incomplete frame can't
+            be separated, so the run is aborted.
+         */
+        qWarning() << "animators:" << m_pendingFrames
+            << "window(s) without a frame, aborting";
+
+        return false;
+    }
+
+    return true;
+}
+
+void Benchmark::addPolishTimings()
+{
+    QHash< const QQuickWindow*, qint64 > polishTimes;
+
+    const auto events = QskFrameProfiler::events();
+    for ( const auto& event : events )
+    {
+        if ( event.phase == QskFrameProfiler::Layout )
+            polishTimes[ event.window ] += event.duration;
+    }
+
+    for ( const auto window : m_windows )
+        m_polish.add( polishTimes.value( window ) );
+
+    QskFrameProfiler::clear();
+}
+
+void Benchmark::advanced( QQuickWindow* )
+{
+    m_advance.add( m_timer.nsecsElapsed() );
+    m_timer.start();
+}
+
+bool Benchmark::run( int frameCount )
+{
+    // warming up: the animators need to have initially painted items
+    for ( int i = 0; i < 5; i++ )
+    {
+        if ( !renderFrame() )
+            return false;
+    }
+
+    m_advance = m_polish = m_sync = Timings();
+
+    QskFrameProfiler::setEnabled( true );
+
+    for ( int frame = 0; frame < frameCount; frame++ )
+    {
+        if ( frame % qskCycle == 0 )
+            startAnimations( frame / qskCycle );
+
+        if ( !renderFrame() )
+        {
+            QskFrameProfiler::setEnabled( false );
+            return false;
+        }
+
+        addPolishTimings();
+    }
+
+    QskFrameProfiler::setEnabled( false );
+
+    const auto frames = qMax( frameCount * int( m_windows.size() ), 1 );
+
+    auto report = [ frames ]( const char* what, const Timings& timings )
+    {
+        qDebug().nospace() << what << ": average "
+            << timings.total / 1000.0 / frames << "us, maximum "
+            << timings.maximum / 1000.0 << "us";
+    };
+
+    report( "advance", m_advance );
+    report( "polish", m_polish );
+    report( "sync", m_sync );
+
+    QskAnimator::debugStatistics( qDebug() );
+
+    return true;
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QQuickWindow::setSceneGraphBackend( QStringLiteral( "software" ) );
+
+    QGuiApplication app( argc, argv );
+
+    const auto args = app.arguments();
+
+    const int windowCount = ( args.count() > 1 ) ? args[1].toInt() : 1;
+    const int animatorCount = ( args.count() > 2 ) ? args[2].toInt() : 50;
+    const int frameCount = ( args.count() > 3 ) ? args[3].toInt() : 600;
+
+    QskAnimator::setTimeSource( qskVirtualClock );
+    qskSkinManager->setTransitionHint( QskAnimationHint( qskDuration ) );
+
+    Benchmark benchmark( windowCount, animatorCount );
+    return benchmark.run( frameCount ) ? 0 : 1;
+}
+
+#include "main.moc"
@@ -0,0 +1,220 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    Compares the boxes rendered by QskBoxShaderNode with the ones
+    of the tessellated QskBoxRectangleNode. The same set of boxes is
+    rendered twice - with and without QSK_SHADER_BOXES - in processes of
+    their own, as the environment variable is read only once.
+
+    The shader node needs a scene graph backend, that supports custom
+    materials. Without a GPU an OpenGL software rasterizer can be used:
+
+        QT_QPA_PLATFORM=offscreen LIBGL_ALWAYS_SOFTWARE=1 boxdiff
+
+    Backends without custom materials ( software, OpenVG ) are rejected,
+    as they would not show the shader node at all.
+
+    The number of pixels, where a color channel differs by more than
+    the tolerance, is reported and an image of the differences is
+    written to boxdiff.png.
+
+    Usage: boxdiff [ tolerance ]
+ */
+
+#include <QskBox.h>
+#include <QskBoxBorderColors.h>
+#include <QskBoxBorderMetrics.h>
+#include <QskBoxShapeMetrics.h>
+#include <QskGradient.h>
+#include <QskWindow.h>
+
+#include <QGuiApplication>
+#include <QEventLoop>
+#include <QImage>
+#include <QProcess>
+#include <QSGRendererInterface>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <QDebug>
+
+namespace
+{
+    class Box : public QskBox
+    {
+      public:
+        Box( const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& border,
+                const QskBoxBorderColors& borderColors, const QskGradient& gradient,
+                QQuickItem* parent )
+            : QskBox( true, parent )
+        {
+            setBoxShapeHint( Panel, shape );
+            setBoxBorderMetricsHint( Panel, border );
+            setBoxBorderColorsHint( Panel, borderColors );
+            setGradientHint( Panel, gradient );
+        }
+    };
+
+    void populate( QQuickItem* parentItem )
+    {
+        QskGradient vertical( Qt::darkCyan, Qt::yellow );
+        vertical.setLinearDirection( Qt::Vertical );
+
+        QskGradient diagonal( Qt::darkBlue, Qt::white );
+        diagonal.setLinearDirection( 0.0, 0.0, 1.0, 1.0 );
+
+        const QskBoxBorderColors border( Qt::darkRed );
+
+        ( void ) new Box( 10.0, 2.0, border, Qt::lightGray, parentItem );
+        ( void ) new Box( 20.0, 1.0, border, vertical, parentItem );
+        ( void ) new Box( 0.0, 4.0, border, diagonal, parentItem );
+        ( void ) new Box( { 100.0, Qt::RelativeSize }, 3.0, border, Qt::darkGreen, parentItem );
+        ( void ) new Box( { 5.0, 10.0, 20.0, 40.0 }, 2.0, border, vertical, parentItem );
+        ( void ) new Box( 30.0, 0.0, QskBoxBorderColors(), diagonal, parentItem );
+        ( void ) new Box( 15.0, 6.0, border, QskGradient(), parentItem );
+        ( void ) new Box( 0.0, 0.0, QskBoxBorderColors(), Qt::darkMagenta, parentItem );
+
+        const auto boxes = parentItem->childItems();
+
+        for ( int i = 0; i < boxes.count(); i++ )
+        {
+            auto box = static_cast< QskBox* >( boxes[i] );
+
+            // odd columns with fractional positions
+            const qreal x = 10.0 + ( i % 4 ) * 190.0 + ( ( i % 2 ) ? 0.5 : 0.0 );
+            const qreal y = 10.0 + ( i / 4 ) * 190.0;
+
+            box->setGeometry( x, y, 180.0, 180.0 );
+        }
+    }
+
+    QImage renderBoxes()
+    {
+        QskWindow window;
+        window.setAutoLayoutChildren( false );
+        window.setColor( Qt::white );
+        window.resize( 780, 400 );
+
+        populate( window.contentItem() );
+
+        QEventLoop eventLoop;
+
+        QObject::connect( &window, &QQuickWindow::frameSwapped,
+            &eventLoop, &QEventLoop::quit );
+
+        QTimer::singleShot( 2000, &eventLoop, &QEventLoop::quit );
+
+        window.show();
+        eventLoop.exec();
+
+        const auto api = window.rendererInterface()->graphicsApi();
+        if ( api == QSGRendererInterface::Software || api == QSGRendererInterface::OpenVG )
+        {
+            // the shader node would not be rendered at all
+            qWarning() << "boxdiff: the scene graph backend has no custom materials";
+            return QImage();
+        }
+
+        return window.grabWindow().convertToFormat( QImage::Format_ARGB32 );
+    }
+
+    QImage difference( const QImage& image1, const QImage& image2,
+        int tolerance, int& pixelCount, int& maxDiff )
+    {
+        QImage diff( image1.size(), QImage::Format_ARGB32 );
+        diff.fill( Qt::white );
+
+        pixelCount = maxDiff = 0;
+
+        for ( int y = 0; y < image1.height(); y++ )
+        {
+            const auto line1 = reinterpret_cast< const QRgb* >( image1.constScanLine( y ) );
+            const auto line2 = reinterpret_cast< const QRgb* >( image2.constScanLine( y ) );
+            auto lineDiff = reinterpret_cast< QRgb* >( diff.scanLine( y ) );
+
+            for ( int x = 0; x < image1.width(); x++ )
+            {
+                const auto d = qMax( qMax( qAbs( qRed( line1[x] ) - qRed( line2[x] ) ),
+                    qAbs( qGreen( line1[x] ) - qGreen( line2[x] ) ) ),
+                    qMax( qAbs( qBlue( line1[x] ) - qBlue( line2[x] ) ),
+                    qAbs( qAlpha( line1[x] ) - qAlpha( line2[x] ) ) ) );
+
+                maxDiff = qMax( maxDiff, d );
+
+                if ( d > tolerance )
+                {
+                    pixelCount++;
+                    lineDiff[x] = qRgb( 255, 255 - d, 255 - d );
+                }
+            }
+        }
+
+        return diff;
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    const auto args = app.arguments();
+
+    if ( args.count() == 3 && args[1] == QStringLiteral( "-o" ) )
+    {
+        // child process: rendering the boxes only
+        const auto image = renderBoxes();
+        return ( !image.isNull() && image.save( args[2] ) ) ? 0 : 1;
+    }
+
+    const int tolerance = ( args.count() > 1 ) ? args[1].toInt() : 8;
+
+    QTemporaryDir tmpDir;
+    if ( !tmpDir.isValid() )
+        return 1;
+
+    QImage images[2];
+
+    for ( int i = 0; i < 2; i++ )
+    {
+        const auto fileName = tmpDir.filePath( QStringLiteral( "boxes%1.png" ).arg( i ) );
+
+        auto env = QProcessEnvironment::systemEnvironment();
+        if ( i == 1 )
+            env.insert( QStringLiteral( "QSK_SHADER_BOXES" ), QStringLiteral( "1" ) );
+        else
+            env.remove( QStringLiteral( "QSK_SHADER_BOXES" ) );
+
+        QProcess process;
+        process.setProcessEnvironment( env );
+        process.setProcessChannelMode( QProcess::ForwardedChannels );
+        process.start( app.applicationFilePath(), { QStringLiteral( "-o" ), fileName } );
+        process.waitForFinished( -1 );
+
+        if ( process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0 )
+        {
+            qWarning() << "boxdiff: rendering failed";
+            return 1;
+        }
+
+        images[i].load( fileName );
+        images[i] = images[i].convertToFormat( QImage::Format_ARGB32 );
+    }
+
+    if ( images[0].isNull() || images[0].size() != images[1].size() )
+    {
+        qWarning() << "boxdiff: rendering failed";
+        return 1;
+    }
+
+    int pixelCount, maxDiff;
+    const auto diff = difference( images[0], images[1], tolerance, pixelCount, maxDiff );
+
+    diff.save( QStringLiteral( "boxdiff.png" ) );
+
+    qDebug().nospace() << "pixels differing by more than " << tolerance
+        << ": " << pixelCount << ", maximum difference: " << maxDiff;
+
+    return ( pixelCount > 0 ) ? 1 : 0;
+}
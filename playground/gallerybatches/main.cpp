@@ -0,0 +1,245 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    Counts the scene graph nodes and the batches of the renderer for
+    the pages of the gallery example. The pages are rendered twice - with
+    and without QSK_PREFER_SHADER_COLORS - in processes of their own,
+    as the environment variable is read only once:
+
+        - colored geometry: all fillings share QSGVertexColorMaterial
+        - shader colors: monochrome fillings use a QSGFlatColorMaterial,
+          that is shared with all other fillings of the same color
+
+    The nodes are taken from QskObjectCounter::snapshot(), the batches
+    from the output of the batch renderer ( QSG_RENDERER_DEBUG=render ).
+    The software backend has no batch renderer and reports no batches.
+
+    Usage: gallerybatches
+ */
+
+#include "progressbar/ProgressBarPage.h"
+#include "inputs/InputPage.h"
+#include "button/ButtonPage.h"
+#include "selector/SelectorPage.h"
+#include "dialog/DialogPage.h"
+#include "listbox/ListBoxPage.h"
+
+#include <SkinnyShapeProvider.h>
+
+#include <QskGraphic.h>
+#include <QskGraphicIO.h>
+#include <QskGraphicProvider.h>
+#include <QskObjectCounter.h>
+#include <QskWindow.h>
+
+#include <QGuiApplication>
+#include <QEventLoop>
+#include <QMutex>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QTimer>
+#include <QDebug>
+
+#include <functional>
+
+namespace
+{
+    class GraphicProvider : public QskGraphicProvider
+    {
+      protected:
+        const QskGraphic* loadGraphic( const QString& id ) const override
+        {
+            const QString path = QStringLiteral( ":gallery/icons/qvg/" )
+                + id + QStringLiteral( ".qvg" );
+
+            const auto graphic = QskGraphicIO::read( path );
+            return graphic.isNull() ? nullptr : new QskGraphic( graphic );
+        }
+    };
+
+    /*
+        The batch renderer reports the batches of each frame
+        on the render thread.
+     */
+    QMutex batchMutex;
+    int opaqueBatches = -1;
+    int alphaBatches = -1;
+
+    QtMessageHandler defaultMessageHandler = nullptr;
+
+    void messageHandler( QtMsgType type,
+        const QMessageLogContext& context, const QString& message )
+    {
+        if ( message.startsWith( QStringLiteral( "Rendering:" ) ) )
+        {
+            /*
+                " -> Opaque: N nodes in M batches...", where QDebug
+                might have inserted additional spaces
+             */
+
+            static const QRegularExpression opaqueRegExp(
+                QStringLiteral( "Opaque:\\s*\\d+\\s+nodes in\\s+(\\d+)\\s+batches" ) );
+
+            static const QRegularExpression alphaRegExp(
+                QStringLiteral( "Alpha:\\s*\\d+\\s+nodes in\\s+(\\d+)\\s+batches" ) );
+
+            const auto opaqueMatch = opaqueRegExp.match( message );
+            const auto alphaMatch = alphaRegExp.match( message );
+
+            QMutexLocker locker( &batchMutex );
+
+            opaqueBatches = opaqueMatch.hasMatch() ? opaqueMatch.captured( 1 ).toInt() : -1;
+            alphaBatches = alphaMatch.hasMatch() ? alphaMatch.captured( 1 ).toInt() : -1;
+
+            return;
+        }
+
+        if ( defaultMessageHandler )
+            defaultMessageHandler( type, context, message );
+    }
+
+    bool waitForFrame( QQuickWindow* window )
+    {
+        QEventLoop eventLoop;
+
+        QObject::connect( window, &QQuickWindow::frameSwapped,
+            &eventLoop, &QEventLoop::quit );
+
+        // a safety net, when the platform does not deliver frames
+        QTimer timeout;
+        timeout.setSingleShot( true );
+        QObject::connect( &timeout, &QTimer::timeout, &eventLoop,
+            [ &eventLoop ]() { eventLoop.exit( 1 ); } );
+
+        timeout.start( 2000 );
+
+        return eventLoop.exec() == 0;
+    }
+
+    int countNodes( const QskObjectCounter::Snapshot& snapshot, const char* type = nullptr )
+    {
+        if ( type )
+            return snapshot.nodes.value( type );
+
+        int count = 0;
+        for ( const auto n : snapshot.nodes )
+            count += n;
+
+        return count;
+    }
+
+    int renderPages()
+    {
+        using Factory = std::function< QQuickItem*() >;
+
+        const QVector< QPair< const char*, Factory > > pages =
+        {
+            { "Buttons", []() { return new ButtonPage(); } },
+            { "Inputs", []() { return new InputPage(); } },
+            { "Indicators", []() { return new ProgressBarPage(); } },
+            { "Selectors", []() { return new SelectorPage(); } },
+            { "Dialogs", []() { return new DialogPage(); } },
+            { "ListBox", []() { return new ListBoxPage(); } }
+        };
+
+        QskObjectCounter counter;
+
+        QskWindow window;
+        window.resize( 800, 600 );
+        window.show();
+
+        for ( const auto& page : pages )
+        {
+            auto item = page.second();
+            window.addItem( item );
+
+            // the first frame is for the layout, the second for counting the nodes
+
+            if ( !waitForFrame( &window ) )
+            {
+                qWarning() << "gallerybatches: no frame rendered, aborting";
+                return 1;
+            }
+
+            ( void ) counter.snapshot();
+
+            // a static page does not schedule another frame on its own
+            window.update();
+
+            if ( !waitForFrame( &window ) )
+            {
+                qWarning() << "gallerybatches: no frame rendered, aborting";
+                return 1;
+            }
+
+            const auto snapshot = counter.snapshot();
+
+            int opaque, alpha;
+            {
+                QMutexLocker locker( &batchMutex );
+
+                opaque = opaqueBatches;
+                alpha = alphaBatches;
+            }
+
+            qDebug().nospace() << "  " << page.first << ": nodes: "
+                << countNodes( snapshot ) << ", geometry nodes: "
+                << countNodes( snapshot, "geometry" ) << ", batches: "
+                << opaque << " opaque, " << alpha << " alpha";
+
+            delete item;
+        }
+
+        return 0;
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    if ( argc == 2 && qstrcmp( argv[1], "-pages" ) == 0 )
+    {
+        // child process: rendering the pages
+
+        qputenv( "QSG_RENDERER_DEBUG", "render" );
+        defaultMessageHandler = qInstallMessageHandler( messageHandler );
+
+        QGuiApplication app( argc, argv );
+
+        Qsk::addGraphicProvider( QString(), new GraphicProvider() );
+        Qsk::addGraphicProvider( "shapes", new SkinnyShapeProvider() );
+
+        return renderPages();
+    }
+
+    QGuiApplication app( argc, argv );
+
+    int result = 0;
+
+    for ( int i = 0; i < 2; i++ )
+    {
+        auto env = QProcessEnvironment::systemEnvironment();
+        if ( i == 1 )
+            env.insert( QStringLiteral( "QSK_PREFER_SHADER_COLORS" ), QStringLiteral( "1" ) );
+        else
+            env.remove( QStringLiteral( "QSK_PREFER_SHADER_COLORS" ) );
+
+        qDebug() << ( ( i == 1 ) ? "Shader colors:" : "Colored geometry:" );
+
+        QProcess process;
+        process.setProcessEnvironment( env );
+        process.setProcessChannelMode( QProcess::ForwardedChannels );
+        process.start( app.applicationFilePath(), { QStringLiteral( "-pages" ) } );
+        process.waitForFinished( -1 );
+
+        if ( process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0 )
+            result = 1;
+    }
+
+    return result;
+}
@@ -0,0 +1,195 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    A headless benchmark for flicking through a list view with a huge
+    number of rows. The view is rendered offscreen with the software
+    backend and scrolled by a fixed distance for each frame:
+
+        - "flick": small steps, where most cells stay visible
+        - "jump": large steps, where all visible cells are replaced
+
+    For each frame the time from requesting an update until the frame
+    has been swapped is measured. Frames, that have not been swapped
+    within a second, are counted as timeouts and excluded from the
+    timings. Any timeout makes the benchmark fail.
+
+    Usage: listviews [ rows ] [ frames ]
+ */
+
+#include <QskModelListView.h>
+#include <QskWindow.h>
+
+#include <QAbstractTableModel>
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTimer>
+#include <QDebug>
+
+namespace
+{
+    class Model : public QAbstractTableModel
+    {
+      public:
+        Model( int rowCount )
+            : m_rowCount( rowCount )
+        {
+        }
+
+        int rowCount( const QModelIndex& parent ) const override
+        {
+            return parent.isValid() ? 0 : m_rowCount;
+        }
+
+        int columnCount( const QModelIndex& parent ) const override
+        {
+            return parent.isValid() ? 0 : 4;
+        }
+
+        QVariant data( const QModelIndex& index, int role ) const override
+        {
+            if ( role == Qt::DisplayRole )
+            {
+                return QStringLiteral( "Row %1, Column %2" )
+                    .arg( index.row() ).arg( index.column() );
+            }
+
+            return QVariant();
+        }
+
+      private:
+        const int m_rowCount;
+    };
+
+    class Timings
+    {
+      public:
+        void add( qint64 nsecs )
+        {
+            if ( nsecs < 0 )
+            {
+                // no frame: the timeout would distort the average
+                timeouts++;
+                return;
+            }
+
+            total += nsecs;
+            maximum = qMax( maximum, nsecs );
+            count++;
+        }
+
+        void report( const char* what ) const
+        {
+            qDebug().nospace() << what << ": average "
+                << total / 1000.0 / qMax( count, 1 ) << "us, maximum "
+                << maximum / 1000.0 << "us, frames: " << count
+                << ", timeouts: " << timeouts;
+        }
+
+        qint64 total = 0;
+        qint64 maximum = 0;
+        int count = 0;
+        int timeouts = 0;
+    };
+
+    class Benchmark
+    {
+      public:
+        Benchmark( int rowCount )
+            : m_model( rowCount )
+        {
+            m_timeout.setSingleShot( true );
+            m_timeout.setInterval( 1000 );
+
+            QObject::connect( &m_timeout, &QTimer::timeout,
+                &m_eventLoop, [ this ]() { m_eventLoop.exit( 1 ); } );
+
+            QObject::connect( &m_window, &QQuickWindow::frameSwapped,
+                &m_eventLoop, &QEventLoop::quit );
+
+            m_listView = new QskModelListView();
+            m_listView->setModel( &m_model );
+
+            m_window.addItem( m_listView );
+            m_window.resize( 800, 600 );
+            m_window.show();
+        }
+
+        // -1, when no frame has been swapped before the timeout
+        qint64 renderFrame()
+        {
+            QElapsedTimer timer;
+            timer.start();
+
+            m_window.update();
+
+            m_timeout.start();
+            const auto status = m_eventLoop.exec();
+            m_timeout.stop();
+
+            return ( status == 0 ) ? timer.nsecsElapsed() : -1;
+        }
+
+        Timings flick( int frameCount, qreal step )
+        {
+            Timings timings;
+
+            const auto maxY = qMax( m_listView->scrollableSize().height()
+                - m_listView->viewContentsRect().height(), 0.0 );
+
+            qreal y = 0.0;
+
+            for ( int i = 0; i < frameCount; i++ )
+            {
+                y += step;
+                if ( y > maxY )
+                    y = 0.0;
+
+                m_listView->setScrollPos( QPointF( 0.0, y ) );
+                timings.add( renderFrame() );
+            }
+
+            return timings;
+        }
+
+      private:
+        Model m_model;
+
+        QskWindow m_window;
+        QskModelListView* m_listView;
+
+        QEventLoop m_eventLoop;
+        QTimer m_timeout;
+    };
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QQuickWindow::setSceneGraphBackend( QStringLiteral( "software" ) );
+
+    QGuiApplication app( argc, argv );
+
+    const auto args = app.arguments();
+
+    const int rowCount = ( args.count() > 1 ) ? args[1].toInt() : 1000000;
+    const int frameCount = ( args.count() > 2 ) ? args[2].toInt() : 1000;
+
+    Benchmark benchmark( rowCount );
+
+    // warming up
+    benchmark.flick( 5, 0.0 );
+
+    const auto flick = benchmark.flick( frameCount, 40.0 );
+    flick.report( "flick" );
+
+    const auto jump = benchmark.flick( frameCount, 100000.0 );
+    jump.report( "jump" );
+
+    return ( flick.timeouts + jump.timeouts > 0 ) ? 1 : 0;
+}
@@ -60,6 +60,68 @@ namespace
     }
 }
 
+namespace
+{
+    /*
+        Kernels for the arrays: simple loops without branches,
+        that can be vectorized by the compiler.
+     */
+
+    template< typename T >
+    inline void minMax( const T* values, qsizetype count, T& min, T& max )
+    {
+        T vMin = values[ 0 ];
+        T vMax = values[ 0 ];
+
+        for ( qsizetype i = 1; i < count; i++ )
+        {
+            const T v = values[ i ];
+
+            vMin = ( v < vMin ) ? v : vMin;
+            vMax = ( v > vMax ) ? v : vMax;
+        }
+
+        min = vMin;
+        max = vMax;
+    }
+
+    template< typename T >
+    QRectF boundingRect( const T* x, const T* y,
+        qsizetype count, QskPlotCurveData::Hints hints )
+    {
+        T xMin, xMax, yMin, yMax;
+
+        if ( hints & QskPlotCurveData::MonotonicX )
+        {
+            xMin = std::min( x[ 0 ], x[ count - 1 ] );
+            xMax = std::max( x[ 0 ], x[ count - 1 ] );
+        }
+        else
+        {
+            minMax( x, count, xMin, xMax );
+        }
+
+        if ( hints & QskPlotCurveData::MonotonicY )
+        {
+            yMin = std::min( y[ 0 ], y[ count - 1 ] );
+            yMax = std::max( y[ 0 ], y[ count - 1 ] );
+        }
+        else
+        {
+            minMax( y, count, yMin, yMax );
+        }
+
+        return QRectF( xMin, yMin, xMax - xMin, yMax - yMin );
+    }
+
+    template< typename T >
+    inline int upperIndex( const T* values, qsizetype count, qreal value )
+    {
+        const auto it = std::upper_bound( values, values + count, value );
+        return ( it == values + count ) ? -1 : int( it - values );
+    }
+}
+
 namespace
 {
     QRectF boundingRect( const QskPlotCurveData* data )
@@ -70,6 +132,20 @@ namespace
 
         const auto hints = data->hints();
 
+        const auto arrays = data->arrays();
+
+        if ( arrays.type == QskPlotCurveData::Arrays::Double )
+        {
+            return boundingRect( static_cast< const double* >( arrays.x ),
+                static_cast< const double* >( arrays.y ), count, hints );
+        }
+
+        if ( arrays.type == QskPlotCurveData::Arrays::Float )
+        {
+            return boundingRect( static_cast< const float* >( arrays.x ),
+                static_cast< const float* >( arrays.y ), count, hints );
+        }
+
         const bool montonicX = hints & QskPlotCurveData::MonotonicX;
         const bool montonicY = hints & QskPlotCurveData::MonotonicY;
 
@@ -152,9 +228,211 @@ namespace
     }
 }
 
+namespace
+{
+    class MinMax
+    {
+      public:
+        inline void add( qsizetype index, qreal y )
+        {
+            if ( indexMin < 0 )
+            {
+                yMin = yMax = y;
+                indexMin = indexMax = index;
+                return;
+            }
+
+            if ( y < yMin )
+            {
+                yMin = y;
+                indexMin = index;
+            }
+
+            if ( y > yMax )
+            {
+                yMax = y;
+                indexMax = index;
+            }
+        }
+
+        inline void add( const MinMax& other )
+        {
+            if ( indexMin < 0 )
+            {
+                *this = other;
+                return;
+            }
+
+            if ( other.yMin < yMin )
+            {
+                yMin = other.yMin;
+                indexMin = other.indexMin;
+            }
+
+            if ( other.yMax > yMax )
+            {
+                yMax = other.yMax;
+                indexMax = other.indexMax;
+            }
+        }
+
+        qreal yMin = 0.0;
+        qreal yMax = 0.0;
+
+        qsizetype indexMin = -1;
+        qsizetype indexMax = -1;
+    };
+
+    template< typename T >
+    inline void addBlocks( const T* y, qsizetype count,
+        qsizetype blockSize, QVector< MinMax >& blocks )
+    {
+        for ( qsizetype i = 0; i < count; i += blockSize )
+        {
+            const auto to = qMin( i + blockSize, count );
+
+            MinMax minMax;
+            for ( auto j = i; j < to; j++ )
+                minMax.add( j, y[ j ] );
+
+            blocks += minMax;
+        }
+    }
+
+    /*
+        Level 0 has the min/max values of blocks of BlockSize points,
+        each further level combines 2 entries of the level below.
+     */
+    class MinMaxPyramid
+    {
+      public:
+        enum { BlockSize = 64 };
+
+        inline void clear() { m_levels.clear(); }
+
+        void build( const QskPlotCurveData* data )
+        {
+            m_levels.clear();
+
+            const auto count = data->count();
+            if ( count < 4 * BlockSize )
+                return;
+
+            QVector< MinMax > blocks;
+            blocks.reserve( ( count + BlockSize - 1 ) / BlockSize );
+
+            const auto arrays = data->arrays();
+
+            if ( arrays.type == QskPlotCurveData::Arrays::Double )
+            {
+                addBlocks( static_cast< const double* >( arrays.y ),
+                    count, BlockSize, blocks );
+            }
+            else if ( arrays.type == QskPlotCurveData::Arrays::Float )
+            {
+                addBlocks( static_cast< const float* >( arrays.y ),
+                    count, BlockSize, blocks );
+            }
+            else
+            {
+                for ( qsizetype i = 0; i < count; i += BlockSize )
+                {
+                    const auto to = qMin( i + BlockSize, count );
+
+                    MinMax minMax;
+                    for ( auto j = i; j < to; j++ )
+                        minMax.add( j, data->pointAt( j ).y() );
+
+                    blocks += minMax;
+                }
+            }
+
+            m_levels.append( blocks );
+
+            while ( m_levels.constLast().count() > 1 )
+            {
+                const auto entries = m_levels.constLast();
+
+                QVector< MinMax > upperEntries;
+                upperEntries.reserve( ( entries.count() + 1 ) / 2 );
+
+                for ( qsizetype i = 0; i < entries.count(); i += 2 )
+                {
+                    auto minMax = entries[ i ];
+                    if ( i + 1 < entries.count() )
+                        minMax.add( entries[ i + 1 ] );
+
+                    upperEntries += minMax;
+                }
+
+                m_levels.append( upperEntries );
+            }
+        }
+
+        MinMax minMax( const QskPlotCurveData* data, qsizetype from, qsizetype to ) const
+        {
+            MinMax minMax;
+
+            auto i = from;
+
+            if ( !m_levels.isEmpty() )
+            {
+                // the points before the first complete block
+                const auto blockStart =
+                    qMin( to + 1, ( ( from + BlockSize - 1 ) / BlockSize ) * BlockSize );
+
+                for ( ; i < blockStart; i++ )
+                    minMax.add( i, data->pointAt( i ).y() );
+
+                // complete blocks, using the highest possible level
+                while ( i + BlockSize - 1 <= to )
+                {
+                    const auto block = i / BlockSize;
+
+                    int level = 0;
+                    while ( level + 1 < m_levels.count() )
+                    {
+                        const auto n = qsizetype( 1 ) << ( level + 1 );
+
+                        if ( ( block % n ) != 0 || ( i + n * BlockSize - 1 > to ) )
+                            break;
+
+                        level++;
+                    }
+
+                    minMax.add( m_levels[ level ][ block >> level ] );
+                    i += qsizetype( BlockSize ) << level;
+                }
+            }
+
+            for ( ; i <= to; i++ )
+                minMax.add( i, data->pointAt( i ).y() );
+
+            return minMax;
+        }
+
+      private:
+        QVector< QVector< MinMax > > m_levels;
+    };
+}
+
+class QskPlotCurveData::PrivateData
+{
+  public:
+    MinMaxPyramid pyramid;
+    bool isDirty = true;
+};
+
 QskPlotCurveData::QskPlotCurveData( QObject* parent )
     : QObject( parent )
+    , m_data( new PrivateData() )
 {
+    connect( this, &QskPlotCurveData::changed, this,
+        [ this ]()
+        {
+            m_data->pyramid.clear();
+            m_data->isDirty = true;
+        } );
 }
 
 QskPlotCurveData::~QskPlotCurveData()
@@ -195,7 +473,24 @@ int QskPlotCurveData::upperIndex( Qt::Orientation orientation, qreal value ) con
 
     int index;
 
-    if ( orientation == Qt::Horizontal )
+    const auto arrays = this->arrays();
+
+    if ( arrays.isValid() )
+    {
+        const auto values = ( orientation == Qt::Horizontal ) ? arrays.x : arrays.y;
+
+        if ( arrays.type == Arrays::Double )
+            index = ::upperIndex( static_cast< const double* >( values ), n, value );
+        else
+            index = ::upperIndex( static_cast< const float* >( values ), n, value );
+
+        if ( ( index == -1 ) && ( value == ( ( orientation == Qt::Horizontal )
+            ? pointAt( n - 1 ).x() : pointAt( n - 1 ).y() ) ) )
+        {
+            index = n - 1;
+        }
+    }
+    else if ( orientation == Qt::Horizontal )
     {
         index = ::upperIndex( this, value, compareX() );
         if ( ( index == -1 ) && ( value == pointAt( n - 1 ).x() ) )
@@ -262,6 +557,35 @@ QPointF QskPlotCurveData::interpolatedPoint(
     }
 }
 
+QskPlotCurveData::Arrays QskPlotCurveData::arrays() const
+{
+    return Arrays();
+}
+
+void QskPlotCurveData::minMaxIndexes( qsizetype from, qsizetype to,
+    qsizetype& indexMin, qsizetype& indexMax ) const
+{
+    from = qMax( from, qsizetype( 0 ) );
+    to = qMin( to, count() - 1 );
+
+    if ( from > to )
+    {
+        indexMin = indexMax = -1;
+        return;
+    }
+
+    if ( m_data->isDirty )
+    {
+        m_data->pyramid.build( this );
+        m_data->isDirty = false;
+    }
+
+    const auto minMax = m_data->pyramid.minMax( this, from, to );
+
+    indexMin = minMax.indexMin;
+    indexMax = minMax.indexMax;
+}
+
 QskPlotCurvePoints::QskPlotCurvePoints( QObject* parent )
     : QskPlotCurveData( parent )
 {
@@ -282,4 +606,96 @@ void QskPlotCurvePoints::setPoints( const QVector< QPointF >& points )
     Q_EMIT changed();
 }
 
+QskPlotCurveArrays::QskPlotCurveArrays( QObject* parent )
+    : QskPlotCurveData( parent )
+{
+}
+
+QskPlotCurveArrays::QskPlotCurveArrays( const QVector< double >& xValues,
+        const QVector< double >& yValues, QObject* parent )
+    : QskPlotCurveData( parent )
+{
+    setValues( xValues, yValues );
+}
+
+void QskPlotCurveArrays::setValues(
+    const QVector< double >& xValues, const QVector< double >& yValues )
+{
+    m_xValues = xValues;
+    m_yValues = yValues;
+
+    if ( m_xValues.count() != m_yValues.count() )
+    {
+        qWarning() << "QskPlotCurveArrays: x and y values differ in size";
+
+        const auto count = qMin( m_xValues.count(), m_yValues.count() );
+        m_xValues.resize( count );
+        m_yValues.resize( count );
+    }
+
+    m_boundingRect = QRectF(); // invalidating
+
+    Q_EMIT changed();
+}
+
+QskPlotCurveData::Arrays QskPlotCurveArrays::arrays() const
+{
+    Arrays arrays;
+
+    if ( !m_xValues.isEmpty() )
+    {
+        arrays.type = Arrays::Double;
+        arrays.x = m_xValues.constData();
+        arrays.y = m_yValues.constData();
+    }
+
+    return arrays;
+}
+
+QskPlotCurveFloatArrays::QskPlotCurveFloatArrays( QObject* parent )
+    : QskPlotCurveData( parent )
+{
+}
+
+QskPlotCurveFloatArrays::QskPlotCurveFloatArrays( const QVector< float >& xValues,
+        const QVector< float >& yValues, QObject* parent )
+    : QskPlotCurveData( parent )
+{
+    setValues( xValues, yValues );
+}
+
+void QskPlotCurveFloatArrays::setValues(
+    const QVector< float >& xValues, const QVector< float >& yValues )
+{
+    m_xValues = xValues;
+    m_yValues = yValues;
+
+    if ( m_xValues.count() != m_yValues.count() )
+    {
+        qWarning() << "QskPlotCurveFloatArrays: x and y values differ in size";
+
+        const auto count = qMin( m_xValues.count(), m_yValues.count() );
+        m_xValues.resize( count );
+        m_yValues.resize( count );
+    }
+
+    m_boundingRect = QRectF(); // invalidating
+
+    Q_EMIT changed();
+}
+
+QskPlotCurveData::Arrays QskPlotCurveFloatArrays::arrays() const
+{
+    Arrays arrays;
+
+    if ( !m_xValues.isEmpty() )
+    {
+        arrays.type = Arrays::Float;
+        arrays.x = m_xValues.constData();
+        arrays.y = m_yValues.constData();
+    }
+
+    return arrays;
+}
+
 #include "moc_QskPlotCurveData.cpp"
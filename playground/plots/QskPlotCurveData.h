@@ -10,6 +10,8 @@
 #include <qrect.h>
 #include <qnamespace.h>
 
+#include <memory>
+
 // Hiding the layout of the data behind an abstract API
 class QskPlotCurveData : public QObject
 {
@@ -35,6 +37,23 @@ class QskPlotCurveData : public QObject
 
     Q_DECLARE_FLAGS( Hints, Hint )
 
+    /*
+        Contiguous arrays of the x and y coordinates ( structure of arrays ),
+        that stay valid until the data is changed.
+     */
+    class Arrays
+    {
+      public:
+        enum Type { Invalid, Float, Double };
+
+        inline bool isValid() const { return type != Invalid; }
+
+        Type type = Invalid;
+
+        const void* x = nullptr;
+        const void* y = nullptr;
+    };
+
     QskPlotCurveData( QObject* parent = nullptr );
     virtual ~QskPlotCurveData();
 
@@ -46,11 +65,31 @@ class QskPlotCurveData : public QObject
     virtual qsizetype count() const = 0;
     virtual QPointF pointAt( qsizetype index ) const = 0;
 
+    /*
+        Optional bulk access to the coordinates. When being available
+        bounding rectangle, lookups and the skinlet iterate over the
+        arrays instead of calling pointAt() for each point.
+        The default implementation returns invalid arrays.
+     */
+    virtual Arrays arrays() const;
+
     virtual QRectF boundingRect() const;
 
     int upperIndex( Qt::Orientation, qreal value ) const;
     QPointF interpolatedPoint( Qt::Orientation, qreal value ) const;
 
+    /*
+        Finds the points with the minimum/maximum y coordinate in [from, to].
+
+        The lookup is done using a pyramid of min/max values for blocks of
+        points, that is built on first use and invalidated with changed().
+        So the costs depend on the number of points in the range only
+        logarithmically, what is f.e used to decimate huge curves to a
+        couple of points for each pixel column.
+     */
+    void minMaxIndexes( qsizetype from, qsizetype to,
+        qsizetype& indexMin, qsizetype& indexMax ) const;
+
   Q_SIGNALS:
     void changed();
 
@@ -59,6 +98,9 @@ class QskPlotCurveData : public QObject
 
   private:
     Hints m_hints = BoundingRectangle;
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
 };
 
 inline QskPlotCurveData::Hints QskPlotCurveData::hints() const
@@ -103,3 +145,97 @@ inline QPointF QskPlotCurvePoints::pointAt( qsizetype index ) const
 {
     return m_points.at( index );
 }
+
+// An implementation offering bulk access to the coordinates
+class QskPlotCurveArrays : public QskPlotCurveData
+{
+    Q_OBJECT
+
+    using Inherited = QskPlotCurveData;
+
+  public:
+    QskPlotCurveArrays( QObject* parent = nullptr );
+    QskPlotCurveArrays( const QVector< double >& xValues,
+        const QVector< double >& yValues, QObject* parent = nullptr );
+
+    void setValues( const QVector< double >& xValues, const QVector< double >& yValues );
+
+    QVector< double > xValues() const;
+    QVector< double > yValues() const;
+
+    qsizetype count() const override;
+    QPointF pointAt( qsizetype index ) const override;
+
+    Arrays arrays() const override;
+
+  private:
+    QVector< double > m_xValues;
+    QVector< double > m_yValues;
+};
+
+inline QVector< double > QskPlotCurveArrays::xValues() const
+{
+    return m_xValues;
+}
+
+inline QVector< double > QskPlotCurveArrays::yValues() const
+{
+    return m_yValues;
+}
+
+inline qsizetype QskPlotCurveArrays::count() const
+{
+    return m_xValues.count();
+}
+
+inline QPointF QskPlotCurveArrays::pointAt( qsizetype index ) const
+{
+    return QPointF( m_xValues.at( index ), m_yValues.at( index ) );
+}
+
+// Like QskPlotCurveArrays, but in single precision: half of the memory
+class QskPlotCurveFloatArrays : public QskPlotCurveData
+{
+    Q_OBJECT
+
+    using Inherited = QskPlotCurveData;
+
+  public:
+    QskPlotCurveFloatArrays( QObject* parent = nullptr );
+    QskPlotCurveFloatArrays( const QVector< float >& xValues,
+        const QVector< float >& yValues, QObject* parent = nullptr );
+
+    void setValues( const QVector< float >& xValues, const QVector< float >& yValues );
+
+    QVector< float > xValues() const;
+    QVector< float > yValues() const;
+
+    qsizetype count() const override;
+    QPointF pointAt( qsizetype index ) const override;
+
+    Arrays arrays() const override;
+
+  private:
+    QVector< float > m_xValues;
+    QVector< float > m_yValues;
+};
+
+inline QVector< float > QskPlotCurveFloatArrays::xValues() const
+{
+    return m_xValues;
+}
+
+inline QVector< float > QskPlotCurveFloatArrays::yValues() const
+{
+    return m_yValues;
+}
+
+inline qsizetype QskPlotCurveFloatArrays::count() const
+{
+    return m_xValues.count();
+}
+
+inline QPointF QskPlotCurveFloatArrays::pointAt( qsizetype index ) const
+{
+    return QPointF( m_xValues.at( index ), m_yValues.at( index ) );
+}
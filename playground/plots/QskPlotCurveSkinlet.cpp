@@ -12,6 +12,202 @@
 
 #include <qsggeometry.h>
 #include <qsgvertexcolormaterial.h>
+#include <qtransform.h>
+
+#include <algorithm>
+#include <cmath>
+
+template< typename T >
+static inline void qskFillVertices( const T* x, const T* y,
+    qsizetype from, qsizetype to, const QskVertex::Color& c,
+    QSGGeometry::ColoredPoint2D* points )
+{
+    for ( auto i = from; i <= to; i++ )
+        points[ i - from ].set( x[ i ], y[ i ], c.r, c.g, c.b, c.a );
+}
+
+static void qskFillVertices( const QskPlotCurveData* data,
+    qsizetype from, qsizetype to, const QskVertex::Color& c,
+    QSGGeometry::ColoredPoint2D* points )
+{
+    if ( from > to )
+        return;
+
+    const auto arrays = data->arrays();
+
+    switch( arrays.type )
+    {
+        case QskPlotCurveData::Arrays::Double:
+        {
+            qskFillVertices( static_cast< const double* >( arrays.x ),
+                static_cast< const double* >( arrays.y ), from, to, c, points );
+            break;
+        }
+        case QskPlotCurveData::Arrays::Float:
+        {
+            qskFillVertices( static_cast< const float* >( arrays.x ),
+                static_cast< const float* >( arrays.y ), from, to, c, points );
+            break;
+        }
+        default:
+        {
+            for ( auto i = from; i <= to; i++ )
+            {
+                const auto point = data->pointAt( i );
+                points++->set( point.x(), point.y(), c.r, c.g, c.b, c.a );
+            }
+        }
+    }
+}
+
+template< typename T >
+static inline void qskFillVertices( const T* x, const T* y,
+    const QVector< qsizetype >& indexes, const QskVertex::Color& c,
+    QSGGeometry::ColoredPoint2D* points )
+{
+    for ( const auto i : indexes )
+        points++->set( x[ i ], y[ i ], c.r, c.g, c.b, c.a );
+}
+
+static void qskFillVertices( const QskPlotCurveData* data,
+    const QVector< qsizetype >& indexes, const QskVertex::Color& c,
+    QSGGeometry::ColoredPoint2D* points )
+{
+    const auto arrays = data->arrays();
+
+    switch( arrays.type )
+    {
+        case QskPlotCurveData::Arrays::Double:
+        {
+            qskFillVertices( static_cast< const double* >( arrays.x ),
+                static_cast< const double* >( arrays.y ), indexes, c, points );
+            break;
+        }
+        case QskPlotCurveData::Arrays::Float:
+        {
+            qskFillVertices( static_cast< const float* >( arrays.x ),
+                static_cast< const float* >( arrays.y ), indexes, c, points );
+            break;
+        }
+        default:
+        {
+            for ( const auto i : indexes )
+            {
+                const auto point = data->pointAt( i );
+                points++->set( point.x(), point.y(), c.r, c.g, c.b, c.a );
+            }
+        }
+    }
+}
+
+template< typename X >
+static inline qsizetype qskColumnEnd(
+    const X& xAt, qsizetype from, qsizetype to, qreal xEnd )
+{
+    /*
+        The last index in [from, to] with x < xEnd, assuming x( from ) < xEnd.
+        A column has only a couple of points compared to the range, so we
+        search forward with doubled steps before doing a binary search.
+     */
+
+    qsizetype lo = from;
+    qsizetype step = 1;
+
+    while ( lo + step <= to && xAt( lo + step ) < xEnd )
+    {
+        lo += step;
+        step *= 2;
+    }
+
+    // x( hi ) >= xEnd or hi beyond the range
+    auto hi = qMin( lo + step, to + 1 );
+
+    while ( hi - lo > 1 )
+    {
+        const auto mid = lo + ( hi - lo ) / 2;
+
+        if ( xAt( mid ) < xEnd )
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+template< typename X >
+static void qskDecimate( const QskPlotCurveData* data, const X& xAt,
+    qsizetype from, qsizetype to, qreal x0, qreal columnWidth,
+    QVector< qsizetype >& indexes )
+{
+    /*
+        M4 aggregation: for each pixel column we only need the first, last,
+        minimum and maximum points to get exactly the same line strip
+        as when drawing all points.
+     */
+
+    for ( auto i = from; i <= to; )
+    {
+        const auto column = std::floor( ( xAt( i ) - x0 ) / columnWidth );
+        const auto xEnd = x0 + ( column + 1 ) * columnWidth;
+
+        const auto last = qskColumnEnd( xAt, i, to, xEnd );
+
+        if ( last - i < 4 )
+        {
+            for ( auto j = i; j <= last; j++ )
+                indexes += j;
+        }
+        else
+        {
+            qsizetype indexMin, indexMax;
+            data->minMaxIndexes( i, last, indexMin, indexMax );
+
+            qsizetype columnIndexes[] = { i, indexMin, indexMax, last };
+            std::sort( columnIndexes, columnIndexes + 4 );
+
+            for ( int j = 0; j < 4; j++ )
+            {
+                if ( j == 0 || columnIndexes[ j ] != columnIndexes[ j - 1 ] )
+                    indexes += columnIndexes[ j ];
+            }
+        }
+
+        i = last + 1;
+    }
+}
+
+static void qskDecimate( const QskPlotCurveData* data,
+    qsizetype from, qsizetype to, qreal x0, qreal columnWidth,
+    QVector< qsizetype >& indexes )
+{
+    const auto arrays = data->arrays();
+
+    switch( arrays.type )
+    {
+        case QskPlotCurveData::Arrays::Double:
+        {
+            const auto x = static_cast< const double* >( arrays.x );
+
+            qskDecimate( data, [ x ]( qsizetype i ) { return qreal( x[ i ] ); },
+                from, to, x0, columnWidth, indexes );
+            break;
+        }
+        case QskPlotCurveData::Arrays::Float:
+        {
+            const auto x = static_cast< const float* >( arrays.x );
+
+            qskDecimate( data, [ x ]( qsizetype i ) { return qreal( x[ i ] ); },
+                from, to, x0, columnWidth, indexes );
+            break;
+        }
+        default:
+        {
+            qskDecimate( data, [ data ]( qsizetype i ) { return data->pointAt( i ).x(); },
+                from, to, x0, columnWidth, indexes );
+        }
+    }
+}
 
 namespace
 {
@@ -25,8 +221,8 @@ namespace
             setMaterial( &m_material );
         }
 
-        void updateCurve( const QRectF& scaleRect, const QskPlotCurveData* data,
-            const QColor& color, qreal lineWidth )
+        void updateCurve( const QRectF& scaleRect, qreal pixelWidth,
+            const QskPlotCurveData* data, const QColor& color, qreal lineWidth )
         {
             m_geometry.setDrawingMode( QSGGeometry::DrawLineStrip );
 
@@ -93,19 +289,49 @@ namespace
                 }
             }
 
-            m_geometry.allocate( to - from + 1 );
-
-            auto p = m_geometry.vertexDataAsColoredPoint2D();
+            /*
+                With monotonic x coordinates we can reduce the points
+                to at most 4 for each pixel column, when having significantly
+                more points than columns.
+             */
+            bool doDecimate = false;
 
-            p++->set( point1.x(), point1.y(), c.r, c.g, c.b, c.a );
+            if ( ( data->hints() & QskPlotCurveData::MonotonicX ) && pixelWidth > 0.0 )
+            {
+                const auto columnCount = scaleRect.width() / pixelWidth;
+                doDecimate = ( to - from + 1 ) > 8 * columnCount;
+            }
 
-            for ( int i = from + 1; i < to; i++ )
+            if ( doDecimate )
             {
-                const auto point = data->pointAt( i );
-                p++->set( point.x(), point.y(), c.r, c.g, c.b, c.a );
+                QVector< qsizetype > indexes;
+                qskDecimate( data, from + 1, to - 1,
+                    scaleRect.left(), pixelWidth, indexes );
+
+                m_geometry.allocate( indexes.count() + 2 );
+
+                auto p = m_geometry.vertexDataAsColoredPoint2D();
+
+                p++->set( point1.x(), point1.y(), c.r, c.g, c.b, c.a );
+
+                qskFillVertices( data, indexes, c, p );
+                p += indexes.count();
+
+                p++->set( point2.x(), point2.y(), c.r, c.g, c.b, c.a );
             }
+            else
+            {
+                m_geometry.allocate( to - from + 1 );
 
-            p++->set( point2.x(), point2.y(), c.r, c.g, c.b, c.a );
+                auto p = m_geometry.vertexDataAsColoredPoint2D();
+
+                p++->set( point1.x(), point1.y(), c.r, c.g, c.b, c.a );
+
+                qskFillVertices( data, from + 1, to - 1, c, p );
+                p += to - from - 1;
+
+                p++->set( point2.x(), point2.y(), c.r, c.g, c.b, c.a );
+            }
 
             markDirty( QSGNode::DirtyGeometry );
         }
@@ -154,8 +380,13 @@ QSGNode* QskPlotCurveSkinlet::updatePolygonNode(
     if ( lineWidth <= 0.0 )
         return nullptr;
 
+    // the width of a pixel in scale coordinates
+    const auto scaleX = qAbs( curve->transformation().m11() );
+    const qreal pixelWidth = ( scaleX > 0.0 ) ? 1.0 / scaleX : 0.0;
+
     auto curveNode = QskSGNode::ensureNode< CurveNode >( node );
-    curveNode->updateCurve( curve->scaleRect(), curveData, color, lineWidth );
+    curveNode->updateCurve( curve->scaleRect(), pixelWidth,
+        curveData, color, lineWidth );
 
     return curveNode;
 }
@@ -0,0 +1,170 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    A headless benchmark for loading QVG files. The graphics of a directory
+    are converted into version 1 and version 2 files, that are loaded
+    in the following modes:
+
+        - "v1": reading version 1, what decodes all commands
+        - "v2": reading version 2, where the commands are not decoded yet
+        - "v2-decoded": reading version 2 and decoding the commands,
+          like it happens, when rendering the graphics for the first time
+
+    For each mode the loading time and the growth of the resident
+    set size ( Linux only ) is reported. As memory, that has been freed,
+    is usually not given back to the system, each mode is run
+    in a process of its own.
+
+    Usage: qvgload directory
+ */
+
+#include <SkinnyNamespace.h>
+
+#include <QskGraphic.h>
+#include <QskGraphicIO.h>
+#include <QskPainterCommand.h>
+
+#include <QGuiApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QDebug>
+
+#include <vector>
+
+namespace
+{
+    QStringList qvgFiles( const QString& dirName )
+    {
+        QStringList files;
+
+        const QDir dir( dirName );
+
+        const auto names = dir.entryList(
+            { QStringLiteral( "*.qvg" ) }, QDir::Files, QDir::Name );
+
+        for ( const auto& name : names )
+            files += dir.absoluteFilePath( name );
+
+        return files;
+    }
+
+    bool convert( const QString& dirName, const QString& outDirName )
+    {
+        const QDir outDir( outDirName );
+
+        for ( const auto version : { QskGraphicIO::Version1, QskGraphicIO::Version2 } )
+        {
+            const auto subDir = QStringLiteral( "v%1" ).arg( int( version ) );
+            if ( !outDir.mkpath( subDir ) )
+                return false;
+        }
+
+        const auto files = qvgFiles( dirName );
+        for ( const auto& file : files )
+        {
+            const auto graphic = QskGraphicIO::read( file );
+            const auto name = QFileInfo( file ).fileName();
+
+            QskGraphicIO::write( graphic,
+                outDir.filePath( QStringLiteral( "v1/" ) + name ), QskGraphicIO::Version1 );
+
+            QskGraphicIO::write( graphic,
+                outDir.filePath( QStringLiteral( "v2/" ) + name ), QskGraphicIO::Version2 );
+        }
+
+        return !files.isEmpty();
+    }
+
+    void load( const QString& dirName, bool decode )
+    {
+        const auto files = qvgFiles( dirName );
+
+        std::vector< QskGraphic > graphics;
+        graphics.reserve( files.size() );
+
+        const auto bytes = Skinny::residentBytes();
+
+        QElapsedTimer timer;
+        timer.start();
+
+        int commandCount = 0;
+
+        for ( const auto& file : files )
+        {
+            graphics.push_back( QskGraphicIO::read( file ) );
+
+            if ( decode )
+                commandCount += graphics.back().commands().size();
+        }
+
+        const auto nsecs = timer.nsecsElapsed();
+
+        auto growth = Skinny::residentBytes();
+        if ( growth >= 0 )
+            growth -= bytes;
+
+        qDebug().nospace() << "  files: " << files.size()
+            << ", time: " << nsecs / 1000000.0 << "ms"
+            << ", rss: " << growth / 1024 << "kB"
+            << ", decoded commands: " << commandCount;
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QGuiApplication app( argc, argv );
+
+    const auto args = app.arguments();
+
+    if ( args.count() == 3 )
+    {
+        // running one of the modes from below
+        const auto& mode = args[1];
+        const auto& dirName = args[2];
+
+        if ( mode == QStringLiteral( "v1" ) )
+            load( dirName + QStringLiteral( "/v1" ), false );
+        else if ( mode == QStringLiteral( "v2" ) )
+            load( dirName + QStringLiteral( "/v2" ), false );
+        else
+            load( dirName + QStringLiteral( "/v2" ), true );
+
+        return 0;
+    }
+
+    if ( args.count() != 2 )
+    {
+        qWarning() << "usage: qvgload directory";
+        return 1;
+    }
+
+    QTemporaryDir tmpDir;
+    if ( !tmpDir.isValid() || !convert( args[1], tmpDir.path() ) )
+    {
+        qWarning() << "qvgload: no qvg files in" << args[1];
+        return 1;
+    }
+
+    for ( const auto mode : { "v1", "v2", "v2-decoded" } )
+    {
+        qDebug() << mode;
+
+        QProcess process;
+        process.setProcessChannelMode( QProcess::ForwardedChannels );
+        process.start( app.applicationFilePath(),
+            { QString::fromLatin1( mode ), tmpDir.path() } );
+
+        process.waitForFinished( -1 );
+    }
+
+    return 0;
+}
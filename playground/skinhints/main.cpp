@@ -0,0 +1,314 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    A headless benchmark for the storage of skin hints. The hint tables
+    of the Fluent2 and Material3 skins are copied into a QHash and into
+    a QskSkinHintMap:
+
+        - "exact": lookups of the keys in random order, half of them misses
+        - "memory": the growth of the resident set size, when creating
+          copies of the table ( Linux only ) and the bytes allocated by
+          QskSkinHintMap
+
+    Then the lookups with fallback resolution are measured through
+    QskSkinHintTable, that is using one of the containers depending
+    on the build option ENABLE_FLAT_SKIN_HINTS.
+
+    Finally the skin is written into a snapshot ( QskSkinIO ), that is
+    restored into another instance of the skin and compared with the
+    original hints.
+
+    Usage: skinhints [ lookups ] [ copies ]
+ */
+
+#include <SkinnyNamespace.h>
+
+#include <QskGraphic.h>
+#include <QskSkin.h>
+#include <QskSkinIO.h>
+#include <QskSkinHintMap.h>
+#include <QskSkinHintTable.h>
+#include <QskSkinManager.h>
+
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QRandomGenerator>
+#include <QDebug>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+    using HashMap = QHash< QskAspect, QVariant >;
+
+    template< typename Map >
+    Map createMap( const QskSkinHintTable& table )
+    {
+        // inserting one by one: no implicit sharing between the copies
+
+        Map map;
+
+        const auto& hints = table.hints();
+        for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+            map.insert( it.key(), it.value() );
+
+        return map;
+    }
+
+    template< typename Map >
+    double exactLookups( const Map& map, const QVector< QskAspect >& aspects )
+    {
+        int found = 0;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        for ( const auto aspect : aspects )
+        {
+            auto it = map.constFind( aspect );
+            if ( it != map.constEnd() && it.value().isValid() )
+                found++;
+        }
+
+        const auto nsecs = timer.nsecsElapsed();
+
+        // using the result, so that the loop can't be optimized away
+        if ( found < 0 )
+            qDebug() << found;
+
+        return double( nsecs ) / qMax( aspects.size(), 1 );
+    }
+
+    double resolvedLookups( const QskSkinHintTable& table,
+        const QVector< QskAspect >& aspects )
+    {
+        int found = 0;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        for ( const auto aspect : aspects )
+        {
+            if ( auto hint = table.resolvedHint( aspect ) )
+            {
+                if ( hint->isValid() )
+                    found++;
+            }
+        }
+
+        const auto nsecs = timer.nsecsElapsed();
+
+        if ( found < 0 )
+            qDebug() << found;
+
+        return double( nsecs ) / qMax( aspects.size(), 1 );
+    }
+
+    template< typename Map >
+    qint64 memoryGrowth( const QskSkinHintTable& table, int copyCount )
+    {
+        std::vector< std::unique_ptr< Map > > maps;
+        maps.reserve( copyCount );
+
+        const auto bytes = Skinny::residentBytes();
+
+        for ( int i = 0; i < copyCount; i++ )
+            maps.emplace_back( new Map( createMap< Map >( table ) ) );
+
+        if ( bytes < 0 )
+            return -1;
+
+        return ( Skinny::residentBytes() - bytes ) / qMax( copyCount, 1 );
+    }
+
+    QVector< QskAspect > lookupAspects(
+        const QskSkinHintTable& table, int count, bool withStates )
+    {
+        const auto& hints = table.hints();
+
+        QVector< QskAspect > keys;
+        keys.reserve( hints.size() );
+
+        for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+            keys += it.key();
+
+        QVector< QskAspect > aspects;
+        aspects.reserve( count );
+
+        if ( keys.isEmpty() )
+            return aspects;
+
+        auto random = QRandomGenerator::global();
+
+        for ( int i = 0; i < count; i++ )
+        {
+            auto aspect = keys[ random->bounded( keys.size() ) ];
+
+            if ( withStates || ( i % 2 ) )
+            {
+                // states, that often have no explicit hints
+                const auto state = QskAspect::FirstUserState << random->bounded( 4 );
+                aspect |= static_cast< QskAspect::State >( state );
+            }
+
+            aspects += aspect;
+        }
+
+        return aspects;
+    }
+
+    bool isEqual( const QVariant& value1, const QVariant& value2 )
+    {
+        if ( value1.userType() != value2.userType() )
+            return false;
+
+        if ( value1.userType() == qMetaTypeId< QskGraphic >() )
+        {
+            /*
+                QskGraphic::operator== compares modification ids,
+                that are different for a restored graphic
+             */
+            const auto graphic1 = value1.value< QskGraphic >();
+            const auto graphic2 = value2.value< QskGraphic >();
+
+            return ( graphic1.viewBox() == graphic2.viewBox() )
+                && ( graphic1.boundingRect() == graphic2.boundingRect() )
+                && ( graphic1.commands().size() == graphic2.commands().size() );
+        }
+
+        return value1 == value2;
+    }
+
+    void snapshotRoundTrip( const QskSkin* skin )
+    {
+        const auto skinName = skin->objectName();
+
+        QByteArray snapshot;
+        if ( !QskSkinIO::write( skin, snapshot ) )
+        {
+            qWarning() << "  snapshot: writing failed";
+            return;
+        }
+
+        std::unique_ptr< QskSkin > restoredSkin( qskSkinManager->createSkin( skinName ) );
+
+        QElapsedTimer timer;
+        timer.start();
+
+        if ( !QskSkinIO::read( restoredSkin.get(), snapshot ) )
+        {
+            qWarning() << "  snapshot: restoring failed";
+            return;
+        }
+
+        const auto nsecs = timer.nsecsElapsed();
+
+        const auto& hints = skin->hintTable().hints();
+        const auto& restoredTable = restoredSkin->hintTable();
+
+        int mismatches = 0;
+
+        for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+        {
+            if ( !isEqual( it.value(), restoredTable.hint( it.key() ) ) )
+            {
+                if ( mismatches++ < 10 )
+                    qWarning() << "  snapshot: mismatch" << it.key() << it.value();
+            }
+        }
+
+        if ( restoredTable.hints().size() != hints.size() )
+            mismatches++;
+
+        if ( restoredSkin->fontTable().size() != skin->fontTable().size()
+            || restoredSkin->graphicFilters().size() != skin->graphicFilters().size() )
+        {
+            mismatches++;
+        }
+
+        qDebug().nospace() << "  snapshot: " << snapshot.size() << " bytes, restored in "
+            << nsecs / 1000 << "us, " << mismatches << " mismatches";
+    }
+
+    void benchmark( const QString& skinName, int lookupCount, int copyCount )
+    {
+        std::unique_ptr< QskSkin > skin( qskSkinManager->createSkin( skinName ) );
+        if ( skin == nullptr || skin->objectName() != skinName )
+        {
+            // createSkin falls back to another skin
+            qWarning() << "skinhints: no skin" << skinName;
+            return;
+        }
+
+        const auto& table = skin->hintTable();
+
+        qDebug().nospace() << skinName << ": " << table.hints().size() << " hints";
+
+        {
+            const auto aspects = lookupAspects( table, lookupCount, false );
+
+            const auto hashMap = createMap< HashMap >( table );
+            const auto flatMap = createMap< QskSkinHintMap >( table );
+
+            // warming up
+            exactLookups( hashMap, aspects );
+            exactLookups( flatMap, aspects );
+
+            qDebug().nospace() << "  exact, QHash: "
+                << exactLookups( hashMap, aspects ) << "ns";
+
+            qDebug().nospace() << "  exact, QskSkinHintMap: "
+                << exactLookups( flatMap, aspects ) << "ns";
+
+            qDebug().nospace() << "  allocated, QskSkinHintMap: "
+                << flatMap.allocatedBytes() << " bytes";
+        }
+
+        qDebug().nospace() << "  memory, QHash: "
+            << memoryGrowth< HashMap >( table, copyCount ) << " bytes";
+
+        qDebug().nospace() << "  memory, QskSkinHintMap: "
+            << memoryGrowth< QskSkinHintMap >( table, copyCount ) << " bytes";
+
+        {
+            const auto aspects = lookupAspects( table, lookupCount, true );
+
+#if defined( QSK_FLAT_SKIN_HINTS )
+            const char* container = "QskSkinHintMap";
+#else
+            const char* container = "QHash";
+#endif
+            // the first run fills the resolution cache
+            qDebug().nospace() << "  resolved, " << container << ", uncached: "
+                << resolvedLookups( table, aspects ) << "ns";
+
+            qDebug().nospace() << "  resolved, " << container << ", cached: "
+                << resolvedLookups( table, aspects ) << "ns";
+        }
+
+        snapshotRoundTrip( skin.get() );
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QGuiApplication app( argc, argv );
+
+    const auto args = app.arguments();
+
+    const int lookupCount = ( args.count() > 1 ) ? args[1].toInt() : 1000000;
+    const int copyCount = ( args.count() > 2 ) ? args[2].toInt() : 100;
+
+    for ( const auto name : { "Fluent2", "Material3" } )
+        benchmark( QString::fromLatin1( name ), lookupCount, copyCount );
+
+    return 0;
+}
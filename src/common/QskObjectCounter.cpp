@@ -4,24 +4,31 @@
  *****************************************************************************/
 
 #include "QskObjectCounter.h"
+#include "QskColorRamp.h"
+#include "QskGradientMaterial.h"
 #include "QskInternalMacros.h"
 
 #include <qdebug.h>
 #include <qset.h>
+#include <qmutex.h>
 #include <qobject.h>
-#include <qcoreapplication.h>
+#include <qpointer.h>
+#include <qguiapplication.h>
+#include <qquickwindow.h>
+#include <qsgimagenode.h>
+#include <qsgnode.h>
+#include <qsgsimpletexturenode.h>
+#include <qsgtexture.h>
+#include <qsgtexturematerial.h>
+#include <qtimer.h>
+
+#include <atomic>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qhooks_p.h>
 #include <private/qquickitem_p.h>
 QSK_QT_PRIVATE_END
 
-#define QSK_OBJECT_INFO 0
-
-#if QSK_OBJECT_INFO
-#include <qset.h>
-#endif
-
 static inline bool qskIsItem( const QObject* object )
 {
     /*
@@ -76,9 +83,14 @@ namespace
       public:
         Counter counter[ 2 ];
 
-#if QSK_OBJECT_INFO
+        /*
+            Objects are created and destroyed in any thread,
+            so the table needs to be guarded
+         */
+        std::atomic< bool > trackObjects { false };
+
+        mutable QMutex mutex;
         QSet< const QObject* > objectTable;
-#endif
     };
 
     class CounterHook
@@ -170,9 +182,11 @@ void CounterHook::addObject( QObject* object )
         if ( isItem )
             counterData->counter[ QskObjectCounter::Items ].increment();
 
-#if QSK_OBJECT_INFO
-        counterData->objectTable.insert( object );
-#endif
+        if ( counterData->trackObjects )
+        {
+            QMutexLocker locker( &counterData->mutex );
+            counterData->objectTable.insert( object );
+        }
     }
 
     if ( m_otherAddObject )
@@ -190,9 +204,11 @@ void CounterHook::removeObject( QObject* object )
         if ( isItem )
             counterData->counter[ QskObjectCounter::Items ].decrement();
 
-#if QSK_OBJECT_INFO
-        counterData->objectTable.remove( object );
-#endif
+        if ( counterData->trackObjects )
+        {
+            QMutexLocker locker( &counterData->mutex );
+            counterData->objectTable.remove( object );
+        }
     }
 
     if ( m_otherRemoveObject )
@@ -236,6 +252,267 @@ static void qskInstallCleanupHookHandler()
 
 Q_COREAPP_STARTUP_FUNCTION( qskInstallCleanupHookHandler )
 
+static const QSGTexture* qskNodeTexture( const QSGNode* node )
+{
+    if ( auto imageNode = dynamic_cast< const QSGImageNode* >( node ) )
+        return imageNode->texture();
+
+    if ( auto textureNode = dynamic_cast< const QSGSimpleTextureNode* >( node ) )
+        return textureNode->texture();
+
+    if ( node->type() == QSGNode::GeometryNodeType )
+    {
+        // f.e QskLayerNode: QSGTextureMaterial is derived from QSGOpaqueTextureMaterial
+
+        const auto material = static_cast< const QSGGeometryNode* >( node )->material();
+        if ( auto textureMaterial = dynamic_cast< const QSGOpaqueTextureMaterial* >( material ) )
+            return textureMaterial->texture();
+    }
+
+    return nullptr;
+}
+
+static const QSGTexture* qskRampTexture( const QSGNode* node, const void* rhi )
+{
+    // the color tables of the gradients, that are shared between all materials
+
+    const auto material = static_cast< const QSGGeometryNode* >( node )->material();
+    if ( auto gradientMaterial = dynamic_cast< const QskGradientMaterial* >( material ) )
+    {
+        return QskColorRamp::cachedTexture( rhi,
+            gradientMaterial->stops(), gradientMaterial->spreadMode() );
+    }
+
+    return nullptr;
+}
+
+static inline void qskAddTexture( const QSGTexture* texture,
+    QskObjectCounter::Snapshot& snapshot, QSet< const void* >& resources )
+{
+    if ( texture && !resources.contains( texture ) )
+    {
+        resources += texture;
+
+        const auto size = texture->textureSize();
+        snapshot.textureBytes += 4 * qint64( size.width() ) * size.height();
+    }
+}
+
+static QByteArray qskNodeTypeName( const QSGNode* node )
+{
+    switch( node->type() )
+    {
+        case QSGNode::GeometryNodeType:
+            return qskNodeTexture( node ) ? "texture" : "geometry";
+
+        case QSGNode::TransformNodeType:
+            return "transform";
+
+        case QSGNode::ClipNodeType:
+            return "clip";
+
+        case QSGNode::OpacityNodeType:
+            return "opacity";
+
+        case QSGNode::RootNodeType:
+            return "root";
+
+        case QSGNode::RenderNodeType:
+            return "render";
+
+        default:
+            return "basic";
+    }
+}
+
+static void qskAddNodes( const QSGNode* node, const void* rhi,
+    QskObjectCounter::Snapshot& snapshot, QSet< const void* >& resources )
+{
+    snapshot.nodes[ qskNodeTypeName( node ) ]++;
+
+    if ( node->type() == QSGNode::GeometryNodeType
+        || node->type() == QSGNode::ClipNodeType )
+    {
+        // geometries might be shared: see QskGeometryCache
+        const auto geometry =
+            static_cast< const QSGBasicGeometryNode* >( node )->geometry();
+
+        if ( geometry && !resources.contains( geometry ) )
+        {
+            resources += geometry;
+
+            snapshot.vertexBytes +=
+                qint64( geometry->vertexCount() ) * geometry->sizeOfVertex();
+
+            snapshot.indexBytes +=
+                qint64( geometry->indexCount() ) * geometry->sizeOfIndex();
+        }
+
+        // textures might be shared: see QskTextureCache, QskColorRamp
+        qskAddTexture( qskNodeTexture( node ), snapshot, resources );
+
+        if ( node->type() == QSGNode::GeometryNodeType )
+            qskAddTexture( qskRampTexture( node, rhi ), snapshot, resources );
+    }
+
+    for ( auto child = node->firstChild(); child; child = child->nextSibling() )
+        qskAddNodes( child, rhi, snapshot, resources );
+}
+
+namespace
+{
+    /*
+        The scene graph is modified on the render thread ( preprocess(),
+        deleting nodes ) and must not be read from the GUI thread.
+        So the nodes of a window are counted after synchronizing, where
+        the GUI thread is blocked and nothing is rendered yet.
+
+        Walking the scene graph is expensive and done only once for
+        each request.
+     */
+    class NodeStatistics : public QObject
+    {
+      public:
+        NodeStatistics( QQuickWindow* window )
+            : QObject( window )
+        {
+            connect( window, &QQuickWindow::afterSynchronizing,
+                this, [ this, window ]() { update( window ); },
+                Qt::DirectConnection );
+        }
+
+        // always called from the GUI thread
+        static NodeStatistics* instance( QQuickWindow* window, bool& created )
+        {
+            /*
+                The statistics are children of their window. When a window
+                is deleted its entry becomes null and is replaced, when the
+                address is reused by another window.
+             */
+            static QHash< const QQuickWindow*, QPointer< NodeStatistics > > table;
+
+            auto& statistics = table[ window ];
+
+            created = statistics.isNull();
+            if ( created )
+                statistics = new NodeStatistics( window );
+
+            return statistics;
+        }
+
+        void addTo( QskObjectCounter::Snapshot& snapshot ) const
+        {
+            QMutexLocker locker( &m_mutex );
+
+            for ( auto it = m_nodes.constBegin(); it != m_nodes.constEnd(); ++it )
+                snapshot.nodes[ it.key() ] += it.value();
+
+            snapshot.vertexBytes += m_vertexBytes;
+            snapshot.indexBytes += m_indexBytes;
+            snapshot.textureBytes += m_textureBytes;
+        }
+
+        void requestUpdate( QQuickWindow* window )
+        {
+            m_pending = true;
+            window->update();
+        }
+
+      private:
+        void update( QQuickWindow* window )
+        {
+            if ( !m_pending.exchange( false ) )
+                return;
+
+            QskObjectCounter::Snapshot snapshot;
+
+            auto rootItem = window->contentItem();
+            while ( rootItem->parentItem() )
+                rootItem = rootItem->parentItem();
+
+            if ( auto node = QQuickItemPrivate::get( rootItem )->itemNodeInstance )
+            {
+                // the key of the color ramps, nullptr for OpenGL without RHI
+                const auto rhi = window->rendererInterface()->getResource(
+                    window, QSGRendererInterface::RhiResource );
+
+                QSet< const void* > resources;
+                qskAddNodes( node, rhi, snapshot, resources );
+            }
+
+            QMutexLocker locker( &m_mutex );
+
+            m_nodes = snapshot.nodes;
+            m_vertexBytes = snapshot.vertexBytes;
+            m_indexBytes = snapshot.indexBytes;
+            m_textureBytes = snapshot.textureBytes;
+        }
+
+        std::atomic< bool > m_pending { false };
+
+        mutable QMutex m_mutex;
+
+        QMap< QByteArray, int > m_nodes;
+        qint64 m_vertexBytes = 0;
+        qint64 m_indexBytes = 0;
+        qint64 m_textureBytes = 0;
+    };
+}
+
+static void qskAddNodes( QskObjectCounter::Snapshot& snapshot )
+{
+    const auto windows = QGuiApplication::topLevelWindows();
+    for ( const auto window : windows )
+    {
+        if ( auto quickWindow = qobject_cast< QQuickWindow* >( window ) )
+        {
+            bool created;
+
+            auto statistics = NodeStatistics::instance( quickWindow, created );
+            if ( !created )
+                statistics->addTo( snapshot );
+
+            // counting at the next synchronization
+            statistics->requestUpdate( quickWindow );
+        }
+    }
+}
+
+template< typename T >
+static QMap< QByteArray, T > qskDifference(
+    const QMap< QByteArray, T >& map1, const QMap< QByteArray, T >& map2 )
+{
+    QMap< QByteArray, T > map = map1;
+
+    for ( auto it = map2.constBegin(); it != map2.constEnd(); ++it )
+        map[ it.key() ] -= it.value();
+
+    for ( auto it = map.begin(); it != map.end(); )
+    {
+        if ( it.value() == 0 )
+            it = map.erase( it );
+        else
+            ++it;
+    }
+
+    return map;
+}
+
+QskObjectCounter::Snapshot QskObjectCounter::Snapshot::operator-(
+    const Snapshot& other ) const
+{
+    Snapshot snapshot;
+
+    snapshot.classes = qskDifference( classes, other.classes );
+    snapshot.nodes = qskDifference( nodes, other.nodes );
+
+    snapshot.vertexBytes = vertexBytes - other.vertexBytes;
+    snapshot.indexBytes = indexBytes - other.indexBytes;
+    snapshot.textureBytes = textureBytes - other.textureBytes;
+
+    return snapshot;
+}
+
 class QskObjectCounter::PrivateData
 {
   public:
@@ -246,6 +523,9 @@ class QskObjectCounter::PrivateData
 
     CounterData counterData;
     const bool debugAtDestruction;
+
+    std::unique_ptr< QTimer > dumpTimer;
+    Snapshot dumpedSnapshot;
 };
 
 QskObjectCounter::QskObjectCounter( bool debugAtDestruction )
@@ -256,6 +536,7 @@ QskObjectCounter::QskObjectCounter( bool debugAtDestruction )
 
 QskObjectCounter::~QskObjectCounter()
 {
+    m_data->dumpTimer.reset();
     setActive( false );
 
     if ( m_data->debugAtDestruction )
@@ -296,6 +577,85 @@ void QskObjectCounter::reset()
 
     counters[ Objects ].reset();
     counters[ Items ].reset();
+
+    QMutexLocker locker( &m_data->counterData.mutex );
+    m_data->counterData.objectTable.clear();
+}
+
+void QskObjectCounter::setClassStatistics( bool on )
+{
+    auto& counterData = m_data->counterData;
+
+    if ( on != counterData.trackObjects )
+    {
+        QMutexLocker locker( &counterData.mutex );
+
+        counterData.trackObjects = on;
+        counterData.objectTable.clear();
+    }
+}
+
+bool QskObjectCounter::hasClassStatistics() const
+{
+    return m_data->counterData.trackObjects;
+}
+
+QskObjectCounter::Snapshot QskObjectCounter::snapshot() const
+{
+    Snapshot snapshot;
+
+    {
+        /*
+            As objects are removed from the table before being freed,
+            holding the lock keeps all of them alive. Objects, that are
+            in their constructor or destructor, are reported with the
+            class name of a base class.
+         */
+        const auto& counterData = m_data->counterData;
+        QMutexLocker locker( &counterData.mutex );
+
+        for ( const auto object : counterData.objectTable )
+            snapshot.classes[ object->metaObject()->className() ]++;
+    }
+
+    qskAddNodes( snapshot );
+
+    return snapshot;
+}
+
+void QskObjectCounter::setDumpInterval( int ms )
+{
+    if ( ms <= 0 )
+    {
+        m_data->dumpTimer.reset();
+        return;
+    }
+
+    if ( m_data->dumpTimer == nullptr )
+    {
+        m_data->dumpTimer.reset( new QTimer() );
+
+        QObject::connect( m_data->dumpTimer.get(), &QTimer::timeout,
+            [ this ]()
+            {
+                const auto snapshot = this->snapshot();
+
+                qDebug().nospace() << "* Snapshot\n" << snapshot
+                    << "\n* Growth\n" << ( snapshot - m_data->dumpedSnapshot );
+
+                m_data->dumpedSnapshot = snapshot;
+            } );
+    }
+
+    m_data->dumpTimer->start( ms );
+}
+
+int QskObjectCounter::dumpInterval() const
+{
+    if ( const auto timer = m_data->dumpTimer.get() )
+        return timer->interval();
+
+    return 0;
 }
 
 int QskObjectCounter::created( ObjectType objectType ) const
@@ -331,9 +691,9 @@ void QskObjectCounter::debugStatistics( QDebug debug, ObjectType objectType ) co
           << ", maximum: " << c.maximum;
     debug << ')';
 
-#if QSK_OBJECT_INFO
-    if ( objectType == Objects )
+    if ( objectType == Objects && m_data->counterData.trackObjects )
     {
+        QMutexLocker locker( &m_data->counterData.mutex );
         const auto& objectTable = m_data->counterData.objectTable;
 
         if ( !objectTable.isEmpty() )
@@ -348,7 +708,6 @@ void QskObjectCounter::debugStatistics( QDebug debug, ObjectType objectType ) co
             }
         }
     }
-#endif
 }
 
 void QskObjectCounter::dump() const
@@ -375,4 +734,24 @@ QDebug operator<<( QDebug debug, const QskObjectCounter& counter )
     return debug;
 }
 
+QDebug operator<<( QDebug debug, const QskObjectCounter::Snapshot& snapshot )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "  Classes:";
+    for ( auto it = snapshot.classes.constBegin(); it != snapshot.classes.constEnd(); ++it )
+        debug << "\n\t" << it.key().constData() << ": " << it.value();
+
+    debug << "\n  Nodes:";
+    for ( auto it = snapshot.nodes.constBegin(); it != snapshot.nodes.constEnd(); ++it )
+        debug << "\n\t" << it.key().constData() << ": " << it.value();
+
+    debug << "\n  Bytes: vertices: " << snapshot.vertexBytes
+          << ", indexes: " << snapshot.indexBytes
+          << ", textures: " << snapshot.textureBytes;
+
+    return debug;
+}
+
 #endif
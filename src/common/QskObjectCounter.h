@@ -7,6 +7,9 @@
 #define QSK_OBJECT_COUNTER_H
 
 #include "QskGlobal.h"
+
+#include <qbytearray.h>
+#include <qmap.h>
 #include <memory>
 
 class QObject;
@@ -20,6 +23,34 @@ class QSK_EXPORT QskObjectCounter
         Items
     };
 
+    /*
+        A snapshot of what is alive: for hunting memory growth
+        snapshots taken at different times can be compared.
+     */
+    class QSK_EXPORT Snapshot
+    {
+      public:
+        // QObjects by class name, requires hasClassStatistics()
+        QMap< QByteArray, int > classes;
+
+        /*
+            Nodes of the scene graphs of all windows by type. They are
+            counted on the render thread, when a window has been synchronized.
+            Each snapshot requests counting for the next frame, so the values
+            are from the frame following the previous snapshot and the first
+            snapshot has no nodes.
+         */
+        QMap< QByteArray, int > nodes;
+
+        // geometries and textures referenced from the scene graphs
+        qint64 vertexBytes = 0;
+        qint64 indexBytes = 0;
+        qint64 textureBytes = 0;
+
+        // the growth since an older snapshot
+        Snapshot operator-( const Snapshot& ) const;
+    };
+
     QskObjectCounter( bool debugAtDestruction = false );
     ~QskObjectCounter();
 
@@ -33,6 +64,19 @@ class QSK_EXPORT QskObjectCounter
     int current( ObjectType = Objects ) const;
     int maximum( ObjectType = Objects ) const;
 
+    /*
+        Tracking the objects for the statistics per class. Only
+        objects created after enabling it are included.
+     */
+    void setClassStatistics( bool );
+    bool hasClassStatistics() const;
+
+    Snapshot snapshot() const;
+
+    // dumping a snapshot and the growth periodically, 0: never
+    void setDumpInterval( int ms );
+    int dumpInterval() const;
+
     void debugStatistics( QDebug, ObjectType = Objects ) const;
     void dump() const;
 
@@ -47,6 +91,7 @@ class QSK_EXPORT QskObjectCounter
 
 class QDebug;
 QSK_EXPORT QDebug operator<<( QDebug, const QskObjectCounter& );
+QSK_EXPORT QDebug operator<<( QDebug, const QskObjectCounter::Snapshot& );
 
 #endif
 
@@ -4,6 +4,7 @@
  *****************************************************************************/
 
 #include "QskAnimator.h"
+#include "QskFrameProfiler.h"
 
 #include <qelapsedtimer.h>
 #include <qglobalstatic.h>
@@ -36,7 +37,10 @@ namespace
             debug << "created: " << created
                   << ", destroyed: " << destroyed
                   << ", current: " << current
-                  << ", maximum: " << maximum;
+                  << ", maximum: " << maximum
+                  << ", frames: " << frames
+                  << ", updates: " << updates
+                  << ", advanced: " << advanceTime / 1000000.0 << "ms";
             debug << ')';
         }
 #endif
@@ -44,6 +48,9 @@ namespace
         inline void reset()
         {
             created = destroyed = current = maximum = 0;
+
+            frames = updates = 0;
+            advanceTime = 0;
         }
 
         inline void increment()
@@ -61,13 +68,27 @@ namespace
             current--;
         }
 
+        inline void addFrame( int animatorCount, qint64 nsecs )
+        {
+            frames++;
+            updates += animatorCount;
+            advanceTime += nsecs;
+        }
+
         int created;
         int destroyed;
         int current;
         int maximum;
+
+        // advancing the animators of a window
+        qint64 frames;
+        qint64 updates;
+        qint64 advanceTime; // ns
     };
 }
 
+Q_GLOBAL_STATIC( Statistics, qskStatistics )
+
 namespace
 {
     /*
@@ -86,6 +107,7 @@ namespace
         void unregisterAnimator( QskAnimator* );
 
         qint64 referenceTime() const;
+        void setTimeSource( qint64 ( *timeSource )() );
 
       Q_SIGNALS:
         void advanced( QQuickWindow* );
@@ -97,6 +119,7 @@ namespace
         void scheduleUpdate( QQuickWindow* );
 
         QElapsedTimer m_referenceTime;
+        qint64 ( *m_timeSource )() = nullptr;
 
         // a sorted vector, good for iterating and good enough for look ups
         QVector< QskAnimator* > m_animators;
@@ -118,7 +141,12 @@ AnimatorDriver::AnimatorDriver()
 
 inline qint64 AnimatorDriver::referenceTime() const
 {
-    return m_referenceTime.elapsed();
+    return m_timeSource ? m_timeSource() : m_referenceTime.elapsed();
+}
+
+void AnimatorDriver::setTimeSource( qint64 ( *timeSource )() )
+{
+    m_timeSource = timeSource;
 }
 
 void AnimatorDriver::registerAnimator( QskAnimator* animator )
@@ -196,6 +224,14 @@ void AnimatorDriver::unregisterAnimator( QskAnimator* animator )
 
 void AnimatorDriver::advanceAnimators( QQuickWindow* window )
 {
+    QskFrameProfiler::Scope profilerScope(
+        QskFrameProfiler::Animation, "QskAnimator", window );
+
+    QElapsedTimer timer;
+    timer.start();
+
+    int updateCount = 0;
+
     bool hasAnimators = false;
     bool hasTerminations = false;
 
@@ -212,6 +248,7 @@ void AnimatorDriver::advanceAnimators( QQuickWindow* window )
             if ( animator->isRunning() )
             {
                 animator->update();
+                updateCount++;
 
                 if ( !animator->isRunning() )
                     hasTerminations = true;
@@ -221,6 +258,9 @@ void AnimatorDriver::advanceAnimators( QQuickWindow* window )
 
     m_index = -1;
 
+    if ( qskStatistics )
+        qskStatistics->addFrame( updateCount, timer.nsecsElapsed() );
+
     if ( !hasAnimators )
     {
         window->disconnect( this );
@@ -234,7 +274,6 @@ void AnimatorDriver::advanceAnimators( QQuickWindow* window )
 }
 
 Q_GLOBAL_STATIC( AnimatorDriver, qskAnimatorDriver )
-Q_GLOBAL_STATIC( Statistics, qskStatistics )
 
 QskAnimator::QskAnimator()
     : m_window( nullptr )
@@ -398,6 +437,12 @@ QMetaObject::Connection QskAnimator::addAdvanceHandler(
         SIGNAL(advanced(QQuickWindow*)), receiver, method, type );
 }
 
+void QskAnimator::setTimeSource( qint64 ( *timeSource )() )
+{
+    if ( auto driver = qskAnimatorDriver )
+        driver->setTimeSource( timeSource );
+}
+
 #ifndef QT_NO_DEBUG_STREAM
 
 void QskAnimator::debugStatistics( QDebug debug )
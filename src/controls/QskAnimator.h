@@ -50,6 +50,14 @@ class QSK_EXPORT QskAnimator
         QObject* receiver, const char* method,
         Qt::ConnectionType type = Qt::AutoConnection );
 
+    /*
+        A custom clock in ms, f.e a virtual clock, that is advanced in
+        fixed steps for reproducible measurements. nullptr resets
+        to the wall clock. The time source should not be changed
+        while animators are running.
+     */
+    static void setTimeSource( qint64 ( *timeSource )() );
+
 #ifndef QT_NO_DEBUG_STREAM
     static void debugStatistics( QDebug );
 #endif
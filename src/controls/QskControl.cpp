@@ -9,6 +9,7 @@
 #include "QskAspect.h"
 #include "QskFunctions.h"
 #include "QskEvent.h"
+#include "QskFrameProfiler.h"
 #include "QskQuick.h"
 #include "QskSetup.h"
 #include "QskSkin.h"
@@ -16,6 +17,8 @@
 #include "QskSkinHintTable.h"
 #include "QskMargins.h"
 #include "QskTreeNode.h"
+#include "QskLayerNode.h"
+#include "QskSGNode.h"
 
 #include <qlocale.h>
 #include <qvector.h>
@@ -32,6 +35,42 @@ static inline void qskSendEventTo( QObject* object, QEvent::Type type )
     QCoreApplication::sendEvent( object, &event );
 }
 
+static void qskUpdateLayerNode( QskControl* control, QSGNode* itemNode )
+{
+    using namespace QskSGNode;
+
+    if ( itemNode == nullptr )
+        return;
+
+    /*
+        The layer node is a child of the item node and therefore
+        not affected by the opacity node, that hides the subtree
+        from the main renderer ( see qskSetScenegraphAnchor ).
+     */
+    const auto rootNode = qskScenegraphAnchorNode( control );
+
+    if ( rootNode == nullptr || !control->isLayerCached() )
+    {
+        removeChildNode( itemNode, LayerRole );
+        return;
+    }
+
+    auto layerNode = static_cast< QskLayerNode* >(
+        findChildNode( itemNode, LayerRole ) );
+
+    if ( layerNode == nullptr )
+    {
+        layerNode = new QskLayerNode();
+        setNodeRole( layerNode, LayerRole );
+
+        itemNode->appendChildNode( layerNode );
+    }
+
+    // the opacity node of the item is 0, so we have to apply the opacity here
+    layerNode->setOpacity( control->opacity() );
+    layerNode->updateNode( control->window(), rootNode, control->rect() );
+}
+
 static inline bool qskMaybeGesture( QQuickItem* item,
     const QQuickItem* child, const QEvent* event )
 {
@@ -89,6 +128,37 @@ bool QskControl::autoLayoutChildren() const
     return d_func()->autoLayoutChildren;
 }
 
+/*
+    A control, that is cached as layer, renders its subtree - including
+    all child items - into a texture, that is displayed as a single quad.
+    The texture is updated, whenever a node of the subtree has been changed.
+
+    This is useful for complex controls, that rarely change, as the batch
+    renderer has to process the nodes of the subtree only when
+    updating the texture.
+
+    Nodes outside of the rectangle of the control are clipped.
+ */
+void QskControl::setLayerCached( bool on )
+{
+    Q_D( QskControl );
+
+    if ( on != d->layerCached )
+    {
+        d->layerCached = on;
+
+        if ( isVisible() )
+            qskSetScenegraphAnchor( this, on, true );
+
+        update();
+    }
+}
+
+bool QskControl::isLayerCached() const
+{
+    return d_func()->layerCached;
+}
+
 void QskControl::setBackgroundColor( const QColor& color )
 {
     setBackground( QskGradient( color ) );
@@ -882,6 +952,27 @@ void QskControl::itemChange( QQuickItem::ItemChange change,
             setSkinStateFlag( Focused, hasActiveFocus() );
             break;
         }
+        case QQuickItem::ItemVisibleHasChanged:
+        {
+            if ( d_func()->layerCached )
+            {
+                /*
+                    Hidden items with an anchor are kept in the scene graph
+                    and would be hidden by their opacity node only.
+                    But the layer node is not below the opacity node.
+                 */
+                qskSetScenegraphAnchor( this, value.boolValue, true );
+                update();
+            }
+            break;
+        }
+        case QQuickItem::ItemOpacityHasChanged:
+        {
+            if ( d_func()->layerCached )
+                update();
+
+            break;
+        }
     }
 
     Inherited::itemChange( change, value );
@@ -901,6 +992,9 @@ void QskControl::geometryChange(
 
 void QskControl::updateItemPolish()
 {
+    QskFrameProfiler::Scope profilerScope(
+        QskFrameProfiler::Layout, metaObject()->className(), window() );
+
     updateResources(); // an extra dirty bit for this ???
 
     if ( width() >= 0.0 || height() >= 0.0 )
@@ -930,6 +1024,10 @@ QSGNode* QskControl::updateItemPaintNode( QSGNode* node )
         node = new QskTreeNode();
 
     updateNode( node );
+
+    Q_D( QskControl );
+    qskUpdateLayerNode( this, d->itemNodeInstance );
+
     return node;
 }
 
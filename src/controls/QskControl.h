@@ -32,6 +32,8 @@ class QSK_EXPORT QskControl : public QskItem, public QskSkinnable
     Q_PROPERTY( bool autoLayoutChildren READ autoLayoutChildren
         WRITE setAutoLayoutChildren )
 
+    Q_PROPERTY( bool layerCached READ isLayerCached WRITE setLayerCached )
+
     Q_PROPERTY( bool visibleToLayout READ isVisibleToLayout )
 
     Q_PROPERTY( QskMargins margins READ margins
@@ -89,6 +91,9 @@ class QSK_EXPORT QskControl : public QskItem, public QskSkinnable
     void setAutoLayoutChildren( bool );
     bool autoLayoutChildren() const;
 
+    void setLayerCached( bool );
+    bool isLayerCached() const;
+
     void setSection( QskAspect::Section );
     void resetSection();
     QskAspect::Section section() const override final;
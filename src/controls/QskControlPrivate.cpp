@@ -154,6 +154,7 @@ QskControlPrivate::QskControlPrivate()
     , explicitLocale( false )
     , explicitSection( false )
     , autoLayoutChildren( false )
+    , layerCached( false )
     , blockLayoutRequestEvents( true )
 {
 }
@@ -58,6 +58,7 @@ class QskControlPrivate : public QskItemPrivate
     bool explicitSection : 1;
 
     bool autoLayoutChildren : 1;
+    bool layerCached : 1;
 
     mutable bool blockLayoutRequestEvents : 1;
 };
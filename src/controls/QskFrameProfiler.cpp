@@ -0,0 +1,397 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskFrameProfiler.h"
+
+#include <qcoreapplication.h>
+#include <qelapsedtimer.h>
+#include <qfile.h>
+#include <qglobalstatic.h>
+#include <qguiapplication.h>
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qjsonobject.h>
+#include <qquickwindow.h>
+#include <qthread.h>
+
+
+std::atomic< bool > QskFrameProfiler::s_enabled { false };
+
+namespace
+{
+    /*
+        A ring buffer with a sequence counter for each slot ( "seqlock" ):
+        writers never block and readers skip slots, that are
+        being overwritten while copying them.
+
+        Writers might still be appending, when the profiler gets disabled
+        and enabled again. So the slots are allocated once - when enabling
+        the profiler for the first time - and are never modified from
+        the GUI thread. Clearing only moves the position, where reading starts.
+     */
+    class RingBuffer
+    {
+      public:
+        RingBuffer()
+        {
+            m_clock.start();
+        }
+
+        ~RingBuffer()
+        {
+            delete[] m_slots.load( std::memory_order_relaxed );
+        }
+
+        void allocate()
+        {
+            if ( m_slots.load( std::memory_order_relaxed ) == nullptr )
+            {
+                m_capacity = capacity;
+                m_slots.store( new Slot[ m_capacity ], std::memory_order_release );
+            }
+        }
+
+        void restart()
+        {
+            clear();
+            m_epoch.store( m_clock.nsecsElapsed(), std::memory_order_relaxed );
+        }
+
+        void clear()
+        {
+            m_readIndex.store( m_writeIndex.load( std::memory_order_acquire ),
+                std::memory_order_relaxed );
+        }
+
+        inline qint64 timestamp() const
+        {
+            return m_clock.nsecsElapsed() - m_epoch.load( std::memory_order_relaxed );
+        }
+
+        void append( const QskFrameProfiler::Event& event )
+        {
+            const auto slots = m_slots.load( std::memory_order_acquire );
+            if ( slots == nullptr )
+                return;
+
+            const auto pos = m_writeIndex.fetch_add( 1, std::memory_order_relaxed );
+            auto& slot = slots[ pos % m_capacity ];
+
+            // odd: being written
+            slot.sequence.store( 2 * pos + 1, std::memory_order_relaxed );
+            std::atomic_thread_fence( std::memory_order_release );
+
+            slot.event = event;
+
+            slot.sequence.store( 2 * pos + 2, std::memory_order_release );
+        }
+
+        QVector< QskFrameProfiler::Event > events() const
+        {
+            QVector< QskFrameProfiler::Event > events;
+
+            const auto slots = m_slots.load( std::memory_order_acquire );
+            if ( slots == nullptr )
+                return events;
+
+            const auto end = m_writeIndex.load( std::memory_order_acquire );
+
+            auto begin = m_readIndex.load( std::memory_order_relaxed );
+            if ( end - begin > quint64( m_capacity ) )
+                begin = end - m_capacity;
+
+            events.reserve( int( end - begin ) );
+
+            for ( auto pos = begin; pos < end; pos++ )
+            {
+                const auto& slot = slots[ pos % m_capacity ];
+
+                const auto sequence = slot.sequence.load( std::memory_order_acquire );
+                if ( sequence != 2 * pos + 2 )
+                    continue; // in progress or already overwritten
+
+                const auto event = slot.event;
+
+                std::atomic_thread_fence( std::memory_order_acquire );
+                if ( slot.sequence.load( std::memory_order_relaxed ) == sequence )
+                    events += event;
+            }
+
+            return events;
+        }
+
+        inline int allocatedCapacity() const
+        {
+            return m_slots.load( std::memory_order_acquire ) ? m_capacity : 0;
+        }
+
+        int capacity = 100000; // the requested one
+
+      private:
+        struct Slot
+        {
+            std::atomic< quint64 > sequence { 0 };
+            QskFrameProfiler::Event event;
+        };
+
+        std::atomic< Slot* > m_slots { nullptr };
+        int m_capacity = 0; // fixed, once m_slots is allocated
+
+        std::atomic< quint64 > m_writeIndex { 0 };
+        std::atomic< quint64 > m_readIndex { 0 };
+
+        QElapsedTimer m_clock;
+        std::atomic< qint64 > m_epoch { 0 };
+    };
+
+    class WindowObserver : public QObject
+    {
+      public:
+        WindowObserver( QQuickWindow* window )
+            : QObject( window )
+        {
+            setObjectName( QStringLiteral( "QskFrameProfiler" ) );
+
+            using P = QskFrameProfiler;
+
+            /*
+                The items have been polished, before QQuickWindow::afterAnimating
+                is emitted - the cost of polishing is recorded by the Layout events
+                of the controls. What follows until QQuickWindow::beforeSynchronizing
+                is mostly waiting for the render thread to be ready for
+                synchronizing ( threaded render loop ).
+             */
+            connect( window, &QQuickWindow::afterAnimating,
+                this, [ this ]() { mark( m_syncWaitStart ); },
+                Qt::DirectConnection );
+
+            connect( window, &QQuickWindow::beforeSynchronizing, this,
+                [ this, window ]()
+                {
+                    finish( P::SyncWait, window, m_syncWaitStart );
+                    mark( m_syncStart );
+                },
+                Qt::DirectConnection );
+
+            connect( window, &QQuickWindow::afterSynchronizing,
+                this, [ this, window ]() { finish( P::Sync, window, m_syncStart ); },
+                Qt::DirectConnection );
+
+            connect( window, &QQuickWindow::beforeRendering,
+                this, [ this ]() { mark( m_renderStart ); },
+                Qt::DirectConnection );
+
+            connect( window, &QQuickWindow::afterRendering, this,
+                [ this, window ]()
+                {
+                    finish( P::Render, window, m_renderStart );
+                    mark( m_swapStart );
+                },
+                Qt::DirectConnection );
+
+            connect( window, &QQuickWindow::frameSwapped,
+                this, [ this, window ]() { finish( P::Swap, window, m_swapStart ); },
+                Qt::DirectConnection );
+        }
+
+      private:
+        inline void mark( qint64& start ) const
+        {
+            start = QskFrameProfiler::isEnabled() ? QskFrameProfiler::timestamp() : -1;
+        }
+
+        inline void finish( QskFrameProfiler::Phase phase,
+            const QQuickWindow* window, qint64& start ) const
+        {
+            if ( start >= 0 && QskFrameProfiler::isEnabled() )
+                QskFrameProfiler::record( phase, "QQuickWindow", window, start );
+
+            start = -1;
+        }
+
+        /*
+            syncWait starts on the GUI thread and ends on the render thread,
+            while the GUI thread is blocked. sync/render/swap: render thread
+         */
+        qint64 m_syncWaitStart = -1;
+        qint64 m_syncStart = -1;
+        qint64 m_renderStart = -1;
+        qint64 m_swapStart = -1;
+    };
+}
+
+Q_GLOBAL_STATIC( RingBuffer, qskRingBuffer )
+
+static void qskWriteFrameProfile()
+{
+    QskFrameProfiler::writeChromeTrace( qEnvironmentVariable( "QSK_FRAME_PROFILE" ) );
+}
+
+static void qskInitFrameProfiler()
+{
+    if ( !qEnvironmentVariableIsEmpty( "QSK_FRAME_PROFILE" ) )
+    {
+        QskFrameProfiler::setEnabled( true );
+        qAddPostRoutine( qskWriteFrameProfile );
+    }
+}
+
+Q_CONSTRUCTOR_FUNCTION( qskInitFrameProfiler )
+
+static inline const char* qskPhaseName( QskFrameProfiler::Phase phase )
+{
+    static const char* names[] =
+    {
+        "animation", "syncWait", "layout", "sync", "updateNode", "render", "swap"
+    };
+
+    return names[ phase ];
+}
+
+void QskFrameProfiler::setCapacity( int capacity )
+{
+    if ( auto buffer = qskRingBuffer )
+        buffer->capacity = qMax( capacity, 1 );
+}
+
+int QskFrameProfiler::capacity()
+{
+    if ( auto buffer = qskRingBuffer )
+    {
+        const auto capacity = buffer->allocatedCapacity();
+        return ( capacity > 0 ) ? capacity : buffer->capacity;
+    }
+
+    return 0;
+}
+
+void QskFrameProfiler::setEnabled( bool on )
+{
+    if ( on == isEnabled() )
+        return;
+
+    if ( on )
+    {
+        if ( auto buffer = qskRingBuffer )
+        {
+            buffer->allocate();
+
+            // the events of a previous run are dropped
+            buffer->restart();
+        }
+    }
+
+    s_enabled.store( on, std::memory_order_release );
+
+    if ( on && qobject_cast< QGuiApplication* >( QCoreApplication::instance() ) )
+    {
+        const auto windows = QGuiApplication::topLevelWindows();
+        for ( auto window : windows )
+        {
+            if ( auto quickWindow = qobject_cast< QQuickWindow* >( window ) )
+                addWindow( quickWindow );
+        }
+    }
+}
+
+void QskFrameProfiler::addWindow( QQuickWindow* window )
+{
+    if ( window == nullptr || !isEnabled() )
+        return;
+
+    const auto observer = window->findChild< QObject* >(
+        QStringLiteral( "QskFrameProfiler" ), Qt::FindDirectChildrenOnly );
+
+    if ( observer == nullptr )
+        ( void ) new WindowObserver( window );
+}
+
+qint64 QskFrameProfiler::timestamp()
+{
+    if ( auto buffer = qskRingBuffer )
+        return buffer->timestamp();
+
+    return 0;
+}
+
+void QskFrameProfiler::record( Phase phase, const char* name,
+    const QQuickWindow* window, qint64 start, int detail )
+{
+    if ( !isEnabled() )
+        return;
+
+    if ( auto buffer = qskRingBuffer )
+    {
+        Event event;
+        event.name = name;
+        event.window = window;
+        event.thread = reinterpret_cast< quintptr >( QThread::currentThreadId() );
+        event.start = start;
+        event.duration = buffer->timestamp() - start;
+        event.phase = phase;
+        event.detail = detail;
+
+        buffer->append( event );
+    }
+}
+
+QVector< QskFrameProfiler::Event > QskFrameProfiler::events()
+{
+    if ( auto buffer = qskRingBuffer )
+        return buffer->events();
+
+    return QVector< Event >();
+}
+
+void QskFrameProfiler::clear()
+{
+    if ( auto buffer = qskRingBuffer )
+        buffer->clear();
+}
+
+QByteArray QskFrameProfiler::chromeTrace()
+{
+    const auto pid = QCoreApplication::applicationPid();
+
+    QJsonArray traceEvents;
+
+    const auto events = QskFrameProfiler::events();
+    for ( const auto& event : events )
+    {
+        QJsonObject args;
+        args[ QStringLiteral( "window" ) ] = QStringLiteral( "0x%1" ).arg(
+            reinterpret_cast< quintptr >( event.window ), 0, 16 );
+
+        if ( event.detail >= 0 )
+            args[ QStringLiteral( "role" ) ] = event.detail;
+
+        QJsonObject object;
+        object[ QStringLiteral( "name" ) ] = QLatin1String( event.name ? event.name : "" );
+        object[ QStringLiteral( "cat" ) ] = QLatin1String( qskPhaseName( event.phase ) );
+        object[ QStringLiteral( "ph" ) ] = QStringLiteral( "X" );
+        object[ QStringLiteral( "ts" ) ] = event.start / 1000.0; // us
+        object[ QStringLiteral( "dur" ) ] = event.duration / 1000.0;
+        object[ QStringLiteral( "pid" ) ] = pid;
+        object[ QStringLiteral( "tid" ) ] = double( event.thread );
+        object[ QStringLiteral( "args" ) ] = args;
+
+        traceEvents += object;
+    }
+
+    QJsonObject trace;
+    trace[ QStringLiteral( "traceEvents" ) ] = traceEvents;
+    trace[ QStringLiteral( "displayTimeUnit" ) ] = QStringLiteral( "ms" );
+
+    return QJsonDocument( trace ).toJson( QJsonDocument::Compact );
+}
+
+bool QskFrameProfiler::writeChromeTrace( const QString& fileName )
+{
+    QFile file( fileName );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+        return false;
+
+    return file.write( chromeTrace() ) >= 0;
+}
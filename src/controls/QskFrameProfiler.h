@@ -0,0 +1,135 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_FRAME_PROFILER_H
+#define QSK_FRAME_PROFILER_H
+
+#include "QskGlobal.h"
+#include <qvector.h>
+#include <atomic>
+
+class QQuickWindow;
+class QByteArray;
+class QString;
+
+/*
+    QskFrameProfiler records where the time of a frame goes: advancing
+    the animators, polishing ( Layout, per control ), waiting for the
+    render thread, synchronizing the scene graph ( per control and node role ),
+    rendering and swapping.
+
+    The events are stored in a lock free ring buffer, that might be
+    filled from the GUI and the render threads. It can be queried in process
+    or dumped in the trace event format of Chrome ( chrome://tracing, Perfetto ).
+
+    When being disabled the overhead is a check of an atomic flag and
+    windows are not observed before enabling the profiler.
+
+    Setting the environment variable QSK_FRAME_PROFILE to a file name
+    enables the profiler at startup and writes the trace, when the
+    application is shut down.
+ */
+class QSK_EXPORT QskFrameProfiler
+{
+  public:
+    enum Phase : quint8
+    {
+        Animation,
+        SyncWait,
+        Layout,
+        Sync,
+        UpdateNode,
+        Render,
+        Swap
+    };
+
+    class Event
+    {
+      public:
+        // a string with static lifetime, f.e the class name of a control
+        const char* name = nullptr;
+
+        const QQuickWindow* window = nullptr;
+        quintptr thread = 0;
+
+        // in ns, relative to enabling the profiler
+        qint64 start = 0;
+        qint64 duration = 0;
+
+        Phase phase = Animation;
+
+        // the node role for UpdateNode, otherwise -1
+        int detail = -1;
+    };
+
+    class Scope
+    {
+      public:
+        Scope( Phase, const char* name,
+            const QQuickWindow*, int detail = -1 ) noexcept;
+
+        ~Scope();
+
+      private:
+        const char* m_name;
+        const QQuickWindow* m_window;
+        qint64 m_start;
+        int m_detail;
+        Phase m_phase;
+    };
+
+    // has to be set before enabling the profiler for the first time
+    static void setCapacity( int );
+    static int capacity();
+
+    static void setEnabled( bool );
+    static bool isEnabled() noexcept;
+
+    /*
+        Observing sync wait, sync, render and swap of a window. This
+        happens only, when the profiler is enabled: setEnabled( true )
+        observes all top level windows. Once being observed a window
+        stays observed, as the render thread might be emitting its signals.
+     */
+    static void addWindow( QQuickWindow* );
+
+    static qint64 timestamp();
+
+    static void record( Phase, const char* name,
+        const QQuickWindow*, qint64 start, int detail = -1 );
+
+    // the events, that have not been overwritten yet
+    static QVector< Event > events();
+    static void clear();
+
+    static QByteArray chromeTrace();
+    static bool writeChromeTrace( const QString& fileName );
+
+  private:
+    static std::atomic< bool > s_enabled;
+};
+
+inline bool QskFrameProfiler::isEnabled() noexcept
+{
+    return s_enabled.load( std::memory_order_relaxed );
+}
+
+inline QskFrameProfiler::Scope::Scope( Phase phase, const char* name,
+        const QQuickWindow* window, int detail ) noexcept
+    : m_name( name )
+    , m_window( window )
+    , m_start( isEnabled() ? timestamp() : -1 )
+    , m_detail( detail )
+    , m_phase( phase )
+{
+}
+
+inline QskFrameProfiler::Scope::~Scope()
+{
+    if ( m_start >= 0 )
+        record( m_phase, m_name, m_window, m_start, m_detail );
+}
+
+#endif
@@ -137,15 +137,23 @@ void QskHintAnimator::setControl( QskControl* control ) noexcept
 
 void QskHintAnimator::advance( qreal progress )
 {
+    /*
+        Not calling Inherited::advance, as we need to know if the value
+        has changed. Copying the previous value for a comparison would
+        defeat the in place interpolation of QskVariantAnimator.
+     */
+#if ALIGN_VALUES
     const auto oldValue = currentValue();
 
-    Inherited::advance( progress );
-
-#if ALIGN_VALUES
+    updateCurrentValue( progress );
     setCurrentValue( qskAligned05( currentValue() ) );
+
+    const bool isChanged = ( currentValue() != oldValue );
+#else
+    const bool isChanged = updateCurrentValue( progress );
 #endif
 
-    if ( m_control && ( currentValue() != oldValue ) )
+    if ( m_control && isChanged )
     {
         if ( m_updateFlags == QskAnimationHint::UpdateAuto )
         {
@@ -55,6 +55,8 @@ class QSK_EXPORT QskItem : public QQuickItem
         CleanupOnVisibility     =  1 << 3,
 
         PreferRasterForTextures =  1 << 4,
+        PreferGeometryForGraphics = 1 << 5,
+        AsyncRasterForTextures  =  1 << 6,
 
         DebugForceBackground    =  1 << 7
     };
@@ -28,10 +28,7 @@ static inline int qskRowAt( const QskListView* listView, const QPointF& pos )
     if ( rect.contains( pos ) )
     {
         const auto y = pos.y() - rect.top() + listView->scrollPos().y();
-
-        const int row = y / listView->rowHeight();
-        if ( row >= 0 && row < listView->rowCount() )
-            return row;
+        return listView->rowAt( y );
     }
 
     return -1;
@@ -281,7 +278,9 @@ void QskListView::keyPressEvent( QKeyEvent* event )
     {
         auto pos = scrollPos();
 
-        const qreal rowPos = row * rowHeight();
+        const qreal rowPos = rowOffset( row );
+        const qreal rowHeight = rowHeightAt( row );
+
         if ( rowPos < scrollPos().y() )
         {
             pos.setY( rowPos );
@@ -291,9 +290,9 @@ void QskListView::keyPressEvent( QKeyEvent* event )
             const QRectF vr = viewContentsRect();
 
             const double scrolledBottom = scrollPos().y() + vr.height();
-            if ( rowPos + rowHeight() > scrolledBottom )
+            if ( rowPos + rowHeight > scrolledBottom )
             {
-                const double y = rowPos + rowHeight() - vr.height();
+                const double y = rowPos + rowHeight - vr.height();
                 pos.setY( y );
             }
         }
@@ -398,19 +397,29 @@ QskAspect::States QskListView::rowStates( int row ) const
 
 #ifndef QT_NO_WHEELEVENT
 
-static qreal qskAlignedToRows( const qreal y0, qreal dy,
-    qreal rowHeight, qreal viewHeight )
+static qreal qskAlignedToRows( const QskListView* listView,
+    const qreal y0, qreal dy, qreal viewHeight )
 {
     qreal y = y0 - dy;
 
     if ( dy > 0 )
     {
-        y = qFloor( y / rowHeight ) * rowHeight;
+        const auto row = listView->rowAt( y );
+        if ( row >= 0 )
+            y = listView->rowOffset( row );
     }
     else
     {
         y += viewHeight;
-        y = qCeil( y / rowHeight ) * rowHeight;
+
+        const auto row = listView->rowAt( y );
+        if ( row >= 0 )
+        {
+            const auto rowPos = listView->rowOffset( row );
+            if ( y > rowPos )
+                y = rowPos + listView->rowHeightAt( row );
+        }
+
         y -= viewHeight;
     }
 
@@ -457,7 +466,7 @@ QPointF QskListView::scrollOffset( const QWheelEvent* event ) const
         dy *= offset.y(); // multiplied by the wheelsteps
 
         // aligning rows that enter the view
-        dy = qskAlignedToRows( y0, dy, rowHeight, viewHeight );
+        dy = qskAlignedToRows( this, y0, dy, viewHeight );
 
         offset.setY( y0 - dy );
     }
@@ -469,9 +478,33 @@ QPointF QskListView::scrollOffset( const QWheelEvent* event ) const
 
 #endif
 
+qreal QskListView::rowHeightAt( int ) const
+{
+    return rowHeight();
+}
+
+qreal QskListView::rowOffset( int row ) const
+{
+    return qBound( 0, row, rowCount() ) * rowHeight();
+}
+
+int QskListView::rowAt( qreal y ) const
+{
+    const auto rowHeight = this->rowHeight();
+
+    if ( y >= 0.0 && rowHeight > 0.0 )
+    {
+        const int row = qFloor( y / rowHeight );
+        if ( row < rowCount() )
+            return row;
+    }
+
+    return -1;
+}
+
 void QskListView::updateScrollableSize()
 {
-    const double h = rowCount() * rowHeight();
+    const double h = rowOffset( rowCount() );
 
     qreal w = 0.0;
     for ( int col = 0; col < columnCount(); col++ )
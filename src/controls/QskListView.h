@@ -62,6 +62,15 @@ class QSK_EXPORT QskListView : public QskScrollView
     virtual qreal columnWidth( int col ) const = 0;
     virtual qreal rowHeight() const = 0;
 
+    /*
+        The default implementations assume, that all rows have the
+        same height: rowHeight(). Views with rows of different heights
+        have to reimplement all of them.
+     */
+    virtual qreal rowHeightAt( int row ) const;
+    virtual qreal rowOffset( int row ) const;
+    virtual int rowAt( qreal y ) const;
+
     Q_INVOKABLE virtual QVariant valueAt( int row, int col ) const = 0;
 
     QRectF focusIndicatorRect() const override;
@@ -22,74 +22,167 @@ namespace
     class ForegroundNode : public QSGNode
     {
       public:
+        ~ForegroundNode() override
+        {
+            clearFreeNodes();
+        }
+
         void invalidate()
         {
-            removeAllChildNodes();
-            m_columnCount = m_oldRowMin = m_oldRowMax = -1;
+            QskSGNode::removeAllChildNodesFrom( this, firstChild() );
+
+            m_cells.clear();
+
+            // an empty range
+            m_rowMin = m_colMin = 0;
+            m_rowMax = m_colMax = -1;
+
+            clearFreeNodes();
         }
 
-        void rearrangeNodes( int rowMin, int rowMax, int columnCount )
+        void setVisibleCells( int rowMin, int rowMax, int colMin, int colMax )
         {
-            const bool doReorder = ( columnCount == m_columnCount )
-                && ( rowMin <= m_oldRowMax ) && ( rowMax >= m_oldRowMin );
+            /*
+                When scrolling the majority of the cells stay visible and
+                only their position changes, while only a few cells
+                appear/disappear.
 
-            if ( doReorder )
-            {
-                /*
-                    We have nodes that will be at a different position in the
-                    list of child nodes - however their content might be unchanged.
+                The nodes of the cells, that are not visible anymore, are
+                removed and put into free lists - one for each type of content.
+                Nodes of cells becoming visible are taken from these lists,
+                so that we can avoid allocating text or graphic nodes.
 
-                    This is a common situation, when resizing or scrolling the list.
+                As cells do not overlap the order of the child nodes
+                does not matter and the nodes of cells, that stay
+                visible, are not touched at all.
+             */
 
-                    To avoid that the text/graphic nodes have to be updated we
-                    try to rearrange the nodes, so that they are in increasing
-                    row order for further processing.
+            const int columnCount = colMax - colMin + 1;
 
-                    To avoid delete/new calls we append the leading and prepend
-                    the trailing nodes, so that they might be used later.
-                 */
+            QVector< QSGTransformNode* > cells(
+                qMax( rowMax - rowMin + 1, 0 ) * qMax( columnCount, 0 ), nullptr );
+
+            int i = 0;
 
-                if ( rowMin >= m_oldRowMin )
+            for ( int row = m_rowMin; row <= m_rowMax; row++ )
+            {
+                for ( int col = m_colMin; col <= m_colMax; col++ )
                 {
-                    for ( int row = m_oldRowMin; row < rowMin; row++ )
+                    auto node = m_cells[ i++ ];
+                    if ( node == nullptr )
+                        continue;
+
+                    if ( row >= rowMin && row <= rowMax
+                        && col >= colMin && col <= colMax )
                     {
-                        for ( int col = 0; col < columnCount; col++ )
-                        {
-                            auto childNode = firstChild();
-                            removeChildNode( childNode );
-                            appendChildNode( childNode );
-                        }
+                        cells[ ( row - rowMin ) * columnCount + col - colMin ] = node;
                     }
-                }
-                else
-                {
-                    for ( int row = rowMin; row < m_oldRowMin; row++ )
+                    else
                     {
-                        for ( int col = 0; col < columnCount; col++ )
-                        {
-                            auto childNode = lastChild();
-                            removeChildNode( childNode );
-                            prependChildNode( childNode );
-                        }
+                        removeChildNode( node );
+                        m_freeNodes[ poolIndex( node ) ] += node;
                     }
                 }
             }
 
-            m_oldRowMin = rowMin;
-            m_oldRowMax = rowMax;
-            m_columnCount = columnCount;
+            m_cells = cells;
+
+            m_rowMin = rowMin;
+            m_rowMax = rowMax;
+            m_colMin = colMin;
+            m_colMax = colMax;
+        }
+
+        QSGTransformNode* cellNode( int row, int col ) const
+        {
+            return m_cells[ cellIndex( row, col ) ];
+        }
+
+        QSGTransformNode* takeFreeNode( quint8 role )
+        {
+            auto& nodes = m_freeNodes[ poolIndex( role ) ];
+            return nodes.isEmpty() ? nullptr : nodes.takeLast();
+        }
+
+        void setCellNode( int row, int col,
+            QSGTransformNode* oldNode, QSGTransformNode* newNode )
+        {
+            if ( oldNode && oldNode != newNode )
+            {
+                if ( oldNode->parent() )
+                    removeChildNode( oldNode );
+
+                delete oldNode;
+            }
+
+            if ( newNode->parent() == nullptr )
+                appendChildNode( newNode );
+
+            m_cells[ cellIndex( row, col ) ] = newNode;
+        }
+
+        void trimFreeNodes()
+        {
+            // not keeping more nodes than needed for the visible cells
+            const int maxCount = m_cells.count();
+
+            for ( auto& nodes : m_freeNodes )
+            {
+                while ( nodes.count() > maxCount )
+                    delete nodes.takeLast();
+            }
         }
 
       private:
-        /*
-            When scrolling the majority of the child nodes are simply translated
-            while only few rows appear/disappear. To implement this in an efficient
-            way we store how the nodes were related to the rows in the previous update,
-         */
-
-        int m_oldRowMin = -1;
-        int m_oldRowMax = -1;
-        int m_columnCount = -1;
+        inline int cellIndex( int row, int col ) const
+        {
+            return ( row - m_rowMin ) * ( m_colMax - m_colMin + 1 ) + col - m_colMin;
+        }
+
+        static inline int poolIndex( quint8 role )
+        {
+            switch ( role )
+            {
+                case QskListViewSkinlet::TextRole:
+                    return 0;
+
+                case QskListViewSkinlet::GraphicRole:
+                    return 1;
+
+                default:
+                    return 2;
+            }
+        }
+
+        static inline int poolIndex( const QSGTransformNode* node )
+        {
+            // text nodes are transform nodes and used as cell nodes
+            const auto role = QskSGNode::nodeRole( node );
+            if ( role == QskListViewSkinlet::TextRole )
+                return poolIndex( role );
+
+            return poolIndex( QskSGNode::nodeRole( node->firstChild() ) );
+        }
+
+        void clearFreeNodes()
+        {
+            for ( auto& nodes : m_freeNodes )
+            {
+                qDeleteAll( nodes );
+                nodes.clear();
+            }
+        }
+
+        // the nodes of the visible cells in row-major order
+        QVector< QSGTransformNode* > m_cells;
+
+        // initially an empty range: m_rowMax < m_rowMin
+        int m_rowMin = 0;
+        int m_rowMax = -1;
+        int m_colMin = 0;
+        int m_colMax = -1;
+
+        QVector< QSGTransformNode* > m_freeNodes[ 3 ];
     };
 
     class ListViewNode final : public QSGTransformNode
@@ -110,15 +203,34 @@ namespace
             setMatrix( QTransform::fromTranslate( -scrollPos.x(), -scrollPos.y() ) );
 
             m_clipRect = listView->viewContentsRect();
-            m_rowHeight = listView->rowHeight();
 
-            m_rowMin = qFloor( scrollPos.y() / m_rowHeight );
+            const auto rowCount = listView->rowCount();
+
+            const auto y1 = scrollPos.y();
+            const auto y2 = y1 + m_clipRect.height() - 10e-6;
+
+            m_rowMin = listView->rowAt( y1 );
+            if ( m_rowMin < 0 )
+            {
+                /*
+                    The top of the viewport is above the first row ( overshooting )
+                    or below the last one. Only in the first case rows might be visible.
+                 */
+                if ( y1 >= 0.0 || y2 < 0.0 || rowCount <= 0 )
+                {
+                    // empty range
+                    m_rowMin = 0;
+                    m_rowMax = -1;
 
-            const auto rowMax = ( scrollPos.y() + m_clipRect.height() ) / m_rowHeight;
-            m_rowMax = qFloor( rowMax - 10e-6 );
+                    return;
+                }
+
+                m_rowMin = 0;
+            }
 
-            if ( m_rowMax >= listView->rowCount() )
-                m_rowMax = listView->rowCount() - 1;
+            m_rowMax = listView->rowAt( y2 );
+            if ( m_rowMax < 0 || m_rowMax >= rowCount )
+                m_rowMax = rowCount - 1;
         }
 
         QRectF clipRect() const { return m_clipRect; }
@@ -127,8 +239,6 @@ namespace
         int rowMax() const { return m_rowMax; }
         int rowCount() const { return m_rowMax - m_rowMin + 1; }
 
-        int rowHeight() const { return m_rowHeight; }
-
         QSGNode* backgroundNode() { return &m_backgroundNode; }
         ForegroundNode* foregroundNode() { return &m_foregroundNode; }
 
@@ -136,7 +246,6 @@ namespace
         // caching some calculations to speed things up
 
         QRectF m_clipRect;
-        qreal m_rowHeight;
 
         int m_rowMin, m_rowMax;
 
@@ -145,6 +254,17 @@ namespace
     };
 }
 
+static inline quint8 qskValueRole( const QVariant& value )
+{
+    if ( value.canConvert< QskGraphic >() )
+        return QskListViewSkinlet::GraphicRole;
+
+    if ( value.canConvert< QString >() )
+        return QskListViewSkinlet::TextRole;
+
+    return 0xff;
+}
+
 static inline ListViewNode* qskListViewNode( const QskListView* listView )
 {
     if ( auto node = const_cast< QSGNode* >( qskPaintNode( listView ) ) )
@@ -234,73 +354,89 @@ void QskListViewSkinlet::updateForegroundNodes(
     const int rowMin = listViewNode->rowMin();
     const int rowMax = listViewNode->rowMax();
 
-    foregroundNode->rearrangeNodes( rowMin, rowMax, listView->columnCount() );
-
-#if 1
-    // should be optimized for visible columns only
-    const int colMin = 0;
-    const int colMax = listView->columnCount() - 1;
-#endif
-
-    const auto margins = listView->paddingHint( QskListView::Cell );
+    // finding the visible columns
 
-    updateVisibleForegroundNodes(
-        listView, foregroundNode, rowMin, rowMax, margins );
+    const auto x0 = listView->scrollPos().x();
+    const auto x1 = x0 + clipRect.width();
 
-    // finally putting the nodes into their position
-    auto node = foregroundNode->firstChild();
+    int colMin = -1;
+    int colMax = -1;
+    qreal xMin = 0.0;
 
-    const auto rowHeight = listView->rowHeight();
-    auto y = clipRect.top() + rowMin * rowHeight;
-
-    for ( int row = rowMin; row <= rowMax; row++ )
     {
-        qreal x = clipRect.left();
+        qreal x = 0.0;
 
-        for ( int col = colMin; col <= colMax; col++ )
+        for ( int col = 0; col < listView->columnCount(); col++ )
         {
-            Q_ASSERT( node->type() == QSGNode::TransformNodeType );
-            auto transformNode = static_cast< QSGTransformNode* >( node );
+            const auto w = listView->columnWidth( col );
 
-            transformNode->setMatrix(
-                QTransform::fromTranslate( x + margins.left(), y + margins.top() ) );
+            if ( x + w > x0 && x < x1 )
+            {
+                if ( colMin < 0 )
+                {
+                    colMin = col;
+                    xMin = x;
+                }
 
-            node = node->nextSibling();
-            x += listView->columnWidth( col );
+                colMax = col;
+            }
+
+            x += w;
+            if ( x >= x1 )
+                break;
         }
+    }
 
-        y += rowHeight;
+    if ( colMin < 0 )
+    {
+        foregroundNode->invalidate();
+        return;
     }
-}
 
-void QskListViewSkinlet::updateVisibleForegroundNodes(
-    const QskListView* listView, QSGNode* parentNode,
-    int rowMin, int rowMax, const QMarginsF& margins ) const
-{
-    auto node = parentNode->firstChild();
+    foregroundNode->setVisibleCells( rowMin, rowMax, colMin, colMax );
+
+    const auto margins = listView->paddingHint( QskListView::Cell );
+
+    auto y = clipRect.top() + listView->rowOffset( rowMin );
 
     for ( int row = rowMin; row <= rowMax; row++ )
     {
-        const auto h = listView->rowHeight() - ( margins.top() + margins.bottom() );
+        const auto rowHeight = listView->rowHeightAt( row );
+        const auto h = rowHeight - ( margins.top() + margins.bottom() );
 
-        for ( int col = 0; col < listView->columnCount(); col++ )
+        auto x = clipRect.left() + xMin;
+
+        for ( int col = colMin; col <= colMax; col++ )
         {
-            const auto w = listView->columnWidth( col ) - ( margins.left() + margins.right() );
+            const auto columnWidth = listView->columnWidth( col );
+            const auto w = columnWidth - ( margins.left() + margins.right() );
+
+            const auto value = listView->valueAt( row, col );
+
+            auto cellNode = foregroundNode->cellNode( row, col );
+            if ( cellNode == nullptr )
+                cellNode = foregroundNode->takeFreeNode( qskValueRole( value ) );
+
+            auto newCellNode = updateForegroundNode(
+                listView, cellNode, row, col, value, QSizeF( w, h ) );
 
-            node = updateForegroundNode( listView,
-                parentNode, static_cast< QSGTransformNode* >( node ),
-                row, col, QSizeF( w, h ) );
+            foregroundNode->setCellNode( row, col, cellNode, newCellNode );
 
-            node = node->nextSibling();
+            newCellNode->setMatrix(
+                QTransform::fromTranslate( x + margins.left(), y + margins.top() ) );
+
+            x += columnWidth;
         }
+
+        y += rowHeight;
     }
 
-    QskSGNode::removeAllChildNodesFrom( parentNode, node );
+    foregroundNode->trimFreeNodes();
 }
 
 QSGTransformNode* QskListViewSkinlet::updateForegroundNode(
-    const QskListView* listView, QSGNode* parentNode, QSGTransformNode* cellNode,
-    int row, int col, const QSizeF& size ) const
+    const QskListView* listView, QSGTransformNode* cellNode,
+    int row, int col, const QVariant& value, const QSizeF& size ) const
 {
     const QRectF cellRect( 0.0, 0.0, size.width(), size.height() );
 
@@ -310,11 +446,12 @@ QSGTransformNode* QskListViewSkinlet::updateForegroundNode(
      */
     QSGTransformNode* newCellNode = nullptr;
 
-    if ( cellNode && ( cellNode->type() == QSGNode::TransformNodeType ) )
+    if ( cellNode && ( cellNode->type() == QSGNode::TransformNodeType )
+        && ( QskSGNode::nodeRole( cellNode ) == TextRole ) )
     {
         QSGNode* oldNode = cellNode;
 
-        auto newNode = updateCellNode( listView, oldNode, cellRect, row, col );
+        auto newNode = updateCellNode( listView, oldNode, cellRect, row, col, value );
         if ( newNode )
         {
             if ( newNode->type() == QSGNode::TransformNodeType )
@@ -331,7 +468,7 @@ QSGTransformNode* QskListViewSkinlet::updateForegroundNode(
     else
     {
         QSGNode* oldNode = cellNode ? cellNode->firstChild() : nullptr;
-        auto newNode = updateCellNode( listView, oldNode, cellRect, row, col );
+        auto newNode = updateCellNode( listView, oldNode, cellRect, row, col, value );
 
         if ( newNode )
         {
@@ -352,9 +489,9 @@ QSGTransformNode* QskListViewSkinlet::updateForegroundNode(
                     {
                         delete cellNode->firstChild();
                         cellNode->appendChildNode( newNode );
-
-                        newCellNode = cellNode;
                     }
+
+                    newCellNode = cellNode;
                 }
             }
         }
@@ -363,24 +500,11 @@ QSGTransformNode* QskListViewSkinlet::updateForegroundNode(
     if ( newCellNode == nullptr )
         newCellNode = new QSGTransformNode();
 
-    if ( cellNode != newCellNode )
-    {
-        if ( cellNode )
-        {
-            parentNode->insertChildNodeAfter( newCellNode, cellNode );
-            delete cellNode;
-        }
-        else
-        {
-            parentNode->appendChildNode( newCellNode );
-        }
-    }
-
     return newCellNode;
 }
 
 QSGNode* QskListViewSkinlet::updateCellNode( const QskListView* listView,
-    QSGNode* contentNode, const QRectF& rect, int row, int col ) const
+    QSGNode* contentNode, const QRectF& rect, int row, int, const QVariant& value ) const
 {
     using Q = QskListView;
     using namespace QskSGNode;
@@ -400,8 +524,6 @@ QSGNode* QskListViewSkinlet::updateCellNode( const QskListView* listView,
     const auto alignment = listView->alignmentHint(
         Q::Cell, Qt::AlignVCenter | Qt::AlignLeft );
 
-    const auto value = listView->valueAt( row, col );
-
     if ( value.canConvert< QskGraphic >() )
     {
         if ( nodeRole( contentNode ) == GraphicRole )
@@ -480,9 +602,9 @@ QRectF QskListViewSkinlet::sampleRect( const QskSkinnable* skinnable,
         const auto clipRect = node ? node->clipRect() : listView->viewContentsRect();
 
         const auto w = clipRect.width();
-        const auto h = listView->rowHeight();
+        const auto h = listView->rowHeightAt( index );
         const auto x = clipRect.left() + listView->scrollPos().x();
-        const auto y = clipRect.top() + index * h;
+        const auto y = clipRect.top() + listView->rowOffset( index );
 
         return QRectF( x, y, w, h );
     }
@@ -10,7 +10,7 @@
 
 class QskListView;
 
-class QMarginsF;
+class QVariant;
 class QSizeF;
 class QRectF;
 class QSGTransformNode;
@@ -50,16 +50,12 @@ class QSK_EXPORT QskListViewSkinlet : public QskScrollViewSkinlet
     void updateForegroundNodes( const QskListView*, QSGNode* ) const;
     void updateBackgroundNodes( const QskListView*, QSGNode* ) const;
 
-    void updateVisibleForegroundNodes(
-        const QskListView*, QSGNode*,
-        int rowMin, int rowMax, const QMarginsF& margin ) const;
-
     QSGTransformNode* updateForegroundNode( const QskListView*,
-        QSGNode* parentNode, QSGTransformNode* cellNode,
-        int row, int col, const QSizeF& ) const;
+        QSGTransformNode* cellNode, int row, int col,
+        const QVariant&, const QSizeF& ) const;
 
-    QSGNode* updateCellNode( const QskListView*,
-        QSGNode*, const QRectF&, int row, int col ) const;
+    QSGNode* updateCellNode( const QskListView*, QSGNode*,
+        const QRectF&, int row, int col, const QVariant& ) const;
 };
 
 #endif
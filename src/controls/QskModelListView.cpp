@@ -0,0 +1,399 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskModelListView.h"
+#include "QskRowHeights.h"
+#include "QskTextOptions.h"
+#include "QskEvent.h"
+
+#include <qpointer.h>
+
+static inline QSizeF qskSize( const QVariant& value )
+{
+    switch ( value.userType() )
+    {
+        case QMetaType::QSize:
+            return value.toSize();
+
+        case QMetaType::QSizeF:
+            return value.toSizeF();
+    }
+
+    return QSizeF();
+}
+
+class QskModelListView::PrivateData
+{
+  public:
+    QPointer< QAbstractItemModel > model;
+    QVector< QMetaObject::Connection > connections;
+
+    QskRowHeights rowHeights;
+    QVector< qreal > columnWidthHints;
+};
+
+QskModelListView::QskModelListView( QQuickItem* parent )
+    : Inherited( parent )
+    , m_data( new PrivateData() )
+{
+}
+
+QskModelListView::~QskModelListView()
+{
+}
+
+void QskModelListView::setModel( QAbstractItemModel* model )
+{
+    if ( model == m_data->model )
+        return;
+
+    for ( const auto& connection : std::as_const( m_data->connections ) )
+        disconnect( connection );
+
+    m_data->connections.clear();
+    m_data->model = model;
+
+    if ( model )
+    {
+        using M = QAbstractItemModel;
+        using Q = QskModelListView;
+
+        m_data->connections =
+        {
+            connect( model, &M::rowsInserted, this, &Q::insertRows ),
+            connect( model, &M::rowsRemoved, this, &Q::removeRows ),
+            connect( model, &M::dataChanged, this, &Q::updateRows ),
+
+            connect( model, &M::modelReset, this, &Q::resetRows ),
+            connect( model, &M::layoutChanged, this, &Q::resetRows ),
+            connect( model, &M::rowsMoved, this, &Q::resetRows ),
+            connect( model, &M::columnsInserted, this, &Q::resetRows ),
+            connect( model, &M::columnsRemoved, this, &Q::resetRows ),
+
+            connect( model, &M::headerDataChanged,
+                this, &Q::updateScrollableSize ),
+
+            connect( model, &QObject::destroyed, this,
+                [ this ]()
+                {
+                    m_data->connections.clear();
+                    resetRows();
+
+                    Q_EMIT modelChanged();
+                } )
+        };
+    }
+
+    setSelectedRow( -1 );
+    resetRows();
+
+    Q_EMIT modelChanged();
+}
+
+QAbstractItemModel* QskModelListView::model() const
+{
+    return m_data->model;
+}
+
+void QskModelListView::setColumnWidthHint( int column, qreal width )
+{
+    if ( column < 0 )
+        return;
+
+    auto& hints = m_data->columnWidthHints;
+
+    width = qMax( width, qreal( 0.0 ) );
+
+    if ( column >= hints.count() )
+    {
+        if ( width == 0.0 )
+            return;
+
+        hints.resize( column + 1 );
+    }
+
+    if ( width != hints[ column ] )
+    {
+        hints[ column ] = width;
+        updateScrollableSize();
+    }
+}
+
+qreal QskModelListView::columnWidthHint( int column ) const
+{
+    return m_data->columnWidthHints.value( column, 0.0 );
+}
+
+int QskModelListView::rowCount() const
+{
+    return m_data->rowHeights.count();
+}
+
+int QskModelListView::columnCount() const
+{
+    if ( const auto model = m_data->model.data() )
+        return model->columnCount();
+
+    return 0;
+}
+
+qreal QskModelListView::columnWidth( int col ) const
+{
+    const auto count = columnCount();
+    if ( col < 0 || col >= count )
+        return 0.0;
+
+    const auto hint = columnWidthHint( col );
+    if ( hint > 0.0 )
+        return hint;
+
+    const auto size = qskSize( m_data->model->headerData(
+        col, Qt::Horizontal, Qt::SizeHintRole ) );
+
+    if ( size.width() > 0.0 )
+        return size.width();
+
+    // the columns without hints share the width of the view
+    qreal w = viewContentsRect().width();
+    int n = 0;
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const auto columnHint = columnWidthHint( i );
+        if ( columnHint > 0.0 )
+            w -= columnHint;
+        else
+            n++;
+    }
+
+    return qMax( w / n, qreal( 0.0 ) );
+}
+
+qreal QskModelListView::rowHeight() const
+{
+    const auto hint = strutSizeHint( Cell );
+    const auto padding = paddingHint( Cell );
+
+    qreal h = effectiveFontHeight( Text );
+    h += padding.top() + padding.bottom();
+
+    return qMax( h, hint.height() );
+}
+
+qreal QskModelListView::rowHeightAt( int row ) const
+{
+    return m_data->rowHeights.height( row );
+}
+
+qreal QskModelListView::rowOffset( int row ) const
+{
+    return m_data->rowHeights.offset( row );
+}
+
+int QskModelListView::rowAt( qreal y ) const
+{
+    return m_data->rowHeights.rowAt( y );
+}
+
+QVariant QskModelListView::valueAt( int row, int col ) const
+{
+    const auto model = m_data->model.data();
+    if ( model == nullptr )
+        return QVariant();
+
+    const auto index = model->index( row, col );
+
+    auto value = model->data( index, Qt::DisplayRole );
+    if ( !value.isValid() )
+    {
+        value = model->data( index, Qt::DecorationRole );
+        if ( !value.isValid() )
+            value = QString();
+    }
+
+    return value;
+}
+
+qreal QskModelListView::heightForRow( int row ) const
+{
+    const auto model = m_data->model.data();
+    if ( model == nullptr )
+        return 0.0;
+
+    const auto hint = qskSize( model->data( model->index( row, 0 ), Qt::SizeHintRole ) );
+    if ( hint.height() > 0.0 )
+        return hint.height();
+
+    int lineCount = 1;
+
+    for ( int col = 0; col < model->columnCount(); col++ )
+    {
+        const auto value = model->data( model->index( row, col ), Qt::DisplayRole );
+
+        if ( value.userType() == QMetaType::QString )
+        {
+            const int n = int( value.toString().count( QLatin1Char( '\n' ) ) ) + 1;
+            lineCount = qMax( lineCount, n );
+        }
+    }
+
+    lineCount = qMin( lineCount, textOptions().maximumLineCount() );
+
+    return rowHeight() + ( lineCount - 1 ) * effectiveFontHeight( Text );
+}
+
+void QskModelListView::resetRows()
+{
+    auto& rowHeights = m_data->rowHeights;
+    rowHeights.clear();
+
+    if ( const auto model = m_data->model.data() )
+    {
+        const auto count = model->rowCount();
+
+        QVector< qreal > heights;
+        heights.reserve( count );
+
+        for ( int row = 0; row < count; row++ )
+            heights += heightForRow( row );
+
+        rowHeights.insert( 0, heights );
+    }
+
+    if ( selectedRow() >= rowHeights.count() )
+        setSelectedRow( -1 );
+
+    updateScrollableSize();
+    update();
+}
+
+void QskModelListView::insertRows( const QModelIndex& parent, int first, int last )
+{
+    if ( parent.isValid() )
+        return;
+
+    QVector< qreal > heights;
+    heights.reserve( last - first + 1 );
+
+    for ( int row = first; row <= last; row++ )
+        heights += heightForRow( row );
+
+    m_data->rowHeights.insert( first, heights );
+
+    const auto row = selectedRow();
+    if ( row >= first )
+        setSelectedRow( row + heights.count() );
+
+    updateScrollableSize();
+
+    // all rows below are moving
+    if ( isRowVisible( first, rowCount() - 1 ) )
+        update();
+}
+
+void QskModelListView::removeRows( const QModelIndex& parent, int first, int last )
+{
+    if ( parent.isValid() )
+        return;
+
+    const auto count = last - first + 1;
+
+    m_data->rowHeights.remove( first, count );
+
+    const auto row = selectedRow();
+    if ( row > last )
+        setSelectedRow( row - count );
+    else if ( row >= first )
+        setSelectedRow( -1 );
+
+    updateScrollableSize();
+
+    if ( isRowVisible( first, rowCount() - 1 ) )
+        update();
+}
+
+void QskModelListView::updateRows( const QModelIndex& topLeft,
+    const QModelIndex& bottomRight, const QVector< int >& roles )
+{
+    if ( topLeft.parent().isValid() )
+        return;
+
+    const auto first = topLeft.row();
+    const auto last = qMin( bottomRight.row(), rowCount() - 1 );
+
+    bool heightsChanged = false;
+
+    if ( roles.isEmpty() || roles.contains( Qt::DisplayRole )
+        || roles.contains( Qt::SizeHintRole ) )
+    {
+        auto& rowHeights = m_data->rowHeights;
+
+        for ( int row = first; row <= last; row++ )
+        {
+            const auto h = heightForRow( row );
+            if ( h != rowHeights.height( row ) )
+            {
+                rowHeights.setHeight( row, h );
+                heightsChanged = true;
+            }
+        }
+    }
+
+    if ( heightsChanged )
+    {
+        updateScrollableSize();
+
+        if ( isRowVisible( first, rowCount() - 1 ) )
+            update();
+    }
+    else
+    {
+        if ( isRowVisible( first, last ) )
+            update();
+    }
+}
+
+bool QskModelListView::isRowVisible( int first, int last ) const
+{
+    const auto y1 = scrollPos().y();
+    const auto y2 = y1 + viewContentsRect().height();
+
+    int rowMin = rowAt( y1 );
+    if ( rowMin < 0 )
+    {
+        // -1: above the first or below the last row
+        if ( y1 >= 0.0 || y2 < 0.0 )
+            return false;
+
+        rowMin = 0;
+    }
+
+    int rowMax = rowAt( y2 );
+    if ( rowMax < 0 )
+        rowMax = rowCount() - 1;
+
+    return ( first <= rowMax ) && ( last >= rowMin );
+}
+
+void QskModelListView::changeEvent( QEvent* event )
+{
+    if ( event->type() == QEvent::StyleChange )
+    {
+        // the heights depend on fonts and paddings
+        resetRows();
+    }
+
+    Inherited::changeEvent( event );
+}
+
+void QskModelListView::geometryChangeEvent( QskGeometryChangeEvent* event )
+{
+    Inherited::geometryChangeEvent( event );
+
+    if ( event->isResized() )
+        updateScrollableSize();
+}
+
+#include "moc_QskModelListView.cpp"
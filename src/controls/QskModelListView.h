@@ -0,0 +1,81 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_MODEL_LIST_VIEW_H
+#define QSK_MODEL_LIST_VIEW_H
+
+#include "QskListView.h"
+#include <qabstractitemmodel.h>
+
+/*
+    A list view displaying the top level rows of a QAbstractItemModel.
+
+    Qt::DisplayRole is used for the cells, falling back to Qt::DecorationRole
+    for graphics. Rows might have different heights: Qt::SizeHintRole of the
+    first column, or the number of text lines, when not being available.
+    The heights are stored in an index, so that lookups are O(log n) even for
+    huge models.
+
+    Changes of the model are processed incrementally: only the heights
+    of the affected rows are updated and the view is only repainted, when
+    visible rows are affected.
+ */
+class QSK_EXPORT QskModelListView : public QskListView
+{
+    Q_OBJECT
+
+    Q_PROPERTY( QAbstractItemModel* model READ model
+        WRITE setModel NOTIFY modelChanged FINAL )
+
+    using Inherited = QskListView;
+
+  public:
+    QskModelListView( QQuickItem* parent = nullptr );
+    ~QskModelListView() override;
+
+    void setModel( QAbstractItemModel* );
+    QAbstractItemModel* model() const;
+
+    // <= 0: Qt::SizeHintRole of the header or the width of the view
+    void setColumnWidthHint( int column, qreal width );
+    qreal columnWidthHint( int column ) const;
+
+    int rowCount() const override final;
+    int columnCount() const override final;
+
+    qreal columnWidth( int col ) const override;
+
+    // the height of a row with a single line of text
+    qreal rowHeight() const override;
+
+    qreal rowHeightAt( int row ) const override final;
+    qreal rowOffset( int row ) const override final;
+    int rowAt( qreal y ) const override final;
+
+    QVariant valueAt( int row, int col ) const override;
+
+  Q_SIGNALS:
+    void modelChanged();
+
+  protected:
+    virtual qreal heightForRow( int row ) const;
+
+    void changeEvent( QEvent* ) override;
+    void geometryChangeEvent( QskGeometryChangeEvent* ) override;
+
+  private:
+    void resetRows();
+
+    void insertRows( const QModelIndex&, int first, int last );
+    void removeRows( const QModelIndex&, int first, int last );
+    void updateRows( const QModelIndex&, const QModelIndex&, const QVector< int >& );
+
+    bool isRowVisible( int first, int last ) const;
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -440,7 +440,7 @@ const QSGRootNode* qskScenegraphAnchorNode( const QQuickWindow* window )
     return nullptr;
 }
 
-void qskSetScenegraphAnchor( QQuickItem* item, bool on )
+void qskSetScenegraphAnchor( QQuickItem* item, bool on, bool hide )
 {
     /*
         For setting up a subtree renderer ( f.e in QskSceneTexture ) we need
@@ -451,15 +451,19 @@ void qskSetScenegraphAnchor( QQuickItem* item, bool on )
 
         refFromEffectItem also allows to insert a opacity node of 0 to
         hide the subtree from the main renderer by setting its parameter to
-        true. We have QskItemNode to achieve the same.
+        true. We have QskItemNode to achieve the same, but the opacity node
+        is below the item node, what allows to add nodes to the item node,
+        that are still visible ( f.e QskLayerNode ).
+
+        Calls with hide need to be balanced by calls with hide.
      */
     if ( item )
     {
         auto d = QQuickItemPrivate::get( item );
         if ( on )
-            d->refFromEffectItem( false );
+            d->refFromEffectItem( hide );
         else
-            d->derefFromEffectItem( false );
+            d->derefFromEffectItem( hide );
     }
 }
 
@@ -0,0 +1,174 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskRowHeights.h"
+
+static inline int qskLowBit( int i )
+{
+    return i & -i;
+}
+
+static inline int qskHighBit( int i )
+{
+    int bit = 1;
+    while ( ( bit << 1 ) <= i )
+        bit <<= 1;
+
+    return bit;
+}
+
+void QskRowHeights::clear()
+{
+    m_heights.clear();
+    m_tree.clear();
+}
+
+void QskRowHeights::append( qreal height )
+{
+    height = qMax( height, qreal( 0.0 ) );
+
+    const int n = m_heights.count() + 1;
+
+    m_heights += height;
+
+    if ( m_tree.isEmpty() )
+        m_tree += 0.0;
+
+    /*
+        m_tree[n] is the sum of the heights of the rows ]n - lowbit(n), n].
+        As all rows before are already in the index we can
+        calculate it from the prefix sums.
+     */
+    m_tree += prefixSum( n - 1 ) - prefixSum( n - qskLowBit( n ) ) + height;
+}
+
+void QskRowHeights::insert( int row, const QVector< qreal >& heights )
+{
+    if ( heights.isEmpty() )
+        return;
+
+    const int count = m_heights.count();
+
+    if ( row < 0 || row > count )
+        row = count;
+
+    if ( row == count && count > 0 )
+    {
+        // appending to the index is O(log n) for each row
+        for ( const auto h : heights )
+            append( h );
+
+        return;
+    }
+
+    QVector< qreal > newHeights;
+    newHeights.reserve( count + heights.count() );
+
+    newHeights += m_heights.mid( 0, row );
+
+    for ( const auto h : heights )
+        newHeights += qMax( h, qreal( 0.0 ) );
+
+    newHeights += m_heights.mid( row );
+
+    m_heights = newHeights;
+    rebuild();
+}
+
+void QskRowHeights::remove( int row, int count )
+{
+    if ( row < 0 || row >= m_heights.count() || count <= 0 )
+        return;
+
+    count = qMin( count, m_heights.count() - row );
+
+    if ( row + count == m_heights.count() )
+    {
+        // the entries of the leading rows do not depend on the trailing ones
+        m_heights.resize( row );
+        m_tree.resize( row + 1 );
+    }
+    else
+    {
+        m_heights.remove( row, count );
+        rebuild();
+    }
+}
+
+void QskRowHeights::setHeight( int row, qreal height )
+{
+    if ( row < 0 || row >= m_heights.count() )
+        return;
+
+    height = qMax( height, qreal( 0.0 ) );
+
+    const auto delta = height - m_heights[ row ];
+    if ( delta == 0.0 )
+        return;
+
+    m_heights[ row ] = height;
+
+    for ( int i = row + 1; i < m_tree.count(); i += qskLowBit( i ) )
+        m_tree[ i ] += delta;
+}
+
+qreal QskRowHeights::offset( int row ) const
+{
+    return prefixSum( qBound( 0, row, m_heights.count() ) );
+}
+
+int QskRowHeights::rowAt( qreal pos ) const
+{
+    const int n = m_heights.count();
+
+    if ( n == 0 || pos < 0.0 )
+        return -1;
+
+    /*
+        Looking for the largest index with a prefix sum <= pos
+        by descending the implicit tree.
+     */
+    int index = 0;
+
+    for ( int bit = qskHighBit( n ); bit > 0; bit >>= 1 )
+    {
+        const int next = index + bit;
+        if ( next <= n && m_tree[ next ] <= pos )
+        {
+            index = next;
+            pos -= m_tree[ next ];
+        }
+    }
+
+    return ( index < n ) ? index : -1;
+}
+
+qreal QskRowHeights::prefixSum( int count ) const
+{
+    qreal sum = 0.0;
+
+    for ( int i = count; i > 0; i -= qskLowBit( i ) )
+        sum += m_tree[ i ];
+
+    return sum;
+}
+
+void QskRowHeights::rebuild()
+{
+    const int n = m_heights.count();
+
+    m_tree.resize( n + 1 );
+    m_tree[ 0 ] = 0.0;
+
+    for ( int i = 1; i <= n; i++ )
+        m_tree[ i ] = m_heights[ i - 1 ];
+
+    for ( int i = 1; i <= n; i++ )
+    {
+        const int j = i + qskLowBit( i );
+        if ( j <= n )
+            m_tree[ j ] += m_tree[ i ];
+    }
+}
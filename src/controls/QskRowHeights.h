@@ -0,0 +1,73 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_ROW_HEIGHTS_H
+#define QSK_ROW_HEIGHTS_H
+
+#include "QskGlobal.h"
+#include <qvector.h>
+
+/*
+    Heights of the rows of a list with an index ( Fenwick tree ) for the
+    prefix sums. Finding the position of a row and the row at a position
+    is O(log n), so that lists with many rows of different heights can
+    be scrolled efficiently.
+
+    Changing the height of a row and appending rows are O(log n), while
+    inserting/removing rows in the middle rebuilds the index in O(n).
+ */
+class QSK_EXPORT QskRowHeights
+{
+  public:
+    QskRowHeights() = default;
+
+    int count() const;
+    bool isEmpty() const;
+
+    void clear();
+
+    void append( qreal height );
+    void insert( int row, const QVector< qreal >& heights );
+    void remove( int row, int count = 1 );
+
+    void setHeight( int row, qreal height );
+    qreal height( int row ) const;
+
+    // the position of the row, offset( count() ) is the total height
+    qreal offset( int row ) const;
+    qreal totalHeight() const;
+
+    // -1, when being outside of [ 0, totalHeight() [
+    int rowAt( qreal pos ) const;
+
+  private:
+    qreal prefixSum( int count ) const;
+    void rebuild();
+
+    QVector< qreal > m_heights;
+    QVector< qreal > m_tree; // 1-based
+};
+
+inline int QskRowHeights::count() const
+{
+    return m_heights.count();
+}
+
+inline bool QskRowHeights::isEmpty() const
+{
+    return m_heights.isEmpty();
+}
+
+inline qreal QskRowHeights::height( int row ) const
+{
+    return ( row >= 0 && row < m_heights.count() ) ? m_heights[ row ] : 0.0;
+}
+
+inline qreal QskRowHeights::totalHeight() const
+{
+    return prefixSum( m_heights.count() );
+}
+
+#endif
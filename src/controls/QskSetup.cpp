@@ -17,6 +17,12 @@ namespace
         if ( !qskHasEnvironment( "QSK_PREFER_FBO_PAINTING" ) )
             flags |= QskItem::PreferRasterForTextures;
 
+        if ( qskHasEnvironment( "QSK_PREFER_GRAPHIC_GEOMETRY" ) )
+            flags |= QskItem::PreferGeometryForGraphics;
+
+        if ( qskHasEnvironment( "QSK_ASYNC_RASTER" ) )
+            flags |= QskItem::AsyncRasterForTextures;
+
         if ( qskHasEnvironment( "QSK_FORCE_BACKGROUND" ) )
             flags |= QskItem::DebugForceBackground;
 
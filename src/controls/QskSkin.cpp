@@ -285,6 +285,21 @@ void QskSkin::setColorScheme( ColorScheme colorScheme )
     Q_EMIT colorSchemeChanged( colorScheme );
 }
 
+void QskSkin::restoreHints( ColorScheme colorScheme,
+    const QskSkinHintTable& hintTable, const QHash< QskFontRole, QFont >& fonts,
+    const QHash< int, QskColorFilter >& graphicFilters )
+{
+    m_data->hintTable = hintTable;
+    m_data->fonts = fonts;
+    m_data->graphicFilters = graphicFilters;
+
+    if ( colorScheme != m_data->colorScheme )
+    {
+        m_data->colorScheme = colorScheme;
+        Q_EMIT colorSchemeChanged( colorScheme );
+    }
+}
+
 void QskSkin::setSkinHint( QskAspect aspect, const QVariant& skinHint )
 {
     m_data->hintTable.setHint( aspect, skinHint );
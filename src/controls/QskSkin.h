@@ -81,6 +81,13 @@ class QSK_EXPORT QskSkin : public QObject
 
     ColorScheme colorScheme() const;
 
+    /*
+        Replaces hints, fonts and graphic filters without calling initHints().
+        Used for restoring snapshots - see QskSkinIO.
+     */
+    void restoreHints( ColorScheme, const QskSkinHintTable&,
+        const QHash< QskFontRole, QFont >&, const QHash< int, QskColorFilter >& );
+
   public Q_SLOTS:
     void setColorScheme( ColorScheme );
 
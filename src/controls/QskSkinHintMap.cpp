@@ -0,0 +1,275 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskSkinHintMap.h"
+
+#include <algorithm>
+#include <cstring>
+
+static inline bool qskIsInlineType( int typeId )
+{
+    switch( typeId )
+    {
+        case QMetaType::Bool:
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Double:
+        case QMetaType::Float:
+        case QMetaType::QColor:
+        case QMetaType::QSize:
+        case QMetaType::QSizeF:
+        case QMetaType::QPoint:
+        case QMetaType::QPointF:
+            return true;
+
+        default:
+        {
+            // enums and flags
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+            const QMetaType metaType( typeId );
+            return ( metaType.flags() & QMetaType::IsEnumeration )
+                && ( metaType.sizeOf() <= 2 * int( sizeof( quint64 ) ) );
+#else
+            return ( QMetaType::typeFlags( typeId ) & QMetaType::IsEnumeration )
+                && ( QMetaType::sizeOf( typeId ) <= 2 * int( sizeof( quint64 ) ) );
+#endif
+        }
+    }
+}
+
+static inline int qskSizeOf( int typeId )
+{
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    return QMetaType( typeId ).sizeOf();
+#else
+    return QMetaType::sizeOf( typeId );
+#endif
+}
+
+QskSkinHintMap::Value::Value() noexcept
+    : m_data{ 0, 0 }
+    , m_typeId( QMetaType::UnknownType )
+    , m_isInline( true )
+{
+}
+
+QskSkinHintMap::Value::Value( const QVariant& value )
+    : m_data{ 0, 0 }
+    , m_typeId( value.userType() )
+    , m_isInline( qskIsInlineType( m_typeId ) )
+{
+    if ( m_isInline )
+        std::memcpy( m_data, value.constData(), qskSizeOf( m_typeId ) );
+    else
+        m_variant = new QVariant( value );
+}
+
+QskSkinHintMap::Value::Value( const Value& other )
+    : m_data{ other.m_data[ 0 ], other.m_data[ 1 ] }
+    , m_typeId( other.m_typeId )
+    , m_isInline( other.m_isInline )
+{
+    if ( !m_isInline )
+        m_variant = new QVariant( *other.m_variant );
+}
+
+QskSkinHintMap::Value::Value( Value&& other ) noexcept
+    : m_data{ other.m_data[ 0 ], other.m_data[ 1 ] }
+    , m_typeId( other.m_typeId )
+    , m_isInline( other.m_isInline )
+{
+    other.m_typeId = QMetaType::UnknownType;
+    other.m_isInline = true;
+}
+
+QskSkinHintMap::Value::~Value()
+{
+    release();
+}
+
+QskSkinHintMap::Value& QskSkinHintMap::Value::operator=( const Value& other )
+{
+    if ( this != &other )
+    {
+        release();
+
+        m_data[ 0 ] = other.m_data[ 0 ];
+        m_data[ 1 ] = other.m_data[ 1 ];
+        m_typeId = other.m_typeId;
+        m_isInline = other.m_isInline;
+
+        if ( !m_isInline )
+            m_variant = new QVariant( *other.m_variant );
+    }
+
+    return *this;
+}
+
+QskSkinHintMap::Value& QskSkinHintMap::Value::operator=( Value&& other ) noexcept
+{
+    if ( this != &other )
+    {
+        release();
+
+        m_data[ 0 ] = other.m_data[ 0 ];
+        m_data[ 1 ] = other.m_data[ 1 ];
+        m_typeId = other.m_typeId;
+        m_isInline = other.m_isInline;
+
+        other.m_typeId = QMetaType::UnknownType;
+        other.m_isInline = true;
+    }
+
+    return *this;
+}
+
+inline void QskSkinHintMap::Value::release() noexcept
+{
+    if ( !m_isInline )
+        delete m_variant;
+}
+
+QVariant QskSkinHintMap::Value::toVariant() const
+{
+    if ( !m_isInline )
+        return *m_variant;
+
+    if ( m_typeId == QMetaType::UnknownType )
+        return QVariant();
+
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    return QVariant( QMetaType( m_typeId ), m_data );
+#else
+    return QVariant( m_typeId, m_data );
+#endif
+}
+
+int QskSkinHintMap::Value::allocatedBytes() const
+{
+    if ( m_isInline )
+        return 0;
+
+    /*
+        A rough estimation: QVariant allocates types, that do
+        not fit into its own storage. Memory allocated by the type
+        itself - f.e the stops of a gradient - is ignored.
+     */
+    auto bytes = int( sizeof( QVariant ) );
+
+    const int size = qskSizeOf( m_typeId );
+    if ( size > int( sizeof( QVariant ) ) - int( sizeof( void* ) ) )
+        bytes += size;
+
+    return bytes;
+}
+
+inline int QskSkinHintMap::lowerBound( QskAspect aspect ) const
+{
+    const auto keys = m_keys.constData();
+
+    const auto it = std::lower_bound( keys, keys + m_keys.size(), aspect );
+    return static_cast< int >( it - keys );
+}
+
+int QskSkinHintMap::indexOf( QskAspect aspect ) const
+{
+    const auto index = lowerBound( aspect );
+
+    if ( index < m_keys.size() && m_keys[ index ] == aspect )
+        return index;
+
+    return -1;
+}
+
+QskSkinHintMap::iterator QskSkinHintMap::find( QskAspect aspect )
+{
+    const auto index = indexOf( aspect );
+    if ( index < 0 )
+        return end();
+
+    return iterator( m_keys.constData() + index, m_values.data() + index );
+}
+
+QskSkinHintMap::iterator QskSkinHintMap::begin()
+{
+    return iterator( m_keys.constData(), m_values.data() );
+}
+
+QskSkinHintMap::iterator QskSkinHintMap::end()
+{
+    const auto values = m_values.data();
+    return iterator( m_keys.constData() + m_keys.size(), values + m_values.size() );
+}
+
+QskSkinHintMap::iterator QskSkinHintMap::insert(
+    QskAspect aspect, const QVariant& value )
+{
+    const auto index = lowerBound( aspect );
+
+    if ( index < m_keys.size() && m_keys[ index ] == aspect )
+    {
+        m_values[ index ] = Value( value );
+    }
+    else
+    {
+        m_keys.insert( index, aspect );
+        m_values.insert( index, Value( value ) );
+    }
+
+    return iterator( m_keys.constData() + index, m_values.data() + index );
+}
+
+bool QskSkinHintMap::remove( QskAspect aspect )
+{
+    const auto index = indexOf( aspect );
+    if ( index < 0 )
+        return false;
+
+    m_keys.remove( index );
+    m_values.remove( index );
+
+    return true;
+}
+
+QskSkinHintMap::iterator QskSkinHintMap::erase( iterator it )
+{
+    const auto index = static_cast< int >( it.m_key - m_keys.constData() );
+
+    m_keys.remove( index );
+    m_values.remove( index );
+
+    return iterator( m_keys.constData() + index, m_values.data() + index );
+}
+
+void QskSkinHintMap::clear()
+{
+    m_keys.clear();
+    m_values.clear();
+}
+
+void QskSkinHintMap::reserve( int size )
+{
+    m_keys.reserve( size );
+    m_values.reserve( size );
+}
+
+void QskSkinHintMap::squeeze()
+{
+    m_keys.squeeze();
+    m_values.squeeze();
+}
+
+qint64 QskSkinHintMap::allocatedBytes() const
+{
+    qint64 bytes = m_keys.capacity() * qint64( sizeof( QskAspect ) )
+        + m_values.capacity() * qint64( sizeof( Value ) );
+
+    for ( const auto& value : m_values )
+        bytes += value.allocatedBytes();
+
+    return bytes;
+}
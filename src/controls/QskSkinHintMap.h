@@ -0,0 +1,258 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_SKIN_HINT_MAP_H
+#define QSK_SKIN_HINT_MAP_H
+
+#include "QskAspect.h"
+
+#include <qvariant.h>
+#include <qvector.h>
+
+/*
+    An alternative storage for QskSkinHintTable, that can be enabled
+    by building with QSK_FLAT_SKIN_HINTS.
+
+    Keys and values are stored in 2 sorted arrays, what is more compact
+    than the nodes of a QHash and allows lookups by a binary search on a
+    contiguous block of 64 bit values. Inserting/removing is O(n) - but skin
+    hints are usually written once and read many times.
+
+    Small trivially copyable values - metrics, colors, flags, alignments -
+    are stored inline. Only other types are stored in a QVariant.
+
+    The API is a subset of the QHash API - as far as it is used for
+    storing skin hints. As the values are no QVariants, they are returned
+    by value.
+ */
+class QSK_EXPORT QskSkinHintMap
+{
+  public:
+    class QSK_EXPORT Value
+    {
+      public:
+        Value() noexcept;
+        Value( const QVariant& );
+
+        Value( const Value& );
+        Value( Value&& ) noexcept;
+
+        ~Value();
+
+        Value& operator=( const Value& );
+        Value& operator=( Value&& ) noexcept;
+
+        QVariant toVariant() const;
+
+        // for statistics: the number of bytes allocated for the value
+        int allocatedBytes() const;
+
+      private:
+        void release() noexcept;
+
+        union
+        {
+            quint64 m_data[ 2 ];
+            QVariant* m_variant;
+        };
+
+        int m_typeId;
+        bool m_isInline;
+    };
+
+    class const_iterator
+    {
+      public:
+        const_iterator() = default;
+
+        inline QskAspect key() const { return *m_key; }
+        inline QVariant value() const { return m_value->toVariant(); }
+
+        inline QVariant operator*() const { return m_value->toVariant(); }
+
+        inline const_iterator& operator++()
+        {
+            ++m_key;
+            ++m_value;
+            return *this;
+        }
+
+        inline bool operator==( const const_iterator& other ) const
+        {
+            return m_key == other.m_key;
+        }
+
+        inline bool operator!=( const const_iterator& other ) const
+        {
+            return m_key != other.m_key;
+        }
+
+      private:
+        friend class QskSkinHintMap;
+
+        inline const_iterator( const QskAspect* key, const Value* value )
+            : m_key( key )
+            , m_value( value )
+        {
+        }
+
+        const QskAspect* m_key = nullptr;
+        const Value* m_value = nullptr;
+    };
+
+    class iterator
+    {
+      public:
+        iterator() = default;
+
+        inline QskAspect key() const { return *m_key; }
+        inline QVariant value() const { return m_value->toVariant(); }
+
+        inline QVariant operator*() const { return m_value->toVariant(); }
+
+        inline void setValue( const QVariant& value ) const { *m_value = value; }
+
+        inline iterator& operator++()
+        {
+            ++m_key;
+            ++m_value;
+            return *this;
+        }
+
+        inline bool operator==( const iterator& other ) const
+        {
+            return m_key == other.m_key;
+        }
+
+        inline bool operator!=( const iterator& other ) const
+        {
+            return m_key != other.m_key;
+        }
+
+      private:
+        friend class QskSkinHintMap;
+
+        inline iterator( const QskAspect* key, Value* value )
+            : m_key( key )
+            , m_value( value )
+        {
+        }
+
+        const QskAspect* m_key = nullptr;
+        Value* m_value = nullptr;
+    };
+
+    QskSkinHintMap() = default;
+
+    int size() const;
+    bool empty() const;
+    bool isEmpty() const;
+
+    bool contains( QskAspect ) const;
+    QVariant value( QskAspect ) const;
+
+    const_iterator constFind( QskAspect ) const;
+    const_iterator find( QskAspect ) const;
+    iterator find( QskAspect );
+
+    const_iterator constBegin() const;
+    const_iterator constEnd() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    iterator begin();
+    iterator end();
+
+    iterator insert( QskAspect, const QVariant& );
+
+    bool remove( QskAspect );
+    iterator erase( iterator );
+
+    void clear();
+    void reserve( int size );
+    void squeeze();
+
+    bool isSharedWith( const QskSkinHintMap& ) const;
+
+    // for statistics: the number of bytes allocated for keys and values
+    qint64 allocatedBytes() const;
+
+  private:
+    int lowerBound( QskAspect ) const;
+    int indexOf( QskAspect ) const;
+
+    QVector< QskAspect > m_keys;
+    QVector< Value > m_values;
+};
+
+inline int QskSkinHintMap::size() const
+{
+    return m_keys.size();
+}
+
+inline bool QskSkinHintMap::empty() const
+{
+    return m_keys.isEmpty();
+}
+
+inline bool QskSkinHintMap::isEmpty() const
+{
+    return m_keys.isEmpty();
+}
+
+inline bool QskSkinHintMap::contains( QskAspect aspect ) const
+{
+    return indexOf( aspect ) >= 0;
+}
+
+inline QVariant QskSkinHintMap::value( QskAspect aspect ) const
+{
+    const auto index = indexOf( aspect );
+    return ( index >= 0 ) ? m_values[ index ].toVariant() : QVariant();
+}
+
+inline QskSkinHintMap::const_iterator QskSkinHintMap::constBegin() const
+{
+    return const_iterator( m_keys.constData(), m_values.constData() );
+}
+
+inline QskSkinHintMap::const_iterator QskSkinHintMap::constEnd() const
+{
+    return const_iterator( m_keys.constData() + m_keys.size(),
+        m_values.constData() + m_values.size() );
+}
+
+inline QskSkinHintMap::const_iterator QskSkinHintMap::begin() const
+{
+    return constBegin();
+}
+
+inline QskSkinHintMap::const_iterator QskSkinHintMap::end() const
+{
+    return constEnd();
+}
+
+inline QskSkinHintMap::const_iterator QskSkinHintMap::constFind( QskAspect aspect ) const
+{
+    const auto index = indexOf( aspect );
+    if ( index < 0 )
+        return constEnd();
+
+    return const_iterator( m_keys.constData() + index, m_values.constData() + index );
+}
+
+inline QskSkinHintMap::const_iterator QskSkinHintMap::find( QskAspect aspect ) const
+{
+    return constFind( aspect );
+}
+
+inline bool QskSkinHintMap::isSharedWith( const QskSkinHintMap& other ) const
+{
+    return m_keys.isSharedWith( other.m_keys )
+        && m_values.isSharedWith( other.m_values );
+}
+
+#endif
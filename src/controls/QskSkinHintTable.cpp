@@ -6,12 +6,81 @@
 #include "QskSkinHintTable.h"
 #include "QskAnimationHint.h"
 
+#if defined( QSK_FLAT_SKIN_HINTS )
+    #include "QskSkinHintMap.h"
+    #include <unordered_map>
+#endif
+
 #include <limits>
 
-const QVariant QskSkinHintTable::invalidHint;
+static const QVariant qskInvalidHint;
+
+/*
+    With ENABLE_FLAT_SKIN_HINTS the hints are stored in a QskSkinHintMap.
+    As it does not store QVariants, references to the hints are given
+    to copies in the cache, that need to have stable addresses, what is
+    why a node based container is used.
+
+    Otherwise the pointers in the cache refer to the values of the QHash.
+ */
+
+#if defined( QSK_FLAT_SKIN_HINTS )
+
+class QskSkinHintTable::Storage : public QskSkinHintMap
+{
+};
+
+namespace
+{
+    struct AspectHash
+    {
+        inline size_t operator()( QskAspect aspect ) const noexcept
+        {
+            return qHash( aspect );
+        }
+    };
+}
+
+#else
+
+class QskSkinHintTable::Storage : public QskSkinHintTable::HintMap
+{
+};
+
+#endif
+
+struct QskSkinHintTable::ResolvedHint
+{
+    const QVariant* hint = nullptr;
+    QskAspect aspect;
+
+#if defined( QSK_FLAT_SKIN_HINTS )
+    QVariant value; // hint points to this copy
+#endif
+};
+
+class QskSkinHintTable::Cache
+{
+  public:
+#if defined( QSK_FLAT_SKIN_HINTS )
+    // results of the fallback resolution, including the misses
+    std::unordered_map< QskAspect, ResolvedHint, AspectHash > resolvedHints;
+
+    // copies of the hints returned by hint()
+    std::unordered_map< QskAspect, QVariant, AspectHash > hints;
+
+    // created on request by hints()
+    HintMap hintMap;
+    bool hasHintMap = false;
+#else
+    // results of the fallback resolution, including the misses
+    QHash< QskAspect, ResolvedHint > resolvedHints;
+#endif
+};
 
-inline const QVariant* qskResolvedHint( QskAspect aspect,
-    const QHash< QskAspect, QVariant >& hints, QskAspect* resolvedAspect )
+template< typename Map >
+static inline typename Map::const_iterator qskResolvedHint(
+    QskAspect aspect, const Map& hints, QskAspect* resolvedAspect )
 {
     auto a = aspect;
 
@@ -23,7 +92,7 @@ inline const QVariant* qskResolvedHint( QskAspect aspect,
             if ( resolvedAspect )
                 *resolvedAspect = aspect;
 
-            return &it.value();
+            return it;
         }
 
 #if 1
@@ -65,7 +134,7 @@ inline const QVariant* qskResolvedHint( QskAspect aspect,
             continue;
         }
 
-        return nullptr;
+        return hints.constEnd();
     }
 }
 
@@ -91,12 +160,13 @@ QskSkinHintTable::QskSkinHintTable( const QskSkinHintTable& other )
             of copy/assignment operators much easier ( needed in QskSkinTransition ) we prefer
             using the Qt container over the STL counterparts.
          */
-        m_hints = new QHash< QskAspect, QVariant >( *other.m_hints );
+        m_hints = new Storage( *other.m_hints );
     }
 }
 
 QskSkinHintTable::~QskSkinHintTable()
 {
+    delete m_cache;
     delete m_hints;
 }
 
@@ -105,22 +175,80 @@ QskSkinHintTable& QskSkinHintTable::operator=( const QskSkinHintTable& other )
     m_animatorCount = ( other.m_animatorCount );
     m_states = other.m_states;
 
+    invalidateCache();
+
     delete m_hints;
     m_hints = nullptr;
 
     if ( other.m_hints )
-        m_hints = new QHash< QskAspect, QVariant >( *other.m_hints );
+        m_hints = new Storage( *other.m_hints );
 
     return *this;
 }
 
-const QHash< QskAspect, QVariant >& QskSkinHintTable::hints() const
+const QskSkinHintTable::HintMap& QskSkinHintTable::hints() const
 {
-    if ( m_hints )
-        return *m_hints;
+    if ( m_hints == nullptr )
+    {
+        static HintMap dummyHints;
+        return dummyHints;
+    }
+
+#if defined( QSK_FLAT_SKIN_HINTS )
+    /*
+        The QHash is only needed for iterating over all hints
+        ( QskSkinTransition, QskSkinIO ) and is built on request
+     */
+    auto cache = this->cache();
+
+    if ( !cache->hasHintMap )
+    {
+        cache->hintMap.reserve( m_hints->size() );
+
+        for ( auto it = m_hints->constBegin(); it != m_hints->constEnd(); ++it )
+            cache->hintMap.insert( it.key(), it.value() );
+
+        cache->hasHintMap = true;
+    }
+
+    return cache->hintMap;
+#else
+    return *m_hints;
+#endif
+}
+
+const QVariant& QskSkinHintTable::hint( QskAspect aspect ) const
+{
+    if ( m_hints != nullptr )
+    {
+        const auto it = m_hints->constFind( aspect );
+        if ( it != m_hints->constEnd() )
+        {
+#if defined( QSK_FLAT_SKIN_HINTS )
+            auto& value = cache()->hints[ aspect ];
+            value = it.value();
+
+            return value;
+#else
+            return it.value();
+#endif
+        }
+    }
+
+    return qskInvalidHint;
+}
+
+bool QskSkinHintTable::hasHint( QskAspect aspect ) const
+{
+    return m_hints && m_hints->contains( aspect );
+}
+
+bool QskSkinHintTable::isSharedWith( const QskSkinHintTable& other ) const
+{
+    if ( m_hints == nullptr || other.m_hints == nullptr )
+        return m_hints == other.m_hints;
 
-    static QHash< QskAspect, QVariant > dummyHints;
-    return dummyHints;
+    return m_hints->isSharedWith( *other.m_hints );
 }
 
 #define QSK_ASSERT_COUNTER( x ) Q_ASSERT( x < std::numeric_limits< decltype( x ) >::max() )
@@ -128,12 +256,20 @@ const QHash< QskAspect, QVariant >& QskSkinHintTable::hints() const
 bool QskSkinHintTable::setHint( QskAspect aspect, const QVariant& skinHint )
 {
     if ( m_hints == nullptr )
-        m_hints = new QHash< QskAspect, QVariant >();
+        m_hints = new Storage();
+
+    /*
+        Non const accessors detach m_hints, when it is shared with
+        another table ( f.e in QskSkinTransition ). Then the cached pointers
+        would refer to the values of the other table. So we use the const API
+        for the lookups and invalidate the cache, whenever modifying m_hints.
+     */
 
-    auto it = m_hints->find( aspect );
-    if ( it == m_hints->end() )
+    const auto it = m_hints->constFind( aspect );
+    if ( it == m_hints->constEnd() )
     {
         m_hints->insert( aspect, skinHint );
+        invalidateCache();
 
         if ( aspect.isAnimator() )
         {
@@ -148,7 +284,9 @@ bool QskSkinHintTable::setHint( QskAspect aspect, const QVariant& skinHint )
 
     if ( it.value() != skinHint )
     {
-        it.value() = skinHint;
+        m_hints->insert( aspect, skinHint );
+        invalidateCache();
+
         return true;
     }
 
@@ -159,37 +297,37 @@ bool QskSkinHintTable::setHint( QskAspect aspect, const QVariant& skinHint )
 
 bool QskSkinHintTable::removeHint( QskAspect aspect )
 {
-    if ( m_hints == nullptr )
+    if ( m_hints == nullptr || !m_hints->contains( aspect ) )
         return false;
 
-    const bool erased = m_hints->remove( aspect );
+    m_hints->remove( aspect );
+    invalidateCache();
 
-    if ( erased )
-    {
-        if ( aspect.isAnimator() )
-            m_animatorCount--;
+    if ( aspect.isAnimator() )
+        m_animatorCount--;
 
-        // how to clear m_states ? TODO ...
+    // how to clear m_states ? TODO ...
 
-        if ( m_hints->empty() )
-        {
-            delete m_hints;
-            m_hints = nullptr;
-        }
+    if ( m_hints->empty() )
+    {
+        delete m_hints;
+        m_hints = nullptr;
     }
 
-    return erased;
+    return true;
 }
 
 QVariant QskSkinHintTable::takeHint( QskAspect aspect )
 {
     if ( m_hints )
     {
-        auto it = m_hints->find( aspect );
-        if ( it != m_hints->end() )
+        const auto it = m_hints->constFind( aspect );
+        if ( it != m_hints->constEnd() )
         {
-            const auto value = it.value();
-            m_hints->erase( it );
+            const QVariant value = it.value();
+
+            m_hints->remove( aspect );
+            invalidateCache();
 
             if ( aspect.isAnimator() )
                 m_animatorCount--;
@@ -211,6 +349,8 @@ QVariant QskSkinHintTable::takeHint( QskAspect aspect )
 
 void QskSkinHintTable::clear()
 {
+    invalidateCache();
+
     delete m_hints;
     m_hints = nullptr;
 
@@ -218,23 +358,86 @@ void QskSkinHintTable::clear()
     m_states = QskAspect::NoState;
 }
 
+QskSkinHintTable::Cache* QskSkinHintTable::cache() const
+{
+    if ( m_cache == nullptr )
+        m_cache = new Cache();
+
+    return m_cache;
+}
+
+void QskSkinHintTable::invalidateCache()
+{
+    delete m_cache;
+    m_cache = nullptr;
+}
+
+const QskSkinHintTable::ResolvedHint& QskSkinHintTable::resolved( QskAspect aspect ) const
+{
+    Q_ASSERT( m_hints );
+
+    auto& resolvedHints = cache()->resolvedHints;
+
+    {
+        auto it = resolvedHints.find( aspect );
+        if ( it != resolvedHints.end() )
+        {
+            m_cacheHits++;
+
+#if defined( QSK_FLAT_SKIN_HINTS )
+            return it->second;
+#else
+            return it.value();
+#endif
+        }
+    }
+
+    m_cacheMisses++;
+
+#if defined( QSK_FLAT_SKIN_HINTS )
+    auto& entry = resolvedHints[ aspect ];
+
+    const auto it = qskResolvedHint( aspect, *m_hints, &entry.aspect );
+    if ( it != m_hints->constEnd() )
+    {
+        entry.value = it.value();
+        entry.hint = &entry.value;
+    }
+
+    return entry;
+#else
+    ResolvedHint entry;
+
+    const auto it = qskResolvedHint( aspect, *m_hints, &entry.aspect );
+    if ( it != m_hints->constEnd() )
+        entry.hint = &it.value();
+
+    return *resolvedHints.insert( aspect, entry );
+#endif
+}
+
 const QVariant* QskSkinHintTable::resolvedHint(
     QskAspect aspect, QskAspect* resolvedAspect ) const
 {
     if ( m_hints != nullptr )
-        return qskResolvedHint( aspect & m_states, *m_hints, resolvedAspect );
+    {
+        const auto& entry = resolved( aspect & m_states );
+
+        if ( entry.hint && resolvedAspect )
+            *resolvedAspect = entry.aspect;
+
+        return entry.hint;
+    }
 
     return nullptr;
 }
 
 QskAspect QskSkinHintTable::resolvedAspect( QskAspect aspect ) const
 {
-    QskAspect a;
-
     if ( m_hints != nullptr )
-        qskResolvedHint( aspect & m_states, *m_hints, &a );
+        return resolved( aspect & m_states ).aspect;
 
-    return a;
+    return QskAspect();
 }
 
 QskAspect QskSkinHintTable::resolvedAnimator(
@@ -16,6 +16,8 @@ class QskAnimationHint;
 class QSK_EXPORT QskSkinHintTable
 {
   public:
+    using HintMap = QHash< QskAspect, QVariant >;
+
     QskSkinHintTable();
     QskSkinHintTable( const QskSkinHintTable& );
     ~QskSkinHintTable();
@@ -26,6 +28,8 @@ class QSK_EXPORT QskSkinHintTable
     QskAnimationHint animation( QskAspect ) const;
 
     bool setHint( QskAspect, const QVariant& );
+
+    // the reference is valid until the table gets modified
     const QVariant& hint( QskAspect ) const;
 
     template< typename T > bool setHint( QskAspect, const T& );
@@ -35,8 +39,9 @@ class QSK_EXPORT QskSkinHintTable
     QVariant takeHint( QskAspect );
 
     bool hasHint( QskAspect ) const;
+    bool isSharedWith( const QskSkinHintTable& ) const;
 
-    const QHash< QskAspect, QVariant >& hints() const;
+    const HintMap& hints() const;
 
     bool hasAnimators() const;
     bool hasHints() const;
@@ -55,11 +60,30 @@ class QSK_EXPORT QskSkinHintTable
 
     bool isResolutionMatching( QskAspect, QskAspect ) const;
 
+    quint64 cacheHits() const;
+    quint64 cacheMisses() const;
+    void resetCacheStatistics() const;
+
   private:
+    /*
+        The storage of the hints is an implementation detail, that depends
+        on the build option ENABLE_FLAT_SKIN_HINTS: see QskSkinHintTable.cpp
+     */
+    class Storage;
+    class Cache;
+    struct ResolvedHint;
 
-    static const QVariant invalidHint;
+    const ResolvedHint& resolved( QskAspect ) const;
+    Cache* cache() const;
+    void invalidateCache();
 
-    QHash< QskAspect, QVariant >* m_hints = nullptr;
+    Storage* m_hints = nullptr;
+
+    // results of lookups, invalidated whenever m_hints is modified
+    mutable Cache* m_cache = nullptr;
+
+    mutable quint64 m_cacheHits = 0;
+    mutable quint64 m_cacheMisses = 0;
 
     unsigned short m_animatorCount = 0;
     QskAspect::States m_states;
@@ -75,26 +99,24 @@ inline QskAspect::States QskSkinHintTable::states() const
     return m_states;
 }
 
-inline bool QskSkinHintTable::hasAnimators() const
+inline quint64 QskSkinHintTable::cacheHits() const
 {
-    return m_animatorCount > 0;
+    return m_cacheHits;
+}
+
+inline quint64 QskSkinHintTable::cacheMisses() const
+{
+    return m_cacheMisses;
 }
 
-inline bool QskSkinHintTable::hasHint( QskAspect aspect ) const
+inline void QskSkinHintTable::resetCacheStatistics() const
 {
-    return m_hints && m_hints->contains( aspect );
+    m_cacheHits = m_cacheMisses = 0;
 }
 
-inline const QVariant& QskSkinHintTable::hint( QskAspect aspect ) const
+inline bool QskSkinHintTable::hasAnimators() const
 {
-    if ( m_hints != nullptr )
-    {
-        auto it = m_hints->constFind( aspect );
-        if ( it != m_hints->constEnd() )
-            return it.value();
-    }
-
-    return invalidHint;
+    return m_animatorCount > 0;
 }
 
 template< typename T >
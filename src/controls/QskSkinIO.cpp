@@ -0,0 +1,925 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskSkinIO.h"
+#include "QskSkin.h"
+#include "QskSkinHintTable.h"
+
+#include "QskAnimationHint.h"
+#include "QskArcMetrics.h"
+#include "QskBoxBorderColors.h"
+#include "QskBoxBorderMetrics.h"
+#include "QskBoxShapeMetrics.h"
+#include "QskColorFilter.h"
+#include "QskFontRole.h"
+#include "QskGradient.h"
+#include "QskGradientDirection.h"
+#include "QskGraduationMetrics.h"
+#include "QskGraphic.h"
+#include "QskGraphicIO.h"
+#include "QskIntervalF.h"
+#include "QskMargins.h"
+#include "QskPlacementPolicy.h"
+#include "QskShadowMetrics.h"
+#include "QskSizePolicy.h"
+#include "QskStippleMetrics.h"
+#include "QskTextColors.h"
+#include "QskTextOptions.h"
+
+#include <qbuffer.h>
+#include <qdatastream.h>
+#include <qfile.h>
+#include <qfont.h>
+#include <qhash.h>
+#include <qsysinfo.h>
+
+#include <cstring>
+#include <type_traits>
+
+static const char qskMagicNumber[] = "QSKS";
+
+/*
+    Increase qskFormatVersion, whenever the layout
+    of the snapshot changes.
+ */
+static const quint32 qskFormatVersion = 1;
+
+namespace
+{
+    enum ValueType : quint8
+    {
+        InvalidValue,
+
+        BuiltinValue, // QVariant streaming operators
+        IntValue, // enums and flags
+
+        AnimationHintValue,
+        ArcMetricsValue,
+        BoxBorderMetricsValue,
+        BoxShapeMetricsValue,
+        FontRoleValue,
+        GraduationMetricsValue,
+        IntervalValue,
+        MarginsValue,
+        PlacementPolicyValue,
+        ShadowMetricsValue,
+        SizePolicyValue,
+        TextOptionsValue,
+
+        BoxBorderColorsValue,
+        GradientValue,
+        StippleMetricsValue,
+        TextColorsValue,
+
+        GraphicValue // symbols
+    };
+}
+
+/*
+    Most of the QSkinny value types are trivially copyable and
+    can be written as they are - the snapshot is bound to the
+    byte order and qreal type anyway.
+ */
+template< typename T >
+static inline void qskWriteRaw( QDataStream& s, const T& value )
+{
+    static_assert( std::is_trivially_copyable< T >::value,
+        "Value can't be written raw" );
+
+    s.writeRawData( reinterpret_cast< const char* >( &value ), sizeof( T ) );
+}
+
+template< typename T >
+static inline bool qskReadRaw( QDataStream& s, T& value )
+{
+    static_assert( std::is_trivially_copyable< T >::value,
+        "Value can't be read raw" );
+
+    const int size = sizeof( T );
+    return s.readRawData( reinterpret_cast< char* >( &value ), size ) == size;
+}
+
+template< typename T >
+static inline void qskWriteRawValue( QDataStream& s, const QVariant& value )
+{
+    qskWriteRaw( s, value.value< T >() );
+}
+
+template< typename T >
+static inline QVariant qskReadRawValue( QDataStream& s )
+{
+    T value;
+    if ( qskReadRaw( s, value ) )
+        return QVariant::fromValue( value );
+
+    return QVariant();
+}
+
+static void qskWriteGradient( QDataStream& s, const QskGradient& gradient )
+{
+    s << static_cast< quint8 >( gradient.type() )
+        << static_cast< quint8 >( gradient.spreadMode() )
+        << static_cast< quint8 >( gradient.stretchMode() );
+
+    switch( gradient.type() )
+    {
+        case QskGradient::Linear:
+        {
+            const auto dir = gradient.linearDirection();
+            s << dir.x1() << dir.y1() << dir.x2() << dir.y2();
+            break;
+        }
+        case QskGradient::Radial:
+        {
+            const auto dir = gradient.radialDirection();
+            s << dir.x() << dir.y() << dir.radiusX() << dir.radiusY();
+            break;
+        }
+        case QskGradient::Conic:
+        {
+            const auto dir = gradient.conicDirection();
+            s << dir.x() << dir.y() << dir.startAngle()
+                << dir.spanAngle() << dir.aspectRatio();
+            break;
+        }
+        default:
+            break;
+    }
+
+    const auto& stops = gradient.stops();
+
+    s << static_cast< quint32 >( stops.size() );
+    for ( const auto& stop : stops )
+        s << stop.position() << stop.color();
+}
+
+static QskGradient qskReadGradient( QDataStream& s )
+{
+    quint8 type, spreadMode, stretchMode;
+    s >> type >> spreadMode >> stretchMode;
+
+    QskGradient gradient;
+
+    switch( type )
+    {
+        case QskGradient::Linear:
+        {
+            qreal x1, y1, x2, y2;
+            s >> x1 >> y1 >> x2 >> y2;
+
+            gradient.setLinearDirection( x1, y1, x2, y2 );
+            break;
+        }
+        case QskGradient::Radial:
+        {
+            qreal x, y, radiusX, radiusY;
+            s >> x >> y >> radiusX >> radiusY;
+
+            gradient.setRadialDirection( x, y, radiusX, radiusY );
+            break;
+        }
+        case QskGradient::Conic:
+        {
+            qreal x, y, startAngle, spanAngle, aspectRatio;
+            s >> x >> y >> startAngle >> spanAngle >> aspectRatio;
+
+            gradient.setConicDirection(
+                QskConicDirection( x, y, startAngle, spanAngle, aspectRatio ) );
+            break;
+        }
+        default:
+            break;
+    }
+
+    gradient.setSpreadMode( static_cast< QskGradient::SpreadMode >( spreadMode ) );
+    gradient.setStretchMode( static_cast< QskGradient::StretchMode >( stretchMode ) );
+
+    quint32 count;
+    s >> count;
+
+    QskGradientStops stops;
+    stops.reserve( count );
+
+    for ( quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++ )
+    {
+        qreal position;
+        QColor color;
+
+        s >> position >> color;
+        stops += QskGradientStop( position, color );
+    }
+
+    gradient.setStops( stops );
+
+    return gradient;
+}
+
+static void qskWriteColorFilter( QDataStream& s, const QskColorFilter& filter )
+{
+    const auto& substitutions = filter.substitutions();
+
+    s << static_cast< quint32 >( filter.mask() );
+    s << static_cast< quint32 >( substitutions.size() );
+
+    for ( const auto& substitution : substitutions )
+    {
+        s << static_cast< quint32 >( substitution.first )
+            << static_cast< quint32 >( substitution.second );
+    }
+}
+
+static QskColorFilter qskReadColorFilter( QDataStream& s )
+{
+    quint32 mask, count;
+    s >> mask >> count;
+
+    QskColorFilter filter( mask );
+
+    for ( quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++ )
+    {
+        quint32 from, to;
+        s >> from >> to;
+
+        filter.addColorSubstitution( from, to );
+    }
+
+    return filter;
+}
+
+static bool qskWriteGraphic( QDataStream& s, const QskGraphic& graphic )
+{
+    /*
+        Version2 is a flat layout, where the commands are not decoded
+        before the graphic is rendered for the first time.
+     */
+    QByteArray qvg;
+
+    QBuffer buffer( &qvg );
+    buffer.open( QIODevice::WriteOnly );
+
+    if ( !QskGraphicIO::write( graphic, &buffer, QskGraphicIO::Version2 ) )
+        return false;
+
+    s << qvg;
+    return true;
+}
+
+static QskGraphic qskReadGraphic( QDataStream& s )
+{
+    QByteArray qvg;
+    s >> qvg;
+
+    return QskGraphicIO::read( qvg );
+}
+
+static ValueType qskValueType( const QVariant& value )
+{
+    const auto typeId = value.userType();
+
+    if ( typeId < QMetaType::User )
+        return BuiltinValue;
+
+    if ( typeId == qMetaTypeId< QskAnimationHint >() )
+        return AnimationHintValue;
+
+    if ( typeId == qMetaTypeId< QskArcMetrics >() )
+        return ArcMetricsValue;
+
+    if ( typeId == qMetaTypeId< QskBoxBorderMetrics >() )
+        return BoxBorderMetricsValue;
+
+    if ( typeId == qMetaTypeId< QskBoxShapeMetrics >() )
+        return BoxShapeMetricsValue;
+
+    if ( typeId == qMetaTypeId< QskFontRole >() )
+        return FontRoleValue;
+
+    if ( typeId == qMetaTypeId< QskGraduationMetrics >() )
+        return GraduationMetricsValue;
+
+    if ( typeId == qMetaTypeId< QskIntervalF >() )
+        return IntervalValue;
+
+    if ( typeId == qMetaTypeId< QskMargins >() )
+        return MarginsValue;
+
+    if ( typeId == qMetaTypeId< QskPlacementPolicy >() )
+        return PlacementPolicyValue;
+
+    if ( typeId == qMetaTypeId< QskShadowMetrics >() )
+        return ShadowMetricsValue;
+
+    if ( typeId == qMetaTypeId< QskSizePolicy >() )
+        return SizePolicyValue;
+
+    if ( typeId == qMetaTypeId< QskTextOptions >() )
+        return TextOptionsValue;
+
+    if ( typeId == qMetaTypeId< QskBoxBorderColors >() )
+        return BoxBorderColorsValue;
+
+    if ( typeId == qMetaTypeId< QskGradient >() )
+        return GradientValue;
+
+    if ( typeId == qMetaTypeId< QskStippleMetrics >() )
+        return StippleMetricsValue;
+
+    if ( typeId == qMetaTypeId< QskTextColors >() )
+        return TextColorsValue;
+
+    if ( typeId == qMetaTypeId< QskGraphic >() )
+        return GraphicValue;
+
+    if ( value.canConvert< int >() )
+        return IntValue;
+
+    return InvalidValue;
+}
+
+static bool qskWriteValue( QDataStream& s, const QVariant& value )
+{
+    const auto valueType = qskValueType( value );
+
+    s << static_cast< quint8 >( valueType );
+
+    switch( valueType )
+    {
+        case BuiltinValue:
+        {
+            s << value;
+            break;
+        }
+        case IntValue:
+        {
+            s << static_cast< qint32 >( value.value< int >() );
+            s << QByteArray( value.typeName() );
+            break;
+        }
+        case AnimationHintValue:
+        {
+            qskWriteRawValue< QskAnimationHint >( s, value );
+            break;
+        }
+        case ArcMetricsValue:
+        {
+            qskWriteRawValue< QskArcMetrics >( s, value );
+            break;
+        }
+        case BoxBorderMetricsValue:
+        {
+            qskWriteRawValue< QskBoxBorderMetrics >( s, value );
+            break;
+        }
+        case BoxShapeMetricsValue:
+        {
+            qskWriteRawValue< QskBoxShapeMetrics >( s, value );
+            break;
+        }
+        case FontRoleValue:
+        {
+            qskWriteRawValue< QskFontRole >( s, value );
+            break;
+        }
+        case GraduationMetricsValue:
+        {
+            qskWriteRawValue< QskGraduationMetrics >( s, value );
+            break;
+        }
+        case IntervalValue:
+        {
+            qskWriteRawValue< QskIntervalF >( s, value );
+            break;
+        }
+        case MarginsValue:
+        {
+            qskWriteRawValue< QskMargins >( s, value );
+            break;
+        }
+        case PlacementPolicyValue:
+        {
+            qskWriteRawValue< QskPlacementPolicy >( s, value );
+            break;
+        }
+        case ShadowMetricsValue:
+        {
+            qskWriteRawValue< QskShadowMetrics >( s, value );
+            break;
+        }
+        case SizePolicyValue:
+        {
+            qskWriteRawValue< QskSizePolicy >( s, value );
+            break;
+        }
+        case TextOptionsValue:
+        {
+            qskWriteRawValue< QskTextOptions >( s, value );
+            break;
+        }
+        case BoxBorderColorsValue:
+        {
+            const auto colors = value.value< QskBoxBorderColors >();
+
+            qskWriteGradient( s, colors.left() );
+            qskWriteGradient( s, colors.top() );
+            qskWriteGradient( s, colors.right() );
+            qskWriteGradient( s, colors.bottom() );
+
+            break;
+        }
+        case GradientValue:
+        {
+            qskWriteGradient( s, value.value< QskGradient >() );
+            break;
+        }
+        case StippleMetricsValue:
+        {
+            const auto metrics = value.value< QskStippleMetrics >();
+            s << metrics.offset() << metrics.pattern();
+
+            break;
+        }
+        case TextColorsValue:
+        {
+            const auto colors = value.value< QskTextColors >();
+            s << colors.textColor() << colors.styleColor() << colors.linkColor();
+
+            break;
+        }
+        case GraphicValue:
+        {
+            if ( !qskWriteGraphic( s, value.value< QskGraphic >() ) )
+            {
+                qWarning( "QskSkinIO::write: can't write graphic" );
+                return false;
+            }
+
+            break;
+        }
+        default:
+        {
+            qWarning( "QskSkinIO::write: can't write values of type %s",
+                value.typeName() );
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static QVariant qskReadValue( QDataStream& s )
+{
+    quint8 valueType;
+    s >> valueType;
+
+    switch( valueType )
+    {
+        case BuiltinValue:
+        {
+            QVariant value;
+            s >> value;
+
+            return value;
+        }
+        case IntValue:
+        {
+            qint32 intValue;
+            QByteArray typeName;
+
+            s >> intValue >> typeName;
+
+            QVariant value( static_cast< int >( intValue ) );
+
+            // trying to restore the original enum/flags type
+
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+            const auto metaType = QMetaType::fromName( typeName );
+            if ( metaType.isValid() )
+            {
+                auto v = value;
+                if ( v.convert( metaType ) )
+                    value = v;
+            }
+#else
+            const auto typeId = QMetaType::type( typeName.constData() );
+            if ( typeId != QMetaType::UnknownType )
+            {
+                auto v = value;
+                if ( v.convert( typeId ) )
+                    value = v;
+            }
+#endif
+            return value;
+        }
+        case AnimationHintValue:
+            return qskReadRawValue< QskAnimationHint >( s );
+
+        case ArcMetricsValue:
+            return qskReadRawValue< QskArcMetrics >( s );
+
+        case BoxBorderMetricsValue:
+            return qskReadRawValue< QskBoxBorderMetrics >( s );
+
+        case BoxShapeMetricsValue:
+            return qskReadRawValue< QskBoxShapeMetrics >( s );
+
+        case FontRoleValue:
+            return qskReadRawValue< QskFontRole >( s );
+
+        case GraduationMetricsValue:
+            return qskReadRawValue< QskGraduationMetrics >( s );
+
+        case IntervalValue:
+            return qskReadRawValue< QskIntervalF >( s );
+
+        case MarginsValue:
+            return qskReadRawValue< QskMargins >( s );
+
+        case PlacementPolicyValue:
+            return qskReadRawValue< QskPlacementPolicy >( s );
+
+        case ShadowMetricsValue:
+            return qskReadRawValue< QskShadowMetrics >( s );
+
+        case SizePolicyValue:
+            return qskReadRawValue< QskSizePolicy >( s );
+
+        case TextOptionsValue:
+            return qskReadRawValue< QskTextOptions >( s );
+
+        case BoxBorderColorsValue:
+        {
+            const auto left = qskReadGradient( s );
+            const auto top = qskReadGradient( s );
+            const auto right = qskReadGradient( s );
+            const auto bottom = qskReadGradient( s );
+
+            return QVariant::fromValue( QskBoxBorderColors( left, top, right, bottom ) );
+        }
+        case GradientValue:
+        {
+            return QVariant::fromValue( qskReadGradient( s ) );
+        }
+        case StippleMetricsValue:
+        {
+            qreal offset;
+            QVector< qreal > pattern;
+
+            s >> offset >> pattern;
+
+            return QVariant::fromValue( QskStippleMetrics( pattern, offset ) );
+        }
+        case TextColorsValue:
+        {
+            QColor textColor, styleColor, linkColor;
+            s >> textColor >> styleColor >> linkColor;
+
+            return QVariant::fromValue( QskTextColors( textColor, styleColor, linkColor ) );
+        }
+        case GraphicValue:
+        {
+            return QVariant::fromValue( qskReadGraphic( s ) );
+        }
+        default:
+        {
+            s.setStatus( QDataStream::ReadCorruptData );
+            return QVariant();
+        }
+    }
+}
+
+static void qskWriteAspect( QDataStream& s, QskAspect aspect, quint16 subControlIndex )
+{
+    s << subControlIndex
+        << static_cast< quint8 >( aspect.section() )
+        << static_cast< quint8 >( aspect.type() )
+        << static_cast< quint8 >( aspect.primitive() )
+        << static_cast< quint8 >( aspect.variation() )
+        << static_cast< quint16 >( aspect.states() )
+        << aspect.isAnimator();
+}
+
+static QskAspect qskReadAspect( QDataStream& s,
+    const QVector< QskAspect::Subcontrol >& subControls )
+{
+    quint16 subControlIndex, states;
+    quint8 section, type, primitive, variation;
+    bool isAnimator;
+
+    s >> subControlIndex >> section >> type
+        >> primitive >> variation >> states >> isAnimator;
+
+    if ( subControlIndex >= subControls.size() )
+    {
+        s.setStatus( QDataStream::ReadCorruptData );
+        return QskAspect();
+    }
+
+    QskAspect aspect( subControls[ subControlIndex ] );
+
+    aspect.setSection( static_cast< QskAspect::Section >( section ) );
+    aspect.setPrimitive( static_cast< QskAspect::Type >( type ),
+        static_cast< QskAspect::Primitive >( primitive ) );
+    aspect.setVariation( static_cast< QskAspect::Variation >( variation ) );
+    aspect.setStates( QskAspect::States( static_cast< QskAspect::State >( states ) ) );
+    aspect.setAnimator( isAnimator );
+
+    return aspect;
+}
+
+static void qskWriteHeader( QDataStream& s, const QskSkin* skin )
+{
+    s.writeRawData( qskMagicNumber, 4 );
+
+    s << qskFormatVersion
+        << static_cast< quint32 >( QT_VERSION )
+        << static_cast< quint32 >( QSK_VERSION )
+        << static_cast< quint8 >( sizeof( qreal ) )
+        << static_cast< quint8 >( QSysInfo::ByteOrder );
+
+    s << QByteArray( skin->metaObject()->className() );
+    s << static_cast< qint32 >( skin->colorScheme() );
+}
+
+static bool qskReadHeader( QDataStream& s,
+    const QskSkin* skin, QskSkin::ColorScheme& colorScheme )
+{
+    char magicNumber[ 4 ];
+    if ( s.readRawData( magicNumber, 4 ) != 4
+        || memcmp( magicNumber, qskMagicNumber, 4 ) != 0 )
+    {
+        qWarning( "QskSkinIO::read: bad magic number" );
+        return false;
+    }
+
+    quint32 formatVersion, qtVersion, qskVersion;
+    quint8 realSize, byteOrder;
+
+    s >> formatVersion >> qtVersion >> qskVersion >> realSize >> byteOrder;
+
+    if ( formatVersion != qskFormatVersion || qtVersion != QT_VERSION
+        || qskVersion != QSK_VERSION || realSize != sizeof( qreal )
+        || byteOrder != QSysInfo::ByteOrder )
+    {
+        // outdated snapshot
+        return false;
+    }
+
+    QByteArray className;
+    qint32 scheme;
+
+    s >> className >> scheme;
+
+    if ( className != skin->metaObject()->className() )
+        return false;
+
+    colorScheme = static_cast< QskSkin::ColorScheme >( scheme );
+    return s.status() == QDataStream::Ok;
+}
+
+static bool qskReadSkin( QDataStream& s, QskSkin* skin )
+{
+    auto colorScheme = QskSkin::UnknownScheme;
+    if ( !qskReadHeader( s, skin, colorScheme ) )
+        return false;
+
+    /*
+        The values of the subcontrols depend on the order of their
+        registration. So we map the names from the snapshot to the
+        subcontrols of the running application.
+     */
+    QVector< QskAspect::Subcontrol > subControls;
+    {
+        const auto names = QskAspect::subControlNames();
+
+        QHash< QByteArray, QskAspect::Subcontrol > subControlMap;
+        subControlMap.reserve( names.size() );
+
+        for ( int i = 0; i < names.size(); i++ )
+            subControlMap.insert( names[ i ], static_cast< QskAspect::Subcontrol >( i + 1 ) );
+
+        quint32 count;
+        s >> count;
+
+        subControls.reserve( count + 1 );
+        subControls += QskAspect::NoSubcontrol;
+
+        for ( quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++ )
+        {
+            QByteArray name;
+            s >> name;
+
+            const auto it = subControlMap.constFind( name );
+            if ( it == subControlMap.constEnd() )
+            {
+                // unknown subcontrol
+                return false;
+            }
+
+            subControls += it.value();
+        }
+    }
+
+    QskSkinHintTable hintTable;
+    {
+        quint32 count;
+        s >> count;
+
+        for ( quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++ )
+        {
+            const auto aspect = qskReadAspect( s, subControls );
+            const auto value = qskReadValue( s );
+
+            hintTable.setHint( aspect, value );
+        }
+    }
+
+    QHash< QskFontRole, QFont > fonts;
+    {
+        quint32 count;
+        s >> count;
+
+        for ( quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++ )
+        {
+            QskFontRole fontRole;
+            if ( !qskReadRaw( s, fontRole ) )
+                return false;
+
+            QFont font;
+            s >> font;
+
+            fonts.insert( fontRole, font );
+        }
+    }
+
+    QHash< int, QskColorFilter > graphicFilters;
+    {
+        quint32 count;
+        s >> count;
+
+        for ( quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++ )
+        {
+            qint32 graphicRole;
+            s >> graphicRole;
+
+            graphicFilters.insert( graphicRole, qskReadColorFilter( s ) );
+        }
+    }
+
+    if ( s.status() != QDataStream::Ok )
+    {
+        qWarning( "QskSkinIO::read: corrupted data" );
+        return false;
+    }
+
+    skin->restoreHints( colorScheme, hintTable, fonts, graphicFilters );
+    return true;
+}
+
+static bool qskWriteSkin( QDataStream& s, const QskSkin* skin )
+{
+    qskWriteHeader( s, skin );
+
+    const auto& hints = skin->hintTable().hints();
+
+    QHash< QskAspect::Subcontrol, quint16 > subControlIndexes;
+    {
+        QVector< QByteArray > names;
+
+        for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+        {
+            const auto subControl = it.key().subControl();
+
+            if ( subControl != QskAspect::NoSubcontrol
+                && !subControlIndexes.contains( subControl ) )
+            {
+                names += QskAspect::subControlName( subControl );
+                subControlIndexes.insert( subControl, static_cast< quint16 >( names.size() ) );
+            }
+        }
+
+        s << static_cast< quint32 >( names.size() );
+        for ( const auto& name : std::as_const( names ) )
+            s << name;
+    }
+
+    s << static_cast< quint32 >( hints.size() );
+
+    for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+    {
+        const auto aspect = it.key();
+
+        qskWriteAspect( s, aspect, subControlIndexes.value( aspect.subControl(), 0 ) );
+
+        if ( !qskWriteValue( s, it.value() ) )
+            return false;
+    }
+
+    const auto& fonts = skin->fontTable();
+
+    s << static_cast< quint32 >( fonts.size() );
+
+    for ( auto it = fonts.constBegin(); it != fonts.constEnd(); ++it )
+    {
+        qskWriteRaw( s, it.key() );
+        s << it.value();
+    }
+
+    const auto& graphicFilters = skin->graphicFilters();
+
+    s << static_cast< quint32 >( graphicFilters.size() );
+
+    for ( auto it = graphicFilters.constBegin(); it != graphicFilters.constEnd(); ++it )
+    {
+        s << static_cast< qint32 >( it.key() );
+        qskWriteColorFilter( s, it.value() );
+    }
+
+    return s.status() == QDataStream::Ok;
+}
+
+bool QskSkinIO::read( QskSkin* skin, const QString& fileName )
+{
+    QFile file( fileName );
+    if ( file.open( QIODevice::ReadOnly ) == false )
+    {
+        qWarning( "QskSkinIO::read can't open %s", qPrintable( fileName ) );
+        return false;
+    }
+
+    /*
+        Mapping the file avoids copying the snapshot into a buffer
+        before decoding it
+     */
+    if ( const auto size = file.size() )
+    {
+        if ( auto mapped = file.map( 0, size ) )
+        {
+            const auto data = QByteArray::fromRawData(
+                reinterpret_cast< const char* >( mapped ), static_cast< int >( size ) );
+
+            const bool ok = read( skin, data );
+            file.unmap( mapped );
+
+            return ok;
+        }
+    }
+
+    return read( skin, &file );
+}
+
+bool QskSkinIO::read( QskSkin* skin, const QByteArray& data )
+{
+    QBuffer buffer;
+    buffer.setData( data );
+    buffer.open( QIODevice::ReadOnly );
+
+    return read( skin, &buffer );
+}
+
+bool QskSkinIO::read( QskSkin* skin, QIODevice* dev )
+{
+    if ( skin == nullptr || dev == nullptr )
+        return false;
+
+    QDataStream stream( dev );
+    return qskReadSkin( stream, skin );
+}
+
+bool QskSkinIO::write( const QskSkin* skin, const QString& fileName )
+{
+    QFile file( fileName );
+    if ( file.open( QIODevice::WriteOnly | QIODevice::Truncate ) == false )
+    {
+        qWarning( "QskSkinIO::write can't open %s", qPrintable( fileName ) );
+        return false;
+    }
+
+    if ( !write( skin, &file ) )
+    {
+        // no incomplete snapshots
+        file.remove();
+        return false;
+    }
+
+    return true;
+}
+
+bool QskSkinIO::write( const QskSkin* skin, QByteArray& data )
+{
+    QBuffer buffer( &data );
+    buffer.open( QIODevice::WriteOnly );
+
+    return write( skin, &buffer );
+}
+
+bool QskSkinIO::write( const QskSkin* skin, QIODevice* dev )
+{
+    if ( skin == nullptr || dev == nullptr )
+        return false;
+
+    QDataStream stream( dev );
+    return qskWriteSkin( stream, skin );
+}
@@ -0,0 +1,41 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_SKIN_IO_H
+#define QSK_SKIN_IO_H
+
+#include "QskGlobal.h"
+
+class QskSkin;
+class QString;
+class QIODevice;
+class QByteArray;
+
+/*
+    Snapshots of the hints, fonts and graphic filters of a fully
+    initialized skin. Restoring a snapshot replaces running
+    QskSkin::initHints(), what might be expensive for skins
+    doing color calculations like QskMaterial3Skin.
+
+    The format is binary and depends on the versions of Qt/QSkinny,
+    the type of the skin and the registered subcontrols. Snapshots, that
+    do not match are rejected and reading returns false.
+
+    Note, that a snapshot does not know about changes in the code of
+    the skin itself - it is up to the application to invalidate
+    snapshots f.e. when being updated.
+ */
+namespace QskSkinIO
+{
+    QSK_EXPORT bool read( QskSkin*, const QString& fileName );
+    QSK_EXPORT bool read( QskSkin*, const QByteArray& data );
+    QSK_EXPORT bool read( QskSkin*, QIODevice* );
+
+    QSK_EXPORT bool write( const QskSkin*, const QString& fileName );
+    QSK_EXPORT bool write( const QskSkin*, QByteArray& data );
+    QSK_EXPORT bool write( const QskSkin*, QIODevice* );
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "QskSkinFactory.h"
 #include "QskSkin.h"
 #include "QskSkinTransition.h"
+#include "QskSkinIO.h"
 #include "QskAnimationHint.h"
 
 #include <qdir.h>
@@ -382,8 +383,22 @@ class QskSkinManager::PrivateData
         delete loader;
     }
 
+    QString snapshotFile( const QString& skinName,
+        QskSkin::ColorScheme colorScheme ) const
+    {
+        if ( snapshotDirectory.isEmpty() )
+            return QString();
+
+        const auto name = QStringLiteral( "%1-%2.qsks" )
+            .arg( skinName.toLower() ).arg( static_cast< int >( colorScheme ) );
+
+        return QDir( snapshotDirectory ).absoluteFilePath( name );
+    }
+
   public:
     QStringList pluginPaths;
+    QString snapshotDirectory;
+
     FactoryMap factoryMap;
 
     QPointer< QskSkin > skin;
@@ -544,7 +559,19 @@ QskSkin* QskSkinManager::createSkin(
 #endif
             }
 
-            skin->setColorScheme( colorScheme );
+            const auto snapshotFile = m_data->snapshotFile( name, colorScheme );
+
+            bool isRestored = false;
+            if ( !snapshotFile.isEmpty() && QFile::exists( snapshotFile ) )
+                isRestored = QskSkinIO::read( skin, snapshotFile );
+
+            if ( !isRestored )
+            {
+                skin->setColorScheme( colorScheme );
+
+                if ( !snapshotFile.isEmpty() )
+                    QskSkinIO::write( skin, snapshotFile );
+            }
         }
     }
 
@@ -640,4 +667,17 @@ QskAnimationHint QskSkinManager::transitionHint() const
     return m_data->transitionHint;
 }
 
+void QskSkinManager::setSnapshotDirectory( const QString& path )
+{
+    m_data->snapshotDirectory = path;
+
+    if ( !path.isEmpty() )
+        QDir().mkpath( path );
+}
+
+QString QskSkinManager::snapshotDirectory() const
+{
+    return m_data->snapshotDirectory;
+}
+
 #include "moc_QskSkinManager.cpp"
@@ -54,6 +54,14 @@ class QSK_EXPORT QskSkinManager : public QObject
     void setTransitionHint( const QskAnimationHint& );
     QskAnimationHint transitionHint() const;
 
+    /*
+        When having a snapshot directory, createSkin() restores the hints
+        from a snapshot, instead of initializing them from scratch. Missing
+        or outdated snapshots are written after having initialized the skin.
+     */
+    void setSnapshotDirectory( const QString& );
+    QString snapshotDirectory() const;
+
   Q_SIGNALS:
     void skinChanged( QskSkin* );
     void colorSchemeChanged( QskSkin::ColorScheme );
@@ -55,7 +55,7 @@ static QskAspect::State qskSelectedSampleState( const QskControl* control )
 
 static bool qskHasHintTable( const QskSkin* skin, const QskSkinHintTable& hintTable )
 {
-    return skin->hintTable().hints().isSharedWith( hintTable.hints() );
+    return skin->hintTable().isSharedWith( hintTable );
 }
 
 static void qskSendStyleEventRecursive( QQuickItem* item )
@@ -68,51 +68,99 @@ static void qskSendStyleEventRecursive( QQuickItem* item )
         qskSendStyleEventRecursive( child );
 }
 
-static void qskAddCandidates( const QskSkinTransition::Type mask,
-    const QHash< QskAspect, QVariant >& hints, QSet< QskAspect >& candidates )
+static bool qskIsCandidate( const QskSkinTransition::Type mask, const QskAspect aspect )
 {
-    for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
-    {
-        const auto aspect = it.key().trunk();
+    if ( aspect.isAnimator() )
+        return false;
 
-        if ( aspect.isAnimator() )
-            continue;
+    switch( aspect.type() )
+    {
+        case QskAspect::NoType:
+        {
+            if ( aspect.primitive() == QskAspect::GraphicRole )
+                return mask & QskSkinTransition::Color;
 
-        bool isCandidate = false;
+            if ( aspect.primitive() == QskAspect::FontRole )
+                return mask & QskSkinTransition::Metric;
 
-        switch( aspect.type() )
+            break;
+        }
+        case QskAspect::Color:
         {
-            case QskAspect::NoType:
-            {
-                if ( aspect.primitive() == QskAspect::GraphicRole )
-                {
-                    isCandidate = mask & QskSkinTransition::Color;
-                }
-                else if ( aspect.primitive() == QskAspect::FontRole )
-                {
-                    isCandidate = mask & QskSkinTransition::Metric;
-                }
-                break;
-            }
-            case QskAspect::Color:
-            {
-                isCandidate = mask & QskSkinTransition::Color;
-                break;
-            }
-            case QskAspect::Metric:
-            {
-                isCandidate = mask & QskSkinTransition::Metric;
-                break;
-            }
+            return mask & QskSkinTransition::Color;
         }
+        case QskAspect::Metric:
+        {
+            return mask & QskSkinTransition::Metric;
+        }
+    }
+
+    return false;
+}
+
+static void qskAddChangedAspects( const QskSkinTransition::Type mask,
+    const QskSkinHintTable::HintMap& hints1, const QskSkinHintTable::HintMap& hints2,
+    QSet< QskAspect >& aspects )
+{
+    /*
+        A trunk aspect is of interest, when at least one of its
+        entries - with all combinations of sections, variations and states -
+        differs between the tables. When all of them are equal any
+        resolved value is equal too.
+     */
+    for ( auto it = hints1.constBegin(); it != hints1.constEnd(); ++it )
+    {
+        const auto aspect = it.key().trunk();
+
+        if ( aspects.contains( aspect ) || !qskIsCandidate( mask, aspect ) )
+            continue;
 
-        if ( isCandidate )
-            candidates += aspect;
+        const auto it2 = hints2.constFind( it.key() );
+        if ( ( it2 == hints2.constEnd() ) || ( it2.value() != it.value() ) )
+            aspects += aspect;
     }
 }
 
 namespace
 {
+    /*
+        The trunk aspects, that differ between the skins, indexed
+        by their subcontrol. It is built once for a transition and
+        then the controls only need to look up the entries of their
+        subcontrols instead of checking all candidates.
+     */
+    class AspectIndex
+    {
+      public:
+        void build( QskSkinTransition::Type mask,
+            const QskSkinHintTable& table1, const QskSkinHintTable& table2 )
+        {
+            QSet< QskAspect > aspects;
+
+            qskAddChangedAspects( mask, table1.hints(), table2.hints(), aspects );
+            qskAddChangedAspects( mask, table2.hints(), table1.hints(), aspects );
+
+            m_aspects.clear();
+
+            for ( const auto aspect : std::as_const( aspects ) )
+                m_aspects[ aspect.subControl() ] += aspect;
+        }
+
+        inline bool isEmpty() const
+        {
+            return m_aspects.isEmpty();
+        }
+
+        inline QVector< QskAspect > aspects(
+            QskAspect::Subcontrol subControl ) const
+        {
+            return m_aspects.value( subControl );
+        }
+
+      private:
+        QHash< int, QVector< QskAspect > > m_aspects;
+    };
+
     class UpdateInfo
     {
       public:
@@ -158,6 +206,7 @@ namespace
 
         void start();
         bool isRunning() const;
+        bool isEmpty() const;
 
         QVariant animatedHint( QskAspect ) const;
         QVariant animatedGraphicFilter( int graphicRole ) const;
@@ -170,15 +219,17 @@ namespace
             const QHash< QskFontRole, QFont >&, const QHash< QskFontRole, QFont >& );
 
         void addItemAspects( QQuickItem*,
-            const QskAnimationHint&, const QSet< QskAspect >&,
+            const QskAnimationHint&, const AspectIndex&,
             const QskSkinHintTable&, const QskSkinHintTable& );
 
         void update();
 
       private:
+        void addControlAspects( const QskControl*,
+            const QskAnimationHint&, const QVector< QskAspect >&,
+            const QskSkinHintTable&, const QskSkinHintTable& );
 
-        bool isControlAffected( const QskControl*,
-            const QVector< QskAspect::Subcontrol >&, QskAspect ) const;
+        bool isControlAffected( const QskControl*, QskAspect ) const;
 
         void addHint( const QskControl*,
             const QskAnimationHint&, QskAspect,
@@ -281,6 +332,12 @@ bool WindowAnimator::isRunning() const
     return false;
 }
 
+bool WindowAnimator::isEmpty() const
+{
+    return m_animatorMap.isEmpty() && m_graphicFilterAnimatorMap.isEmpty()
+        && m_fontSizeAnimatorMap.isEmpty();
+}
+
 inline QVariant WindowAnimator::animatedHint( QskAspect aspect ) const
 {
     auto it = m_animatorMap.constFind( aspect );
@@ -387,7 +444,7 @@ void WindowAnimator::addFontSizeAnimators(
 }
 
 void WindowAnimator::addItemAspects( QQuickItem* item,
-    const QskAnimationHint& animatorHint, const QSet< QskAspect >& candidates,
+    const QskAnimationHint& animatorHint, const AspectIndex& aspectIndex,
     const QskSkinHintTable& table1, const QskSkinHintTable& table2 )
 {
     if ( auto control = qskControlCast( ( const QQuickItem* )item ) )
@@ -395,44 +452,65 @@ void WindowAnimator::addItemAspects( QQuickItem* item,
         if ( control->isVisible() && control->isInitiallyPainted() &&
             qskHasHintTable( control->effectiveSkin(), table2 ) )
         {
-            const auto subControls = control->subControls();
+            addControlAspects( control, animatorHint,
+                aspectIndex.aspects( QskAspect::NoSubcontrol ), table1, table2 );
 
-            const auto& localTable = control->hintTable();
-
-            for ( auto aspect : candidates )
+            const auto subControls = control->subControls();
+            for ( const auto subControl : subControls )
             {
-                if ( isControlAffected( control, subControls, aspect ) )
+                if ( subControl != QskAspect::NoSubcontrol )
                 {
-                    aspect.setVariation( control->effectiveVariation() );
-                    aspect.setStates( control->skinStates() );
-                    aspect.setSection( control->section() );
-
-                    if ( !localTable.resolvedHint( aspect ) )
-                        addHint( control, animatorHint, aspect, table1, table2 );
-
-                    if ( auto state = qskSelectedSampleState( control ) )
-                    {
-                        aspect.addStates( state );
-                        if ( !localTable.resolvedHint( aspect ) )
-                            addHint( control, animatorHint, aspect, table1, table2 );
-                    }
+                    addControlAspects( control, animatorHint,
+                        aspectIndex.aspects( subControl ), table1, table2 );
                 }
             }
 
-#if 1
-            /*
-                As it is hard to identify which controls depend on the animated
-                graphic filters we schedule an initial update and let the
-                controls do the rest: see QskSkinnable::effectiveGraphicFilter
-             */
-            item->update();
-#endif
+            if ( !( m_graphicFilterAnimatorMap.isEmpty()
+                && m_fontSizeAnimatorMap.isEmpty() ) )
+            {
+                /*
+                    As it is hard to identify which controls depend on the animated
+                    graphic filters or fonts we schedule an initial update and let the
+                    controls do the rest: see QskSkinnable::effectiveGraphicFilter
+                 */
+                item->update();
+            }
         }
     }
 
     const auto children = item->childItems();
     for ( auto child : children )
-        addItemAspects( child, animatorHint, candidates, table1, table2 );
+        addItemAspects( child, animatorHint, aspectIndex, table1, table2 );
+}
+
+void WindowAnimator::addControlAspects( const QskControl* control,
+    const QskAnimationHint& animatorHint, const QVector< QskAspect >& aspects,
+    const QskSkinHintTable& table1, const QskSkinHintTable& table2 )
+{
+    if ( aspects.isEmpty() )
+        return;
+
+    const auto& localTable = control->hintTable();
+
+    for ( auto aspect : aspects )
+    {
+        if ( isControlAffected( control, aspect ) )
+        {
+            aspect.setVariation( control->effectiveVariation() );
+            aspect.setStates( control->skinStates() );
+            aspect.setSection( control->section() );
+
+            if ( !localTable.resolvedHint( aspect ) )
+                addHint( control, animatorHint, aspect, table1, table2 );
+
+            if ( auto state = qskSelectedSampleState( control ) )
+            {
+                aspect.addStates( state );
+                if ( !localTable.resolvedHint( aspect ) )
+                    addHint( control, animatorHint, aspect, table1, table2 );
+            }
+        }
+    }
 }
 
 void WindowAnimator::update()
@@ -509,8 +587,8 @@ void WindowAnimator::addHint( const QskControl* control,
     }
 }
 
-inline bool WindowAnimator::isControlAffected( const QskControl* control,
-    const QVector< QskAspect::Subcontrol >& subControls, const QskAspect aspect ) const
+inline bool WindowAnimator::isControlAffected(
+    const QskControl* control, const QskAspect aspect ) const
 {
     if ( !aspect.isMetric() )
     {
@@ -531,15 +609,6 @@ inline bool WindowAnimator::isControlAffected( const QskControl* control,
         return false;
     }
 
-    if ( subControl != QskAspect::NoSubcontrol )
-    {
-        if ( !subControls.contains( subControl ) )
-        {
-            // the control is not interested in the aspect
-            return false;
-        }
-    }
-
     return true;
 }
 
@@ -724,16 +793,11 @@ void QskSkinTransition::run( const QskAnimationHint& animationHint )
     const auto& fontTable1 = m_data->tables[ 0 ].fontTable;
     const auto& fontTable2 = m_data->tables[ 1 ].fontTable;
 
-    QSet< QskAspect > candidates;
-
     if ( ( animationHint.duration > 0 ) && ( m_data->mask != 0 ) )
     {
-        qskAddCandidates( m_data->mask, table1.hints(), candidates );
-        qskAddCandidates( m_data->mask, table2.hints(), candidates );
-    }
+        AspectIndex aspectIndex;
+        aspectIndex.build( m_data->mask, table1, table2 );
 
-    if ( !candidates.isEmpty() )
-    {
         bool doGraphicFilter = m_data->mask & QskSkinTransition::Color;
         bool doFont = m_data->mask & QskSkinTransition::Metric;
 
@@ -770,14 +834,25 @@ void QskSkinTransition::run( const QskAnimationHint& animationHint )
                    over the the item trees.
                  */
 
-                animator->addItemAspects( w->contentItem(),
-                    animationHint, candidates, table1, table2 );
+                if ( !( aspectIndex.isEmpty() && animator->isEmpty() ) )
+                {
+                    animator->addItemAspects( w->contentItem(),
+                        animationHint, aspectIndex, table1, table2 );
+                }
+
+                if ( animator->isEmpty() )
+                {
+                    // nothing to animate, that would ever finish
+                    delete animator;
+                    continue;
+                }
 
                 qskApplicationAnimator->add( animator );
             }
         }
 
-        qskApplicationAnimator->start();
+        if ( qskApplicationAnimator->isRunning() )
+            qskApplicationAnimator->start();
     }
 }
 
@@ -15,6 +15,7 @@
 #include "QskClipNode.h"
 #include "QskColorFilter.h"
 #include "QskControl.h"
+#include "QskFrameProfiler.h"
 #include "QskFunctions.h"
 #include "QskGradient.h"
 #include "QskGraphicNode.h"
@@ -27,6 +28,7 @@
 #include "QskTextOptions.h"
 #include "QskSkinStateChanger.h"
 #include "QskTextureRenderer.h"
+#include "QskVectorGraphicNode.h"
 #include "QskSetup.h"
 
 #include <qquickwindow.h>
@@ -107,6 +109,15 @@ static inline QSGNode* qskUpdateTextNode( const QskSkinnable* skinnable,
     return textNode;
 }
 
+static inline bool qskTestUpdateFlag(
+    const QQuickItem* item, QskItem::UpdateFlag flag )
+{
+    if ( auto qItem = qobject_cast< const QskItem* >( item ) )
+        return qItem->testUpdateFlag( flag );
+
+    return QskSetup::testUpdateFlag( flag );
+}
+
 static inline QSGNode* qskUpdateGraphicNode(
     const QskSkinnable* skinnable, QSGNode* node,
     const QskGraphic& graphic, const QskColorFilter& colorFilter,
@@ -119,21 +130,36 @@ static inline QSGNode* qskUpdateGraphicNode(
     if ( item == nullptr )
         return nullptr;
 
-    auto graphicNode = static_cast< QskGraphicNode* >( node );
+    const auto r = qskSceneAlignedRect( item, rect );
+
+    if ( qskTestUpdateFlag( item, QskItem::PreferGeometryForGraphics )
+        && QskVectorGraphicNode::isSupported( graphic ) )
+    {
+        // QskGraphicNode and QskVectorGraphicNode are both plain QSGNodes
+        auto vectorNode = dynamic_cast< QskVectorGraphicNode* >( node );
+        if ( vectorNode == nullptr )
+            vectorNode = new QskVectorGraphicNode();
+
+        vectorNode->setMirrored( mirrored );
+        vectorNode->setGraphic( item->window(), graphic, colorFilter, r );
+
+        return vectorNode;
+    }
+
+    auto graphicNode = dynamic_cast< QskGraphicNode* >( node );
     if ( graphicNode == nullptr )
         graphicNode = new QskGraphicNode();
 
-    const auto flag = QskItem::PreferRasterForTextures;
+    auto renderHint = QskPaintedNode::OpenGL;
 
-    bool useRaster = QskSetup::testUpdateFlag( flag );
-    if ( auto qItem = qobject_cast< const QskItem* >( item ) )
-        useRaster = qItem->testUpdateFlag( flag );
+    if ( qskTestUpdateFlag( item, QskItem::AsyncRasterForTextures ) )
+        renderHint = QskPaintedNode::RasterAsync;
+    else if ( qskTestUpdateFlag( item, QskItem::PreferRasterForTextures ) )
+        renderHint = QskPaintedNode::Raster;
 
-    graphicNode->setRenderHint( useRaster ? QskPaintedNode::Raster : QskPaintedNode::OpenGL );
+    graphicNode->setRenderHint( renderHint );
 
     graphicNode->setMirrored( mirrored );
-
-    const auto r = qskSceneAlignedRect( item, rect );
     graphicNode->setGraphic( item->window(), graphic, colorFilter, r );
 
     return graphicNode;
@@ -340,14 +366,28 @@ void QskSkinlet::updateNode( QskSkinnable* skinnable, QSGNode* parentNode ) cons
         replaceChildNode( DebugRole, parentNode, oldNode, newNode );
     }
 
+    /*
+        The node roles usually correspond to the subcontrols, so profiling
+        them gives the costs of each subcontrol
+     */
+    const auto item = QskFrameProfiler::isEnabled() ? skinnable->owningItem() : nullptr;
+
     for ( const auto nodeRole : std::as_const( m_data->nodeRoles ) )
     {
         Q_ASSERT( nodeRole < FirstReservedRole );
 
+        const auto start = item ? QskFrameProfiler::timestamp() : -1;
+
         oldNode = QskSGNode::findChildNode( parentNode, nodeRole );
         newNode = updateSubNode( skinnable, nodeRole, oldNode );
 
         replaceChildNode( nodeRole, parentNode, oldNode, newNode );
+
+        if ( item )
+        {
+            QskFrameProfiler::record( QskFrameProfiler::UpdateNode,
+                item->metaObject()->className(), item->window(), start, nodeRole );
+        }
     }
 }
 
@@ -16,6 +16,7 @@
 #include "QskMargins.h"
 #include "QskIntervalF.h"
 #include "QskTextColors.h"
+#include "QskRgbValue.h"
 #include "QskInternalMacros.h"
 
 // Even if we don't use the standard Qt animation system we
@@ -93,6 +94,82 @@ static inline QskMetaType qskMetaType( const QVariant& v ) { return v.metaType()
 
 #endif
 
+/*
+    The hot types of skin hint animations are interpolated without
+    going through the registry: the result is written into the storage
+    of the current value, what avoids creating a new QVariant - and for
+    types, that do not fit into it, a heap allocation - for each frame.
+ */
+
+static inline QColor qskInterpolated(
+    const QColor& c1, const QColor& c2, qreal progress )
+{
+    return QskRgb::interpolated( c1, c2, progress );
+}
+
+static inline QSizeF qskInterpolated(
+    const QSizeF& s1, const QSizeF& s2, qreal progress )
+{
+    return s1 + ( s2 - s1 ) * progress;
+}
+
+static inline double qskInterpolated(
+    double v1, double v2, qreal progress )
+{
+    return v1 + ( v2 - v1 ) * progress;
+}
+
+template< typename T >
+static inline T qskInterpolated( const T& v1, const T& v2, qreal progress )
+{
+    return v1.interpolated( v2, progress );
+}
+
+template< typename T >
+static bool qskInterpolateTyped( const QVariant& from,
+    const QVariant& to, qreal progress, QVariant& current )
+{
+    auto value = qskInterpolated( *static_cast< const T* >( from.constData() ),
+        *static_cast< const T* >( to.constData() ), progress );
+
+    if ( *static_cast< const T* >( current.constData() ) == value )
+        return false;
+
+    // data() detaches only, when someone else holds a copy
+    *static_cast< T* >( current.data() ) = std::move( value );
+    return true;
+}
+
+static inline auto qskTypedInterpolator( int typeId )
+    -> bool ( * )( const QVariant&, const QVariant&, qreal, QVariant& )
+{
+    switch ( typeId )
+    {
+        case QMetaType::Double:
+            return qskInterpolateTyped< double >;
+
+        case QMetaType::QColor:
+            return qskInterpolateTyped< QColor >;
+
+        case QMetaType::QSizeF:
+            return qskInterpolateTyped< QSizeF >;
+    }
+
+    if ( typeId == qMetaTypeId< QskMargins >() )
+        return qskInterpolateTyped< QskMargins >;
+
+    if ( typeId == qMetaTypeId< QskBoxShapeMetrics >() )
+        return qskInterpolateTyped< QskBoxShapeMetrics >;
+
+    if ( typeId == qMetaTypeId< QskBoxBorderColors >() )
+        return qskInterpolateTyped< QskBoxBorderColors >;
+
+    if ( typeId == qMetaTypeId< QskGradient >() )
+        return qskInterpolateTyped< QskGradient >;
+
+    return nullptr;
+}
+
 static inline QVariant qskDefaultVariant( QskMetaType type )
 {
     return QVariant( type, nullptr );
@@ -108,6 +185,7 @@ static inline QVariant qskConvertedVariant( const QVariant& from, QskMetaType ty
 
 QskVariantAnimator::QskVariantAnimator()
     : m_interpolator( nullptr )
+    , m_typedInterpolator( nullptr )
 {
 }
 
@@ -175,6 +253,7 @@ bool QskVariantAnimator::convertValues( QVariant& v1, QVariant& v2 )
 void QskVariantAnimator::setup()
 {
     m_interpolator = nullptr;
+    m_typedInterpolator = nullptr;
 
     if ( convertValues( m_startValue, m_endValue ) )
     {
@@ -182,6 +261,8 @@ void QskVariantAnimator::setup()
         {
             const auto id = m_startValue.userType();
 
+            m_typedInterpolator = qskTypedInterpolator( id );
+
             // all what has been registered by qRegisterAnimationInterpolator
             m_interpolator = reinterpret_cast< void ( * )() >(
                 QVariantAnimationPrivate::getInterpolator( id ) );
@@ -193,21 +274,42 @@ void QskVariantAnimator::setup()
 
 void QskVariantAnimator::advance( qreal progress )
 {
-    if ( m_interpolator )
-    {
-        if ( qFuzzyCompare( progress, 1.0 ) )
-            progress = 1.0;
+    updateCurrentValue( progress );
+}
 
-        Q_ASSERT( qskMetaType( m_startValue ) == qskMetaType( m_endValue ) );
+bool QskVariantAnimator::updateCurrentValue( qreal progress )
+{
+    if ( m_interpolator == nullptr )
+        return false;
+
+    if ( qFuzzyCompare( progress, 1.0 ) )
+        progress = 1.0;
+
+    Q_ASSERT( qskMetaType( m_startValue ) == qskMetaType( m_endValue ) );
 
-        m_currentValue = qskInterpolate( m_interpolator,
-            m_startValue, m_endValue, progress );
+    if ( m_typedInterpolator )
+    {
+        if ( qskMetaType( m_currentValue ) != qskMetaType( m_startValue ) )
+        {
+            // overwritten by setCurrentValue
+            m_currentValue = m_startValue;
+        }
+
+        return m_typedInterpolator( m_startValue, m_endValue, progress, m_currentValue );
     }
+
+    auto value = qskInterpolate( m_interpolator, m_startValue, m_endValue, progress );
+    if ( value == m_currentValue )
+        return false;
+
+    m_currentValue = std::move( value );
+    return true;
 }
 
 void QskVariantAnimator::done()
 {
     m_interpolator = nullptr;
+    m_typedInterpolator = nullptr;
 }
 
 bool QskVariantAnimator::maybeInterpolate(
@@ -34,12 +34,18 @@ class QSK_EXPORT QskVariantAnimator : public QskAnimator
     void advance( qreal value ) override;
     void done() override;
 
+    // returns true, when the current value has changed
+    bool updateCurrentValue( qreal progress );
+
   private:
     QVariant m_startValue;
     QVariant m_endValue;
     QVariant m_currentValue;
 
     void ( *m_interpolator )();
+
+    bool ( *m_typedInterpolator )( const QVariant&,
+        const QVariant&, qreal, QVariant& );
 };
 
 inline QVariant QskVariantAnimator::startValue() const
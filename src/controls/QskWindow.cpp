@@ -6,6 +6,7 @@
 #include "QskWindow.h"
 #include "QskControl.h"
 #include "QskEvent.h"
+#include "QskFrameProfiler.h"
 #include "QskQuick.h"
 #include "QskSetup.h"
 #include "QskSkin.h"
@@ -193,6 +194,8 @@ QskWindow::QskWindow( QWindow* parent )
 
     d_func()->contentItemListener.setEnabled( contentItem(), true );
 
+    QskFrameProfiler::addWindow( this );
+
     if ( !qskEnforcedSkin )
         connect( this, &QQuickWindow::afterAnimating, this, &QskWindow::enforceSkin );
 }
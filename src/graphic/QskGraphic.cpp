@@ -17,6 +17,10 @@
 #include <qpainterpath.h>
 #include <qpixmap.h>
 #include <qhashfunctions.h>
+#include <qmutex.h>
+#include <qglobalstatic.h>
+
+#include <atomic>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qpainter_p.h>
@@ -329,26 +333,30 @@ namespace QskGraphicPrivate
     };
 }
 
+// serializing the decoding of deferred commands
+Q_GLOBAL_STATIC( QMutex, qskDeferredCommandsMutex )
+
 class QskGraphic::PrivateData : public QSharedData
 {
   public:
     PrivateData()
-        : commandTypes( 0 )
-        , renderHints( 0 )
     {
     }
 
     PrivateData( const PrivateData& other )
         : QSharedData( other )
-        , viewBox( other.viewBox )
-        , commands( other.commands )
-        , pathInfos( other.pathInfos )
-        , boundingRect( other.boundingRect )
-        , pointRect( other.pointRect )
-        , modificationId( other.modificationId )
-        , commandTypes( other.commandTypes )
-        , renderHints( other.renderHints )
     {
+        // a detached copy does not share the loader
+        other.loadCommands();
+
+        viewBox = other.viewBox;
+        commands = other.commands;
+        pathInfos = other.pathInfos;
+        boundingRect = other.boundingRect;
+        pointRect = other.pointRect;
+        modificationId = other.modificationId;
+        commandTypes = other.commandTypes;
+        renderHints = other.renderHints;
     }
 
     inline bool operator==( const PrivateData& other ) const
@@ -360,6 +368,9 @@ class QskGraphic::PrivateData : public QSharedData
 
     void resetCommands()
     {
+        loader = nullptr;
+        isDeferred.store( false, std::memory_order_relaxed );
+
         commands.clear();
         pathInfos.clear();
 
@@ -372,11 +383,50 @@ class QskGraphic::PrivateData : public QSharedData
     inline void addCommand( const QskPainterCommand& command )
     {
         commands += command;
+        updateModificationId();
+    }
 
+    inline void updateModificationId()
+    {
         static QAtomicInteger< quint64 > nextId( 1 );
         modificationId = nextId.fetchAndAddRelaxed( 1 );
     }
 
+    inline void loadCommands() const
+    {
+        if ( isDeferred.load( std::memory_order_acquire ) )
+            const_cast< PrivateData* >( this )->decodeDeferredCommands();
+    }
+
+    void decodeDeferredCommands()
+    {
+        /*
+            Shared instances might be rendered from different threads
+            and all of them need to see the decoded commands.
+
+            The metrics and command types have been given in advance and
+            are read without locking. As they have been written from the
+            same graphic, that is decoded here, they are not touched.
+            Only the commands and the path infos are published - with the
+            release store of isDeferred.
+         */
+        const QMutexLocker locker( qskDeferredCommandsMutex );
+
+        if ( !isDeferred.load( std::memory_order_relaxed ) )
+            return;
+
+        QskGraphic graphic;
+        graphic.setCommands( loader() );
+
+        const auto& d = *graphic.m_data.constData();
+
+        commands = d.commands;
+        pathInfos = d.pathInfos;
+
+        loader = nullptr;
+        isDeferred.store( false, std::memory_order_release );
+    }
+
     QRectF viewBox = { 0.0, 0.0, -1.0, -1.0 };
     QVector< QskPainterCommand > commands;
     QVector< QskGraphicPrivate::PathInfo > pathInfos;
@@ -386,8 +436,13 @@ class QskGraphic::PrivateData : public QSharedData
 
     quint64 modificationId = 0;
 
-    uint commandTypes : 4;
-    uint renderHints : 4;
+    // decoding the commands, when being accessed for the first time
+    std::function< QVector< QskPainterCommand >() > loader;
+    mutable std::atomic< bool > isDeferred { false };
+
+    // no bitfields: writing one of them must not touch the other one
+    uint commandTypes = 0;
+    uint renderHints = 0;
 };
 
 QskGraphic::QskGraphic()
@@ -524,6 +579,9 @@ void QskGraphic::reset()
 
 bool QskGraphic::isNull() const
 {
+    if ( m_data->isDeferred.load( std::memory_order_acquire ) )
+        return false;
+
     return m_data->commands.isEmpty();
 }
 
@@ -576,6 +634,8 @@ QRectF QskGraphic::scaledBoundingRect( qreal sx, qreal sy ) const
     if ( sx == 1.0 && sy == 1.0 )
         return m_data->boundingRect;
 
+    m_data->loadCommands(); // pathInfos
+
     const bool scalePens = !( m_data->renderHints & RenderPensUnscaled );
 
     QTransform transform;
@@ -651,6 +711,8 @@ void QskGraphic::render( QPainter* painter,
     if ( isNull() )
         return;
 
+    m_data->loadCommands();
+
     const int numCommands = m_data->commands.size();
     const auto commands = m_data->commands.constData();
 
@@ -681,11 +743,11 @@ void QskGraphic::render( QPainter* painter, const QRectF& rect,
     render( painter, rect, QskColorFilter(), aspectRatioMode );
 }
 
-void QskGraphic::render( QPainter* painter, const QRectF& rect,
-    const QskColorFilter& colorFilter, Qt::AspectRatioMode aspectRatioMode ) const
+QTransform QskGraphic::viewportTransform(
+    const QRectF& rect, Qt::AspectRatioMode aspectRatioMode ) const
 {
     if ( isEmpty() || rect.isEmpty() )
-        return;
+        return QTransform();
 
     const bool scalePens = !( m_data->renderHints & RenderPensUnscaled );
 
@@ -701,6 +763,8 @@ void QskGraphic::render( QPainter* painter, const QRectF& rect,
     }
     else
     {
+        m_data->loadCommands(); // pathInfos
+
         boundingBox = m_data->boundingRect;
 
         if ( m_data->pointRect.width() > 0.0 )
@@ -746,6 +810,18 @@ void QskGraphic::render( QPainter* painter, const QRectF& rect,
         tr.translate( -boundingBox.x(), -boundingBox.y() );
     }
 
+    return tr;
+}
+
+void QskGraphic::render( QPainter* painter, const QRectF& rect,
+    const QskColorFilter& colorFilter, Qt::AspectRatioMode aspectRatioMode ) const
+{
+    if ( isEmpty() || rect.isEmpty() )
+        return;
+
+    const bool scalePens = !( m_data->renderHints & RenderPensUnscaled );
+    const auto tr = viewportTransform( rect, aspectRatioMode );
+
     const auto transform = painter->transform();
 
     painter->setTransform( tr, true );
@@ -983,6 +1059,7 @@ void QskGraphic::updateState( const QPaintEngineState& state )
 
 void QskGraphic::addCommand( const QskPainterCommand& command )
 {
+    m_data->loadCommands();
     m_data->addCommand( command );
 }
 
@@ -1017,6 +1094,7 @@ void QskGraphic::updateControlPointRect( const QRectF& rect )
 
 const QVector< QskPainterCommand >& QskGraphic::commands() const
 {
+    m_data->loadCommands();
     return m_data->commands;
 }
 
@@ -1047,6 +1125,25 @@ void QskGraphic::setCommands( const QVector< QskPainterCommand >& commands )
     painter.end();
 }
 
+void QskGraphic::setDeferredCommands( const QRectF& boundingRect,
+    const QRectF& controlPointRect, CommandTypes commandTypes,
+    const std::function< QVector< QskPainterCommand >() >& loader )
+{
+    m_data->resetCommands();
+
+    if ( !loader )
+        return;
+
+    m_data->boundingRect = boundingRect;
+    m_data->pointRect = controlPointRect;
+    m_data->commandTypes = int( commandTypes );
+
+    m_data->loader = loader;
+    m_data->isDeferred.store( true, std::memory_order_release );
+
+    m_data->updateModificationId();
+}
+
 quint64 QskGraphic::modificationId() const
 {
     return m_data->modificationId;
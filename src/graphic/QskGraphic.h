@@ -13,6 +13,8 @@
 #include <qpaintdevice.h>
 #include <qshareddata.h>
 
+#include <functional>
+
 class QskPainterCommand;
 class QskColorFilter;
 class QskGraphicPaintEngine;
@@ -103,12 +105,26 @@ class QSK_EXPORT QskGraphic : public QPaintDevice
 
     QRectF scaledBoundingRect( qreal sx, qreal sy ) const;
 
+    // the transformation, that is applied when rendering into a rectangle
+    QTransform viewportTransform( const QRectF&,
+        Qt::AspectRatioMode = Qt::IgnoreAspectRatio ) const;
+
     QRectF boundingRect() const;
     QRectF controlPointRect() const;
 
     const QVector< QskPainterCommand >& commands() const;
     void setCommands( const QVector< QskPainterCommand >& );
 
+    /*
+        The commands are created by the loader, when they are needed for
+        the first time. Until then the metrics are taken from the parameters,
+        so that f.e. layouting does not need to decode the commands.
+        Used by QskGraphicIO for reading QVG version 2.
+     */
+    void setDeferredCommands( const QRectF& boundingRect,
+        const QRectF& controlPointRect, CommandTypes,
+        const std::function< QVector< QskPainterCommand >() >& loader );
+
     QSizeF defaultSize() const;
 
     void setViewBox( const QRectF& );
@@ -9,12 +9,16 @@
 
 #include <qbuffer.h>
 #include <qdatastream.h>
+#include <qendian.h>
 #include <qfile.h>
+#include <qhash.h>
 #include <qvector.h>
 
 #include <cstring>
+#include <memory>
 
 static const char qskMagicNumber[] = "QSKG";
+static const char qskMagicNumber2[] = "QSK2";
 
 /*
     To avoid crashes ( fonts ), when svg2qvg was running with a different Qt
@@ -202,20 +206,491 @@ static inline void qskReadStateData(
     commands += QskPainterCommand( data );
 }
 
+/*
+    QVG version 2 is a flat layout, that can be decoded without
+    any parsing. All values are little endian:
+
+    - header ( 128 bytes )
+
+        char[4]     magic number "QSK2"
+        quint32     size of the header
+        double[4]   viewBox: x, y, width, height
+        quint32     number of commands
+        quint32     number of path elements
+        quint32     size of the data section
+        quint32     QskGraphic::CommandTypes
+        quint32[2]  reserved
+        double[4]   boundingRect: x, y, width, height
+        double[4]   controlPointRect: x, y, width, height
+
+    - command table ( 16 bytes for each command )
+
+        quint8      type
+        quint8      fill rule ( paths only )
+        quint16     reserved
+        quint32     paths: index of the first element,
+                    otherwise: offset in the data section
+        quint32     paths: number of elements,
+                    otherwise: number of bytes in the data section
+        quint32     reserved
+
+    - path elements ( 24 bytes for each element )
+
+        double      x
+        double      y
+        quint32     QPainterPath::ElementType
+        quint32     reserved
+
+    - data section
+
+        states, pixmaps and images encoded like in version 1. Identical
+        states are stored only once.
+
+    As the position of each command is known from the table, the elements
+    of the paths can be decoded without having to parse anything else.
+
+    The metrics in the header allow to create a graphic, that decodes
+    its commands not before they are needed ( QskGraphic::setDeferredCommands ).
+ */
+
+static constexpr int qskQvg2HeaderSize = 128;
+static constexpr int qskQvg2CommandSize = 16;
+static constexpr int qskQvg2ElementSize = 24;
+
+template< typename T >
+static inline T qskValue( const char* data, int offset )
+{
+    return qFromLittleEndian< T >( data + offset );
+}
+
+template< typename T >
+static inline void qskAppendValue( QByteArray& data, T value )
+{
+    char buf[ sizeof( T ) ];
+    qToLittleEndian< T >( value, buf );
+
+    data.append( buf, sizeof( T ) );
+}
+
+static inline QDataStream& qskSetupStream( QDataStream& stream )
+{
+    stream.setVersion( qskDataStreamVersion );
+    stream.setByteOrder( QDataStream::BigEndian );
+
+    return stream;
+}
+
+namespace
+{
+    class Qvg2Header
+    {
+      public:
+        bool read( const char* data, qint64 size )
+        {
+            if ( size < qskQvg2HeaderSize || memcmp( data, qskMagicNumber2, 4 ) != 0 )
+            {
+                qWarning( "QskGraphicIO::read: bad magic number" );
+                return false;
+            }
+
+            headerSize = qskValue< quint32 >( data, 4 );
+            viewBox = readRect( data, 8 );
+
+            numCommands = qskValue< quint32 >( data, 40 );
+            numElements = qskValue< quint32 >( data, 44 );
+            dataSize = qskValue< quint32 >( data, 48 );
+
+            commandsOffset = headerSize;
+            elementsOffset = commandsOffset + qint64( numCommands ) * qskQvg2CommandSize;
+            dataOffset = elementsOffset + qint64( numElements ) * qskQvg2ElementSize;
+
+            if ( headerSize < qskQvg2HeaderSize || dataOffset + dataSize > size )
+            {
+                qWarning( "QskGraphicIO::read: corrupted data" );
+                return false;
+            }
+
+            commandTypes = static_cast< QskGraphic::CommandTypes >(
+                qskValue< quint32 >( data, 52 ) );
+
+            boundingRect = readRect( data, 64 );
+            controlPointRect = readRect( data, 96 );
+
+            return true;
+        }
+
+        QRectF viewBox;
+
+        quint32 headerSize = 0;
+        quint32 numCommands = 0;
+        quint32 numElements = 0;
+        quint32 dataSize = 0;
+
+        qint64 commandsOffset = 0;
+        qint64 elementsOffset = 0;
+        qint64 dataOffset = 0;
+
+        QskGraphic::CommandTypes commandTypes;
+        QRectF boundingRect;
+        QRectF controlPointRect;
+
+      private:
+        static inline QRectF readRect( const char* data, int offset )
+        {
+            return QRectF(
+                qskValue< double >( data, offset ), qskValue< double >( data, offset + 8 ),
+                qskValue< double >( data, offset + 16 ), qskValue< double >( data, offset + 24 ) );
+        }
+    };
+}
+
+static bool qskDecodeQvg2( const char* data,
+    const Qvg2Header& header, QVector< QskPainterCommand >& commands )
+{
+    const auto numCommands = header.numCommands;
+    const auto numElements = header.numElements;
+    const auto dataSize = header.dataSize;
+
+    commands.reserve( numCommands );
+
+    for ( quint32 i = 0; i < numCommands; i++ )
+    {
+        const auto command = data + header.commandsOffset + i * qskQvg2CommandSize;
+
+        const auto type = static_cast< quint8 >( command[0] );
+        const auto fillRule = static_cast< quint8 >( command[1] );
+        const auto offset = qskValue< quint32 >( command, 4 );
+        const auto count = qskValue< quint32 >( command, 8 );
+
+        if ( type == QskPainterCommand::Path )
+        {
+            if ( qint64( offset ) + count > numElements )
+                return false;
+
+            QPainterPath path;
+            path.reserve( count );
+            path.setFillRule( static_cast< Qt::FillRule >( fillRule ) );
+
+            const auto elements = data + header.elementsOffset;
+
+            for ( quint32 j = offset; j < offset + count; j++ )
+            {
+                const auto element = elements + j * qskQvg2ElementSize;
+
+                const auto x = qskValue< double >( element, 0 );
+                const auto y = qskValue< double >( element, 8 );
+
+                switch( qskValue< quint32 >( element, 16 ) )
+                {
+                    case QPainterPath::MoveToElement:
+                    {
+                        path.moveTo( x, y );
+                        break;
+                    }
+                    case QPainterPath::LineToElement:
+                    {
+                        path.lineTo( x, y );
+                        break;
+                    }
+                    case QPainterPath::CurveToElement:
+                    {
+                        // followed by 2 CurveToDataElements
+                        if ( j + 2 >= offset + count )
+                            return false;
+
+                        const auto e1 = element + qskQvg2ElementSize;
+                        const auto e2 = e1 + qskQvg2ElementSize;
+
+                        if ( qskValue< quint32 >( e1, 16 ) != QPainterPath::CurveToDataElement
+                            || qskValue< quint32 >( e2, 16 ) != QPainterPath::CurveToDataElement )
+                        {
+                            return false;
+                        }
+
+                        path.cubicTo( x, y,
+                            qskValue< double >( e1, 0 ), qskValue< double >( e1, 8 ),
+                            qskValue< double >( e2, 0 ), qskValue< double >( e2, 8 ) );
+
+                        j += 2;
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+            }
+
+            commands += QskPainterCommand( path );
+        }
+        else
+        {
+            if ( qint64( offset ) + count > dataSize )
+                return false;
+
+            // no deep copy
+            const auto bytes = QByteArray::fromRawData(
+                data + header.dataOffset + offset, static_cast< int >( count ) );
+
+            QDataStream stream( bytes );
+            qskSetupStream( stream );
+
+            switch ( type )
+            {
+                case QskPainterCommand::Pixmap:
+                {
+                    qskReadPixmapData( stream, commands );
+                    break;
+                }
+                case QskPainterCommand::Image:
+                {
+                    qskReadImageData( stream, commands );
+                    break;
+                }
+                case QskPainterCommand::State:
+                {
+                    qskReadStateData( stream, commands );
+                    break;
+                }
+                default:
+                    return false;
+            }
+
+            if ( stream.status() != QDataStream::Ok )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+    The bytes of the file are shared by the graphic, until its commands
+    have been decoded: a copy of a QByteArray or a memory mapped file.
+ */
+using Qvg2Data = std::shared_ptr< const char >;
+
+static QskGraphic qskReadQvg2( const Qvg2Data& qvg, qint64 size )
+{
+    Qvg2Header header;
+    if ( !header.read( qvg.get(), size ) )
+        return QskGraphic();
+
+    QskGraphic graphic;
+    graphic.setViewBox( header.viewBox );
+
+    if ( header.numCommands == 0 )
+        return graphic;
+
+    /*
+        The commands are decoded, when the graphic is rendered
+        for the first time. Until then we keep the bytes of the file,
+        what is less memory, than the decoded paths.
+     */
+    const auto loader = [ qvg, header ]()
+    {
+        QVector< QskPainterCommand > commands;
+        if ( !qskDecodeQvg2( qvg.get(), header, commands ) )
+        {
+            qWarning( "QskGraphicIO::read: corrupted data" );
+            commands.clear();
+        }
+
+        return commands;
+    };
+
+    graphic.setDeferredCommands( header.boundingRect,
+        header.controlPointRect, header.commandTypes, loader );
+
+    return graphic;
+}
+
+static QskGraphic qskReadQvg2( const QByteArray& qvg )
+{
+    const auto bytes = new QByteArray( qvg );
+
+    const Qvg2Data data( bytes->constData(),
+        [ bytes ]( const char* ) { delete bytes; } );
+
+    return qskReadQvg2( data, bytes->size() );
+}
+
+static QByteArray qskEncodeQvg2( const QskGraphic& graphic )
+{
+    const auto& commands = graphic.commands();
+
+    QByteArray commandTable;
+    QByteArray elements;
+    QByteArray data;
+
+    QHash< QByteArray, quint32 > offsets; // sharing identical states
+
+    quint32 numElements = 0;
+
+    for ( const auto& command : commands )
+    {
+        quint8 fillRule = 0;
+        quint32 offset = 0;
+        quint32 count = 0;
+
+        if ( command.type() == QskPainterCommand::Path )
+        {
+            const auto& path = *command.path();
+
+            fillRule = static_cast< quint8 >( path.fillRule() );
+            offset = numElements;
+            count = static_cast< quint32 >( path.elementCount() );
+
+            for ( int i = 0; i < path.elementCount(); i++ )
+            {
+                const auto element = path.elementAt( i );
+
+                qskAppendValue< double >( elements, element.x );
+                qskAppendValue< double >( elements, element.y );
+                qskAppendValue< quint32 >( elements, element.type );
+                qskAppendValue< quint32 >( elements, 0 );
+            }
+
+            numElements += count;
+        }
+        else
+        {
+            QByteArray bytes;
+
+            {
+                QDataStream stream( &bytes, QIODevice::WriteOnly );
+                qskSetupStream( stream );
+
+                switch ( command.type() )
+                {
+                    case QskPainterCommand::Pixmap:
+                    {
+                        qskWritePixmapData( *command.pixmapData(), stream );
+                        break;
+                    }
+                    case QskPainterCommand::Image:
+                    {
+                        qskWriteImageData( *command.imageData(), stream );
+                        break;
+                    }
+                    case QskPainterCommand::State:
+                    {
+                        qskWriteStateData( *command.stateData(), stream );
+                        break;
+                    }
+                    default:
+                        return QByteArray();
+                }
+            }
+
+            auto it = offsets.constFind( bytes );
+            if ( it == offsets.constEnd() )
+            {
+                it = offsets.insert( bytes, static_cast< quint32 >( data.size() ) );
+
+                data += bytes;
+
+                // keeping the entries 8 byte aligned
+                while ( data.size() % 8 )
+                    data += '\0';
+            }
+
+            offset = it.value();
+            count = static_cast< quint32 >( bytes.size() );
+        }
+
+        commandTable += static_cast< char >( command.type() );
+        commandTable += static_cast< char >( fillRule );
+        qskAppendValue< quint16 >( commandTable, 0 );
+        qskAppendValue< quint32 >( commandTable, offset );
+        qskAppendValue< quint32 >( commandTable, count );
+        qskAppendValue< quint32 >( commandTable, 0 );
+    }
+
+    const auto viewBox = graphic.viewBox();
+    const auto boundingRect = graphic.boundingRect();
+    const auto controlPointRect = graphic.controlPointRect();
+
+    QByteArray qvg;
+    qvg.reserve( qskQvg2HeaderSize + commandTable.size() + elements.size() + data.size() );
+
+    qvg.append( qskMagicNumber2, 4 );
+    qskAppendValue< quint32 >( qvg, qskQvg2HeaderSize );
+    qskAppendValue< double >( qvg, viewBox.x() );
+    qskAppendValue< double >( qvg, viewBox.y() );
+    qskAppendValue< double >( qvg, viewBox.width() );
+    qskAppendValue< double >( qvg, viewBox.height() );
+    qskAppendValue< quint32 >( qvg, static_cast< quint32 >( commands.size() ) );
+    qskAppendValue< quint32 >( qvg, numElements );
+    qskAppendValue< quint32 >( qvg, static_cast< quint32 >( data.size() ) );
+    qskAppendValue< quint32 >( qvg, static_cast< quint32 >( graphic.commandTypes() ) );
+    qskAppendValue< quint32 >( qvg, 0 );
+    qskAppendValue< quint32 >( qvg, 0 );
+
+    for ( const auto& rect : { boundingRect, controlPointRect } )
+    {
+        qskAppendValue< double >( qvg, rect.x() );
+        qskAppendValue< double >( qvg, rect.y() );
+        qskAppendValue< double >( qvg, rect.width() );
+        qskAppendValue< double >( qvg, rect.height() );
+    }
+
+    Q_ASSERT( qvg.size() == qskQvg2HeaderSize );
+
+    qvg += commandTable;
+    qvg += elements;
+    qvg += data;
+
+    return qvg;
+}
+
 QskGraphic QskGraphicIO::read( const QString& fileName )
 {
-    QFile file( fileName );
-    if ( file.open( QIODevice::ReadOnly ) == false )
+    std::unique_ptr< QFile > file( new QFile( fileName ) );
+    if ( file->open( QIODevice::ReadOnly ) == false )
     {
         qWarning( "QskGraphicIO::read can't open %s", qPrintable( fileName ) );
         return QskGraphic();
     }
 
-    return read( &file );
+    if ( file->peek( 4 ) == QByteArray( qskMagicNumber2, 4 ) )
+    {
+        /*
+            Version 2 is decoded from a memory mapped file. If mapping
+            is not possible ( f.e compressed resources ) we fall back
+            to reading the file.
+         */
+        const auto size = file->size();
+
+        if ( const auto mapped = file->map( 0, size ) )
+        {
+            /*
+                The mapping stays valid after closing the file. So we don't
+                hold a file descriptor for each graphic, that has not been
+                decoded yet. The mapping lives as long as any graphic needs it
+                and is removed by the QFile object.
+             */
+            file->close();
+
+            const auto f = file.release();
+
+            const Qvg2Data data( reinterpret_cast< const char* >( mapped ),
+                [ f, mapped ]( const char* )
+                {
+                    f->unmap( mapped );
+                    delete f;
+                } );
+
+            return qskReadQvg2( data, size );
+        }
+    }
+
+    return read( file.get() );
 }
 
 QskGraphic QskGraphicIO::read( const QByteArray& data )
 {
+    if ( data.startsWith( QByteArray( qskMagicNumber2, 4 ) ) )
+        return qskReadQvg2( data );
+
     QBuffer buffer;
     buffer.setData( data );
 
@@ -227,6 +702,9 @@ QskGraphic QskGraphicIO::read( QIODevice* dev )
     if ( dev == nullptr )
         return QskGraphic();
 
+    if ( dev->peek( 4 ) == QByteArray( qskMagicNumber2, 4 ) )
+        return qskReadQvg2( dev->readAll() );
+
     QDataStream stream( dev );
 #if 1
     stream.setVersion( qskDataStreamVersion );
@@ -289,7 +767,8 @@ QskGraphic QskGraphicIO::read( QIODevice* dev )
     return graphic;
 }
 
-bool QskGraphicIO::write( const QskGraphic& graphic, const QString& fileName )
+bool QskGraphicIO::write( const QskGraphic& graphic,
+    const QString& fileName, Version version )
 {
     QFile file( fileName );
     if ( file.open( QIODevice::WriteOnly | QIODevice::Truncate ) == false )
@@ -298,20 +777,34 @@ bool QskGraphicIO::write( const QskGraphic& graphic, const QString& fileName )
         return false;
     }
 
-    return write( graphic, &file );
+    return write( graphic, &file, version );
 }
 
-bool QskGraphicIO::write( const QskGraphic& graphic, QByteArray& data )
+bool QskGraphicIO::write( const QskGraphic& graphic,
+    QByteArray& data, Version version )
 {
     QBuffer buffer( &data );
-    return write( graphic, &buffer );
+    return write( graphic, &buffer, version );
 }
 
-bool QskGraphicIO::write( const QskGraphic& graphic, QIODevice* dev )
+bool QskGraphicIO::write( const QskGraphic& graphic,
+    QIODevice* dev, Version version )
 {
     if ( dev == nullptr )
         return false;
 
+    if ( version == Version2 )
+    {
+        const auto qvg = qskEncodeQvg2( graphic );
+        if ( qvg.isEmpty() )
+            return false;
+
+        if ( !dev->isOpen() && !dev->open( QIODevice::WriteOnly ) )
+            return false;
+
+        return dev->write( qvg ) == qvg.size();
+    }
+
     QDataStream stream( dev );
 #if 1
     stream.setVersion( qskDataStreamVersion );
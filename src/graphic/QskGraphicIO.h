@@ -15,13 +15,30 @@ class QByteArray;
 
 namespace QskGraphicIO
 {
+    /*
+        Version1 is a QDataStream of the painter commands, while Version2
+        is a flat layout, that includes the metrics of the graphic. Its
+        commands are not decoded before the graphic is rendered for the
+        first time. Reading supports both versions.
+     */
+    enum Version
+    {
+        Version1 = 1,
+        Version2 = 2
+    };
+
     QSK_EXPORT QskGraphic read( const QString& fileName );
     QSK_EXPORT QskGraphic read( const QByteArray& data );
     QSK_EXPORT QskGraphic read( QIODevice* dev );
 
-    QSK_EXPORT bool write( const QskGraphic&, const QString& fileName );
-    QSK_EXPORT bool write( const QskGraphic&, QByteArray& data );
-    QSK_EXPORT bool write( const QskGraphic&, QIODevice* dev );
+    QSK_EXPORT bool write( const QskGraphic&,
+        const QString& fileName, Version = Version1 );
+
+    QSK_EXPORT bool write( const QskGraphic&,
+        QByteArray& data, Version = Version1 );
+
+    QSK_EXPORT bool write( const QskGraphic&,
+        QIODevice* dev, Version = Version1 );
 }
 
 #endif
@@ -7,6 +7,7 @@
 #include "QskArcHints.h"
 #include "QskArcRenderNode.h"
 #include "QskArcRenderer.h"
+#include "QskArcShaderNode.h"
 #include "QskMargins.h"
 #include "QskSGNode.h"
 #include "QskRgbValue.h"
@@ -21,13 +22,16 @@ namespace
          */
 
         ArcRole,
-        FillRole
+        FillRole,
+
+        // border + filling calculated in a fragment shader
+        ShaderRole
     };
 }
 
 static void qskUpdateChildren( QSGNode* parentNode, quint8 role, QSGNode* node )
 {
-    static const QVector< quint8 > roles = { ArcRole, FillRole };
+    static const QVector< quint8 > roles = { ArcRole, FillRole, ShaderRole };
 
     auto oldNode = QskSGNode::findChildNode( parentNode, role );
     QskSGNode::replaceChildNode( roles, role, parentNode, oldNode, node );
@@ -63,6 +67,7 @@ void QskArcNode::setArcData( const QRectF& rect, const QskArcHints& hints )
 
     QskArcRenderNode* arcNode = nullptr;
     QskArcRenderNode* fillNode = nullptr;
+    QskArcShaderNode* shaderNode = nullptr;
 
     if ( !rect.isEmpty() && hints.isVisible() )
     {
@@ -76,7 +81,17 @@ void QskArcNode::setArcData( const QRectF& rect, const QskArcHints& hints )
         const auto hasFilling = gradient.isVisible();
         const auto hasBorder = ( borderWidth > 0.0 ) && QskRgb::isVisible( borderColor );
 
-        if ( hasBorder || hasFilling )
+        const bool useShader = ( hasBorder || hasFilling )
+            && QskArcShaderNode::isEnabled()
+            && QskArcShaderNode::isSupported( rect, metricsArc, gradient );
+
+        if ( useShader )
+        {
+            shaderNode = qskNode< QskArcShaderNode >( this, ShaderRole );
+            shaderNode->updateNode( rect, metricsArc,
+                hasBorder ? borderWidth : 0.0, borderColor, gradient );
+        }
+        else if ( hasBorder || hasFilling )
         {
             arcNode = qskNode< QskArcRenderNode >( this, ArcRole );
 
@@ -106,4 +121,5 @@ void QskArcNode::setArcData( const QRectF& rect, const QskArcHints& hints )
 
     qskUpdateChildren( this, ArcRole, arcNode );
     qskUpdateChildren( this, FillRole, fillNode );
+    qskUpdateChildren( this, ShaderRole, shaderNode );
 }
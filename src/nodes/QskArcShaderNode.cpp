@@ -0,0 +1,279 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskArcShaderNode.h"
+#include "QskArcMetrics.h"
+#include "QskGradient.h"
+#include "QskFunctions.h"
+#include "QskInternalMacros.h"
+#include "QskShaderNodePrivate.h"
+
+#include <qmath.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qsgnode_p.h>
+QSK_QT_PRIVATE_END
+
+namespace
+{
+    class Uniforms
+    {
+      public:
+        inline bool operator==( const Uniforms& other ) const
+        {
+            return ( fillColor1 == other.fillColor1 )
+                && ( fillColor2 == other.fillColor2 )
+                && ( borderColor == other.borderColor )
+                && ( arc == other.arc )
+                && ( borderWidth == other.borderWidth );
+        }
+
+        inline bool operator!=( const Uniforms& other ) const
+        {
+            return !( *this == other );
+        }
+
+        QVector4D fillColor1;
+        QVector4D fillColor2;
+        QVector4D borderColor;
+
+        // outer radius, inner radius, start angle, span angle ( radians )
+        QVector4D arc;
+
+        float borderWidth = 0.0f;
+    };
+
+    class Material final : public QskShaderMaterial< Uniforms >
+    {
+      public:
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+        QSGMaterialShader* createShader() const override;
+#else
+        QSGMaterialShader* createShader( QSGRendererInterface::RenderMode ) const override;
+#endif
+    };
+}
+
+namespace
+{
+    class ShaderRhi final : public QskShaderRhi
+    {
+      public:
+        ShaderRhi()
+            : QskShaderRhi( "arcsdf" )
+        {
+        }
+
+        bool updateUniformData( RenderState& state,
+            QSGMaterial* newMaterial, QSGMaterial* oldMaterial ) override
+        {
+            const auto matOld = static_cast< Material* >( oldMaterial );
+            const auto matNew = static_cast< Material* >( newMaterial );
+
+            Q_ASSERT( state.uniformData()->size() >= 144 );
+
+            bool changed = updateStateData( state, 132, 136 );
+
+            if ( matOld == nullptr || matNew->m_uniforms != matOld->m_uniforms )
+            {
+                const auto& u = matNew->m_uniforms;
+                auto data = state.uniformData()->data();
+
+                memcpy( data + 64, &u.fillColor1, 16 );
+                memcpy( data + 80, &u.fillColor2, 16 );
+                memcpy( data + 96, &u.borderColor, 16 );
+                memcpy( data + 112, &u.arc, 16 );
+                memcpy( data + 128, &u.borderWidth, 4 );
+
+                changed = true;
+            }
+
+            return changed;
+        }
+    };
+}
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+namespace
+{
+    class ShaderGL final : public QskShaderGL
+    {
+      public:
+        ShaderGL()
+            : QskShaderGL( "arcsdf" )
+        {
+        }
+
+        void initialize() override
+        {
+            QskShaderGL::initialize();
+
+            auto p = program();
+
+            m_fillColor1Id = p->uniformLocation( "fillColor1" );
+            m_fillColor2Id = p->uniformLocation( "fillColor2" );
+            m_borderColorId = p->uniformLocation( "borderColor" );
+            m_arcId = p->uniformLocation( "arc" );
+            m_borderWidthId = p->uniformLocation( "borderWidth" );
+        }
+
+      protected:
+        void updateUniforms( QOpenGLShaderProgram* p, const QSGMaterial* material ) override
+        {
+            const auto& u = static_cast< const Material* >( material )->m_uniforms;
+
+            p->setUniformValue( m_fillColor1Id, u.fillColor1 );
+            p->setUniformValue( m_fillColor2Id, u.fillColor2 );
+            p->setUniformValue( m_borderColorId, u.borderColor );
+            p->setUniformValue( m_arcId, u.arc );
+            p->setUniformValue( m_borderWidthId, u.borderWidth );
+        }
+
+      private:
+        int m_fillColor1Id = -1;
+        int m_fillColor2Id = -1;
+        int m_borderColorId = -1;
+        int m_arcId = -1;
+        int m_borderWidthId = -1;
+    };
+}
+
+#endif
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+QSGMaterialShader* Material::createShader() const
+{
+    if ( !( flags() & QSGMaterial::RhiShaderWanted ) )
+        return new ShaderGL();
+
+    return new ShaderRhi();
+}
+
+#else
+
+QSGMaterialShader* Material::createShader( QSGRendererInterface::RenderMode ) const
+{
+    return new ShaderRhi();
+}
+
+#endif
+
+class QskArcShaderNodePrivate final : public QSGGeometryNodePrivate
+{
+  public:
+    QskArcShaderNodePrivate()
+        : geometry( QSGGeometry::defaultAttributes_TexturedPoint2D(), 4 )
+    {
+    }
+
+    QSGGeometry geometry;
+    Material material;
+
+    QRectF rect;
+};
+
+QskArcShaderNode::QskArcShaderNode()
+    : QSGGeometryNode( *new QskArcShaderNodePrivate )
+{
+    Q_D( QskArcShaderNode );
+
+    setGeometry( &d->geometry );
+    setMaterial( &d->material );
+}
+
+QskArcShaderNode::~QskArcShaderNode()
+{
+}
+
+void QskArcShaderNode::updateNode( const QRectF& rect,
+    const QskArcMetrics& arcMetrics, qreal borderWidth,
+    const QColor& borderColor, const QskGradient& gradient )
+{
+    Q_D( QskArcShaderNode );
+
+    if ( rect != d->rect )
+    {
+        d->rect = rect;
+
+        /*
+            The quad covers the complete ellipse, so that changing
+            the angles does not affect the geometry.
+            One unit more on each side for the antialiasing.
+         */
+        const auto r = rect.adjusted( -1.0, -1.0, 1.0, 1.0 );
+
+        QSGGeometry::updateTexturedRectGeometry( &d->geometry, r,
+            r.translated( -rect.center() ) );
+
+        d->geometry.markVertexDataDirty();
+        markDirty( QSGNode::DirtyGeometry );
+    }
+
+    const auto metrics = arcMetrics.toAbsolute( rect.size() );
+
+    const auto radius = 0.5 * rect.width();
+    const auto thickness = qBound( qreal( 0.0 ), metrics.thickness(), radius );
+
+    Uniforms u;
+
+    u.arc = QVector4D( radius, radius - thickness,
+        qDegreesToRadians( metrics.startAngle() ),
+        qDegreesToRadians( metrics.spanAngle() ) );
+
+    if ( borderWidth > 0.0 && borderColor.isValid() && borderColor.alpha() > 0 )
+    {
+        u.borderWidth = qMin( borderWidth, 0.5 * thickness );
+        u.borderColor = qskColorVector( borderColor );
+    }
+
+    if ( gradient.isVisible() )
+    {
+        u.fillColor1 = qskColorVector( gradient.startColor() );
+        u.fillColor2 = qskColorVector( gradient.endColor() );
+    }
+
+    if ( u != d->material.m_uniforms )
+    {
+        d->material.m_uniforms = u;
+        markDirty( QSGNode::DirtyMaterial );
+    }
+}
+
+bool QskArcShaderNode::isSupported( const QRectF& rect,
+    const QskArcMetrics& metrics, const QskGradient& gradient )
+{
+    if ( !qskFuzzyCompare( rect.width(), rect.height() ) )
+        return false;
+
+    if ( metrics.spanAngle() > 360.0 || metrics.spanAngle() < -360.0 )
+    {
+        // the gradient of more than one turn can't be found from the angle
+        return false;
+    }
+
+    if ( gradient.isVisible() && !gradient.isMonochrome() )
+    {
+        // the stops are interpolated along the arc
+        if ( gradient.type() != QskGradient::Stops )
+            return false;
+
+        const auto& stops = gradient.stops();
+
+        if ( stops.count() != 2 || stops[0].position() != 0.0 || stops[1].position() != 1.0 )
+            return false;
+    }
+
+    return true;
+}
+
+bool QskArcShaderNode::isEnabled()
+{
+    extern bool qskHasEnvironment( const char* );
+
+    static const bool enabled = qskHasEnvironment( "QSK_SHADER_ARCS" );
+    return enabled;
+}
@@ -0,0 +1,45 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_ARC_SHADER_NODE_H
+#define QSK_ARC_SHADER_NODE_H
+
+#include "QskGlobal.h"
+#include <qsgnode.h>
+
+class QskArcMetrics;
+class QskGradient;
+class QColor;
+
+class QskArcShaderNodePrivate;
+
+/*
+    An arc rendered as a single quad, where the shape, the border and the
+    filling are calculated in the fragment shader. Geometry and angles are
+    passed as uniforms, so that animating the span of the arc does not
+    require to tessellate the arc again.
+
+    Limitations: circular arcs and gradients with 2 stops,
+    that are interpolated along the arc.
+ */
+class QSK_EXPORT QskArcShaderNode : public QSGGeometryNode
+{
+  public:
+    QskArcShaderNode();
+    ~QskArcShaderNode() override;
+
+    void updateNode( const QRectF&, const QskArcMetrics&,
+        qreal borderWidth, const QColor& borderColor, const QskGradient& );
+
+    static bool isSupported( const QRectF&, const QskArcMetrics&, const QskGradient& );
+
+    // enabled by the environment variable QSK_SHADER_ARCS
+    static bool isEnabled();
+
+  private:
+    Q_DECLARE_PRIVATE( QskArcShaderNode )
+};
+
+#endif
@@ -5,6 +5,7 @@
 
 #include "QskBoxNode.h"
 #include "QskBoxShadowNode.h"
+#include "QskBoxShaderNode.h"
 #include "QskBoxRectangleNode.h"
 #include "QskSGNode.h"
 
@@ -19,14 +20,15 @@ namespace
         ShadowRole,
         ShadowFillRole,
         BoxRole,
-        FillRole
+        FillRole,
+        ShaderRole
     };
 }
 
 static void qskUpdateChildren( QSGNode* parentNode, quint8 role, QSGNode* node )
 {
     static const QVector< quint8 > roles =
-        { ShadowRole, ShadowFillRole, BoxRole, FillRole };
+        { ShadowRole, ShadowFillRole, BoxRole, FillRole, ShaderRole };
 
     auto oldNode = QskSGNode::findChildNode( parentNode, role );
     QskSGNode::replaceChildNode( roles, role, parentNode, oldNode, node );
@@ -65,6 +67,7 @@ void QskBoxNode::updateNode( const QQuickWindow* window,
     QskBoxRectangleNode* shadowFillNode = nullptr;
     QskBoxRectangleNode* rectNode = nullptr;
     QskBoxRectangleNode* fillNode = nullptr;
+    QskBoxShaderNode* shaderNode = nullptr;
 
     if ( !rect.isEmpty() )
     {
@@ -112,14 +115,30 @@ void QskBoxNode::updateNode( const QQuickWindow* window,
             }
         }
 
-        if ( hasBorder || hasFilling )
+        const bool useShader = ( hasBorder || hasFilling )
+            && QskBoxShaderNode::isEnabled()
+            && QskBoxShaderNode::isSupported( rect.size(),
+                shapeMetrics, borderMetrics, borderColors, gradient );
+
+        if ( useShader )
+        {
+            shaderNode = qskNode< QskBoxShaderNode >( this, ShaderRole );
+            shaderNode->updateNode( rect,
+                shapeMetrics, borderMetrics, borderColors, gradient );
+        }
+        else if ( hasBorder || hasFilling )
         {
             rectNode = qskNode< QskBoxRectangleNode >( this, BoxRole );
 
             if ( hasBorder && hasFilling )
             {
-                const bool doCombine = rectNode->hasHint( QskFillNode::PreferColoredGeometry )
-                    && QskBoxRectangleNode::isCombinedGeometrySupported( gradient );
+                bool doCombine = QskBoxRectangleNode::isMonochrome( borderColors, gradient );
+
+                if ( !doCombine )
+                {
+                    doCombine = rectNode->hasHint( QskFillNode::PreferColoredGeometry )
+                        && QskBoxRectangleNode::isCombinedGeometrySupported( gradient );
+                }
 
                 if ( !doCombine )
                     fillNode = qskNode< QskBoxRectangleNode >( this, FillRole );
@@ -145,4 +164,5 @@ void QskBoxNode::updateNode( const QQuickWindow* window,
     qskUpdateChildren( this, ShadowFillRole, shadowFillNode );
     qskUpdateChildren( this, BoxRole, rectNode );
     qskUpdateChildren( this, FillRole, fillNode );
+    qskUpdateChildren( this, ShaderRole, shaderNode );
 }
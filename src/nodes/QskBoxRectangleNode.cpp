@@ -11,6 +11,45 @@
 #include "QskGradient.h"
 #include "QskGradientDirection.h"
 #include "QskFillNodePrivate.h"
+#include "QskGeometryCache.h"
+
+#include <qquickwindow.h>
+
+namespace
+{
+    enum GeometryType
+    {
+        BorderLines,
+        FillLines,
+        ColoredBorderLines,
+        ColoredFillLines,
+        ColoredBorderAndFillLines
+    };
+
+    class GeometryKey
+    {
+      public:
+        inline bool operator==( const GeometryKey& other ) const
+        {
+            return ( type == other.type ) && ( size == other.size )
+                && ( ratio == other.ratio ) && ( shape == other.shape )
+                && ( borderMetrics == other.borderMetrics )
+                && ( borderColors == other.borderColors )
+                && ( gradient == other.gradient );
+        }
+
+        GeometryType type;
+        QSizeF size;
+        qreal ratio;
+
+        QskBoxShapeMetrics shape;
+        QskBoxBorderMetrics borderMetrics;
+        QskBoxBorderColors borderColors;
+        QskGradient gradient;
+    };
+
+    using CacheKey = QskGeometryCache::KeyValue< GeometryKey >;
+}
 
 static inline bool qskHasBorder(
     const QskBoxBorderMetrics& metrics, const QskBoxBorderColors& colors )
@@ -18,6 +57,74 @@ static inline bool qskHasBorder(
     return !metrics.isNull() && colors.isVisible();
 }
 
+static inline bool qskIsCacheable( const QskGradient& gradient )
+{
+    // otherwise the vertices depend on the position of the box
+    return !gradient.isVisible() || gradient.isMonochrome()
+        || gradient.stretchMode() == QskGradient::StretchToSize;
+}
+
+static CacheKey qskCacheKey( GeometryType type,
+    const QQuickWindow* window, const QSizeF& size,
+    const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& borderMetrics,
+    const QskBoxBorderColors& borderColors, const QskGradient& gradient )
+{
+    GeometryKey key { type, size,
+        window ? window->effectiveDevicePixelRatio() : 1.0,
+        shape, borderMetrics, QskBoxBorderColors(), QskGradient() };
+
+    QskHashValue hash = 14000 + type;
+
+    hash = qHashBits( &size, sizeof( size ), hash );
+    hash = shape.hash( hash );
+    hash = borderMetrics.hash( hash );
+
+    if ( borderColors.isVisible() )
+    {
+        key.borderColors = borderColors;
+        hash = borderColors.hash( hash );
+    }
+
+    if ( gradient.isVisible() )
+    {
+        key.gradient = gradient;
+        hash = gradient.hash( hash );
+    }
+
+    hash = qHash( key.ratio, hash );
+
+    return CacheKey( hash, key );
+}
+
+template< typename Tessellate >
+static void qskSetGeometry( GeometryType type, const QQuickWindow* window,
+    const QRectF& rect, const QskBoxShapeMetrics& shape,
+    const QskBoxBorderMetrics& borderMetrics, const QskBoxBorderColors& borderColors,
+    const QskGradient& gradient, QSGGeometry& geometry, Tessellate tessellate )
+{
+    if ( !qskIsCacheable( gradient ) )
+    {
+        tessellate( rect );
+        return;
+    }
+
+    /*
+        Boxes with the same size, shape and colors are tessellated once
+        and copied to the geometry of all nodes.
+     */
+
+    const auto key = qskCacheKey( type, window, rect.size(),
+        shape, borderMetrics, borderColors, gradient );
+
+    if ( QskGeometryCache::copyGeometry( key, rect.topLeft(), geometry ) )
+        return;
+
+    tessellate( QRectF( QPointF(), rect.size() ) );
+
+    QskGeometryCache::insertGeometry( key, geometry );
+    QskGeometryCache::translateGeometry( rect.topLeft(), geometry );
+}
+
 class QskBoxRectangleNodePrivate final : public QskFillNodePrivate
 {
   public:
@@ -124,8 +231,13 @@ void QskBoxRectangleNode::updateFilling( const QQuickWindow* window,
         {
             setColoring( QskFillNode::Polychrome );
 
-            renderer.setColoredFillLines( rect, shape,
-                borderMetrics, fillGradient, *geometry() );
+            qskSetGeometry( ColoredFillLines, window, rect, shape,
+                borderMetrics, QskBoxBorderColors(), fillGradient, *geometry(),
+                [&]( const QRectF& r )
+                {
+                    renderer.setColoredFillLines( r, shape,
+                        borderMetrics, fillGradient, *geometry() );
+                } );
 
             markDirty( QSGNode::DirtyGeometry );
         }
@@ -135,7 +247,12 @@ void QskBoxRectangleNode::updateFilling( const QQuickWindow* window,
 
             if ( dirtyGeometry )
             {
-                renderer.setFillLines( rect, shape, borderMetrics, *geometry() );
+                qskSetGeometry( FillLines, window, rect, shape,
+                    borderMetrics, QskBoxBorderColors(), QskGradient(), *geometry(),
+                    [&]( const QRectF& r )
+                    {
+                        renderer.setFillLines( r, shape, borderMetrics, *geometry() );
+                    } );
                 markDirty( QSGNode::DirtyGeometry );
             }
         }
@@ -173,8 +290,13 @@ void QskBoxRectangleNode::updateBorder( const QQuickWindow* window,
         {
             setColoring( QskFillNode::Polychrome );
 
-            renderer.setColoredBorderLines( rect, shape,
-                borderMetrics, borderColors, *geometry() );
+            qskSetGeometry( ColoredBorderLines, window, rect, shape,
+                borderMetrics, borderColors, QskGradient(), *geometry(),
+                [&]( const QRectF& r )
+                {
+                    renderer.setColoredBorderLines( r, shape,
+                        borderMetrics, borderColors, *geometry() );
+                } );
 
             markDirty( QSGNode::DirtyGeometry );
         }
@@ -184,8 +306,12 @@ void QskBoxRectangleNode::updateBorder( const QQuickWindow* window,
 
             if ( dirtyGeometry )
             {
-                renderer.setBorderLines( rect, shape,
-                    borderMetrics, *geometry() );
+                qskSetGeometry( BorderLines, window, rect, shape,
+                    borderMetrics, QskBoxBorderColors(), QskGradient(), *geometry(),
+                    [&]( const QRectF& r )
+                    {
+                        renderer.setBorderLines( r, shape, borderMetrics, *geometry() );
+                    } );
 
                 markDirty( QSGNode::DirtyGeometry );
             }
@@ -208,7 +334,15 @@ void QskBoxRectangleNode::updateBox( const QQuickWindow* window, const QRectF& r
     const bool hasFill = gradient.isVisible();
     const bool hasBorder = qskHasBorder( borderMetrics, borderColors );
 
-    if ( hasFill && hasBorder )
+    if ( hasFill && hasBorder && isMonochrome( borderColors, gradient ) )
+    {
+        /*
+            Border and filling can't be distinguished and we can fill
+            the outer shape instead, what needs less vertices.
+         */
+        updateFilling( window, rect, shapeMetrics, QskBoxBorderMetrics(), gradient );
+    }
+    else if ( hasFill && hasBorder )
     {
         const auto shape = shapeMetrics.toAbsolute( rect.size() );
 
@@ -217,11 +351,6 @@ void QskBoxRectangleNode::updateBox( const QQuickWindow* window, const QRectF& r
 
         if ( isDirty )
         {
-            /*
-                For monochrome border/filling with the same color we might be
-                able to do QskFillNode::Monochrome. However this is not implemeted in
-                QskBoxRenderer yet. TODO ...
-             */
             setColoring( QskFillNode::Polychrome );
 
             auto fillGradient = QskBoxRenderer::effectiveGradient( gradient );
@@ -232,8 +361,14 @@ void QskBoxRectangleNode::updateBox( const QQuickWindow* window, const QRectF& r
             }
 
             QskBoxRenderer renderer( window );
-            renderer.setColoredBorderAndFillLines( rect, shape, borderMetrics,
-                borderColors, fillGradient, *geometry() );
+
+            qskSetGeometry( ColoredBorderAndFillLines, window, rect, shape,
+                borderMetrics, borderColors, fillGradient, *geometry(),
+                [&]( const QRectF& r )
+                {
+                    renderer.setColoredBorderAndFillLines( r, shape, borderMetrics,
+                        borderColors, fillGradient, *geometry() );
+                } );
 
             markDirty( QSGNode::DirtyGeometry );
         }
@@ -256,3 +391,12 @@ bool QskBoxRectangleNode::isCombinedGeometrySupported( const QskGradient& gradie
 {
     return QskBoxRenderer::isGradientSupported( gradient );
 }
+
+bool QskBoxRectangleNode::isMonochrome(
+    const QskBoxBorderColors& borderColors, const QskGradient& gradient )
+{
+    if ( !( borderColors.isMonochrome() && gradient.isMonochrome() ) )
+        return false;
+
+    return borderColors.left().rgbStart() == gradient.rgbStart();
+}
@@ -48,6 +48,12 @@ class QSK_EXPORT QskBoxRectangleNode : public QskFillNode
      */
     static bool isCombinedGeometrySupported( const QskGradient& );
 
+    /*
+        If true border and filling have the same color and the box can be
+        rendered as a single QskFillNode::Monochrome filling.
+     */
+    static bool isMonochrome( const QskBoxBorderColors&, const QskGradient& );
+
   private:
     Q_DECLARE_PRIVATE( QskBoxRectangleNode )
 };
@@ -0,0 +1,372 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskBoxShaderNode.h"
+#include "QskBoxBorderColors.h"
+#include "QskBoxBorderMetrics.h"
+#include "QskBoxRenderer.h"
+#include "QskBoxShapeMetrics.h"
+#include "QskGradient.h"
+#include "QskGradientDirection.h"
+#include "QskInternalMacros.h"
+#include "QskShaderNodePrivate.h"
+
+#include <qvector2d.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qsgnode_p.h>
+QSK_QT_PRIVATE_END
+
+namespace
+{
+    class Uniforms
+    {
+      public:
+        inline bool operator==( const Uniforms& other ) const
+        {
+            return ( radius == other.radius )
+                && ( innerRadius == other.innerRadius )
+                && ( fillColor1 == other.fillColor1 )
+                && ( fillColor2 == other.fillColor2 )
+                && ( borderColor == other.borderColor )
+                && ( gradientVector == other.gradientVector )
+                && ( size == other.size )
+                && ( innerOffset == other.innerOffset )
+                && ( innerSize == other.innerSize );
+        }
+
+        inline bool operator!=( const Uniforms& other ) const
+        {
+            return !( *this == other );
+        }
+
+        // all coordinates are relative to the center of the box
+        QVector4D radius;
+        QVector4D innerRadius;
+        QVector4D fillColor1;
+        QVector4D fillColor2;
+        QVector4D borderColor;
+        QVector4D gradientVector;
+        QVector2D size; // half of the size
+        QVector2D innerOffset;
+        QVector2D innerSize; // half of the size
+    };
+
+    class Material final : public QskShaderMaterial< Uniforms >
+    {
+      public:
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+        QSGMaterialShader* createShader() const override;
+#else
+        QSGMaterialShader* createShader( QSGRendererInterface::RenderMode ) const override;
+#endif
+    };
+}
+
+namespace
+{
+    class ShaderRhi final : public QskShaderRhi
+    {
+      public:
+        ShaderRhi()
+            : QskShaderRhi( "boxsdf" )
+        {
+        }
+
+        bool updateUniformData( RenderState& state,
+            QSGMaterial* newMaterial, QSGMaterial* oldMaterial ) override
+        {
+            const auto matOld = static_cast< Material* >( oldMaterial );
+            const auto matNew = static_cast< Material* >( newMaterial );
+
+            Q_ASSERT( state.uniformData()->size() >= 192 );
+
+            bool changed = updateStateData( state, 184, 188 );
+
+            if ( matOld == nullptr || matNew->m_uniforms != matOld->m_uniforms )
+            {
+                const auto& u = matNew->m_uniforms;
+                auto data = state.uniformData()->data();
+
+                memcpy( data + 64, &u.radius, 16 );
+                memcpy( data + 80, &u.innerRadius, 16 );
+                memcpy( data + 96, &u.fillColor1, 16 );
+                memcpy( data + 112, &u.fillColor2, 16 );
+                memcpy( data + 128, &u.borderColor, 16 );
+                memcpy( data + 144, &u.gradientVector, 16 );
+                memcpy( data + 160, &u.size, 8 );
+                memcpy( data + 168, &u.innerOffset, 8 );
+                memcpy( data + 176, &u.innerSize, 8 );
+
+                changed = true;
+            }
+
+            return changed;
+        }
+    };
+}
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+namespace
+{
+    class ShaderGL final : public QskShaderGL
+    {
+      public:
+        ShaderGL()
+            : QskShaderGL( "boxsdf" )
+        {
+        }
+
+        void initialize() override
+        {
+            QskShaderGL::initialize();
+
+            auto p = program();
+
+            m_radiusId = p->uniformLocation( "radius" );
+            m_innerRadiusId = p->uniformLocation( "innerRadius" );
+            m_fillColor1Id = p->uniformLocation( "fillColor1" );
+            m_fillColor2Id = p->uniformLocation( "fillColor2" );
+            m_borderColorId = p->uniformLocation( "borderColor" );
+            m_gradientVectorId = p->uniformLocation( "gradientVector" );
+            m_sizeId = p->uniformLocation( "size" );
+            m_innerOffsetId = p->uniformLocation( "innerOffset" );
+            m_innerSizeId = p->uniformLocation( "innerSize" );
+        }
+
+      protected:
+        void updateUniforms( QOpenGLShaderProgram* p, const QSGMaterial* material ) override
+        {
+            const auto& u = static_cast< const Material* >( material )->m_uniforms;
+
+            p->setUniformValue( m_radiusId, u.radius );
+            p->setUniformValue( m_innerRadiusId, u.innerRadius );
+            p->setUniformValue( m_fillColor1Id, u.fillColor1 );
+            p->setUniformValue( m_fillColor2Id, u.fillColor2 );
+            p->setUniformValue( m_borderColorId, u.borderColor );
+            p->setUniformValue( m_gradientVectorId, u.gradientVector );
+            p->setUniformValue( m_sizeId, u.size );
+            p->setUniformValue( m_innerOffsetId, u.innerOffset );
+            p->setUniformValue( m_innerSizeId, u.innerSize );
+        }
+
+      private:
+        int m_radiusId = -1;
+        int m_innerRadiusId = -1;
+        int m_fillColor1Id = -1;
+        int m_fillColor2Id = -1;
+        int m_borderColorId = -1;
+        int m_gradientVectorId = -1;
+        int m_sizeId = -1;
+        int m_innerOffsetId = -1;
+        int m_innerSizeId = -1;
+    };
+}
+
+#endif
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+QSGMaterialShader* Material::createShader() const
+{
+    if ( !( flags() & QSGMaterial::RhiShaderWanted ) )
+        return new ShaderGL();
+
+    return new ShaderRhi();
+}
+
+#else
+
+QSGMaterialShader* Material::createShader( QSGRendererInterface::RenderMode ) const
+{
+    return new ShaderRhi();
+}
+
+#endif
+
+class QskBoxShaderNodePrivate final : public QSGGeometryNodePrivate
+{
+  public:
+    QskBoxShaderNodePrivate()
+        : geometry( QSGGeometry::defaultAttributes_TexturedPoint2D(), 4 )
+    {
+    }
+
+    QSGGeometry geometry;
+    Material material;
+
+    QRectF rect;
+};
+
+QskBoxShaderNode::QskBoxShaderNode()
+    : QSGGeometryNode( *new QskBoxShaderNodePrivate )
+{
+    Q_D( QskBoxShaderNode );
+
+    setGeometry( &d->geometry );
+    setMaterial( &d->material );
+}
+
+QskBoxShaderNode::~QskBoxShaderNode()
+{
+}
+
+void QskBoxShaderNode::updateNode( const QRectF& rect,
+    const QskBoxShapeMetrics& shapeMetrics, const QskBoxBorderMetrics& borderMetrics,
+    const QskBoxBorderColors& borderColors, const QskGradient& gradient )
+{
+    Q_D( QskBoxShaderNode );
+
+    if ( rect != d->rect )
+    {
+        d->rect = rect;
+
+        // one unit more on each side for the antialiasing
+        const auto r = rect.adjusted( -1.0, -1.0, 1.0, 1.0 );
+
+        QSGGeometry::updateTexturedRectGeometry( &d->geometry, r,
+            r.translated( -rect.center() ) );
+
+        d->geometry.markVertexDataDirty();
+        markDirty( QSGNode::DirtyGeometry );
+    }
+
+    const auto shape = shapeMetrics.toAbsolute( rect.size() );
+    const auto border = borderMetrics.toAbsolute( rect.size() );
+
+    const auto bl = border.widthAt( Qt::LeftEdge );
+    const auto bt = border.widthAt( Qt::TopEdge );
+    const auto br = border.widthAt( Qt::RightEdge );
+    const auto bb = border.widthAt( Qt::BottomEdge );
+
+    const auto innerRect = rect.adjusted( bl, bt, -br, -bb );
+
+    Uniforms u;
+
+    u.size = QVector2D( 0.5 * rect.width(), 0.5 * rect.height() );
+
+    {
+        const auto maxRadius = 0.5 * std::min( rect.width(), rect.height() );
+
+        auto radius = [&]( Qt::Corner corner )
+            { return std::min( shape.radius( corner ).width(), maxRadius ); };
+
+        const auto r1 = radius( Qt::BottomRightCorner );
+        const auto r2 = radius( Qt::TopRightCorner );
+        const auto r3 = radius( Qt::BottomLeftCorner );
+        const auto r4 = radius( Qt::TopLeftCorner );
+
+        u.radius = QVector4D( r1, r2, r3, r4 );
+
+        // isSupported: all border widths are the same
+        const auto bw = bl;
+
+        u.innerRadius = QVector4D(
+            std::max( r1 - bw, 0.0 ), std::max( r2 - bw, 0.0 ),
+            std::max( r3 - bw, 0.0 ), std::max( r4 - bw, 0.0 ) );
+    }
+
+    if ( innerRect.isEmpty() )
+    {
+        u.innerSize = QVector2D( -1.0, -1.0 );
+        u.innerOffset = QVector2D();
+    }
+    else
+    {
+        u.innerSize = QVector2D( 0.5 * innerRect.width(), 0.5 * innerRect.height() );
+
+        const auto offset = innerRect.center() - rect.center();
+        u.innerOffset = QVector2D( offset.x(), offset.y() );
+    }
+
+    if ( !borderMetrics.isNull() && borderColors.isVisible() )
+        u.borderColor = qskColorVector( borderColors.left().startColor() );
+    else
+        u.borderColor = QVector4D();
+
+    if ( gradient.isVisible() )
+    {
+        auto g = QskBoxRenderer::effectiveGradient( gradient );
+
+        u.fillColor1 = qskColorVector( g.startColor() );
+        u.fillColor2 = qskColorVector( g.endColor() );
+
+        if ( g.isMonochrome() )
+        {
+            u.gradientVector = QVector4D( 0.0, 0.0, 0.0, 0.0 );
+        }
+        else
+        {
+            if ( g.stretchMode() == QskGradient::StretchToSize )
+                g.stretchTo( innerRect.isEmpty() ? rect : innerRect );
+
+            const auto dir = g.linearDirection();
+            const auto c = rect.center();
+
+            u.gradientVector = QVector4D( dir.x1() - c.x(),
+                dir.y1() - c.y(), dir.x2() - c.x(), dir.y2() - c.y() );
+        }
+    }
+    else
+    {
+        u.fillColor1 = u.fillColor2 = QVector4D();
+        u.gradientVector = QVector4D();
+    }
+
+    if ( u != d->material.m_uniforms )
+    {
+        d->material.m_uniforms = u;
+        markDirty( QSGNode::DirtyMaterial );
+    }
+}
+
+bool QskBoxShaderNode::isSupported( const QSizeF& size,
+    const QskBoxShapeMetrics& shapeMetrics, const QskBoxBorderMetrics& borderMetrics,
+    const QskBoxBorderColors& borderColors, const QskGradient& gradient )
+{
+    if ( borderColors.isVisible() && !borderColors.isMonochrome() )
+        return false;
+
+    /*
+        With different widths the inner corners are not circular
+        and can't be calculated from the box distance function.
+     */
+    if ( !borderMetrics.toAbsolute( size ).isEquidistant() )
+        return false;
+
+    if ( gradient.isVisible() && !gradient.isMonochrome() )
+    {
+        const auto g = QskBoxRenderer::effectiveGradient( gradient );
+
+        if ( g.type() != QskGradient::Linear || g.spreadMode() != QskGradient::PadSpread )
+            return false;
+
+        const auto& stops = g.stops();
+
+        if ( stops.count() != 2 || stops[0].position() != 0.0 || stops[1].position() != 1.0 )
+            return false;
+    }
+
+    const auto shape = shapeMetrics.toAbsolute( size );
+
+    for ( const auto corner : { Qt::TopLeftCorner, Qt::TopRightCorner,
+        Qt::BottomLeftCorner, Qt::BottomRightCorner } )
+    {
+        const auto radius = shape.radius( corner );
+        if ( !qFuzzyCompare( radius.width(), radius.height() ) )
+            return false;
+    }
+
+    return true;
+}
+
+bool QskBoxShaderNode::isEnabled()
+{
+    extern bool qskHasEnvironment( const char* );
+
+    static const bool enabled = qskHasEnvironment( "QSK_SHADER_BOXES" );
+    return enabled;
+}
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_BOX_SHADER_NODE_H
+#define QSK_BOX_SHADER_NODE_H
+
+#include "QskGlobal.h"
+#include <qsgnode.h>
+
+class QskBoxShapeMetrics;
+class QskBoxBorderMetrics;
+class QskBoxBorderColors;
+class QskGradient;
+
+class QskBoxShaderNodePrivate;
+
+/*
+    A box rendered as a single quad, where the rounded corners, the border
+    and the filling are calculated in the fragment shader from signed
+    distance functions. The number of vertices does not depend on the radii
+    or the device pixel ratio, but the geometry can't be batched with
+    other nodes as the material depends on the box.
+
+    Limitations: circular corners, borders with the same width on all
+    edges, monochrome borders and linear gradients with 2 stops.
+
+    The node is experimental: it is not used unless QSK_SHADER_BOXES is set.
+    The output has not been compared against QskBoxRectangleNode yet
+    on enough backends - see playground/boxdiff.
+ */
+class QSK_EXPORT QskBoxShaderNode : public QSGGeometryNode
+{
+  public:
+    QskBoxShaderNode();
+    ~QskBoxShaderNode() override;
+
+    void updateNode( const QRectF&, const QskBoxShapeMetrics&,
+        const QskBoxBorderMetrics&, const QskBoxBorderColors&, const QskGradient& );
+
+    static bool isSupported( const QSizeF&, const QskBoxShapeMetrics&,
+        const QskBoxBorderMetrics&, const QskBoxBorderColors&, const QskGradient& );
+
+    // experimental: enabled by the environment variable QSK_SHADER_BOXES
+    static bool isEnabled();
+
+  private:
+    Q_DECLARE_PRIVATE( QskBoxShaderNode )
+};
+
+#endif
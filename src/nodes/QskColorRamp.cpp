@@ -13,6 +13,8 @@ QSK_QT_PRIVATE_BEGIN
 QSK_QT_PRIVATE_END
 
 #include <qcoreapplication.h>
+#include <qmutex.h>
+#include <qtimer.h>
 
 namespace
 {
@@ -64,74 +66,220 @@ namespace
         }
 
         const void* rhi;
-        const QskGradientStops stops;
-        const QskGradient::SpreadMode spreadMode;
+        QskGradientStops stops;
+        QskGradient::SpreadMode spreadMode;
     };
 
     inline size_t qHash( const HashKey& key, size_t seed = 0 )
     {
-        size_t values = seed + key.spreadMode;
+        QskHashValue hash = ::qHash( key.rhi, seed );
+        hash = ::qHash( static_cast< int >( key.spreadMode ), hash );
 
         for ( const auto& stop : key.stops )
-            values += stop.rgb();
+            hash = stop.hash( hash );
 
-        return values;
+        return hash;
     }
 
+    class Entry
+    {
+      public:
+        Texture* texture = nullptr;
+        qint64 bytes = 0;
+
+        quint64 lastUsed = 0;
+        quint64 generation = 0;
+    };
+
     class Cache
     {
       public:
-        ~Cache() { qDeleteAll( m_hashTable ); }
+        ~Cache();
 
         void cleanupRhi( const QRhi* );
 
         Texture* texture( const void* rhi,
             const QskGradientStops&, QskGradient::SpreadMode );
 
+        const Texture* cachedTexture( const void* rhi,
+            const QskGradientStops&, QskGradient::SpreadMode ) const;
+
+        void evict( const void* rhi );
+
+        qint64 budget = 1024 * 1024;
+
       private:
-        QHash< HashKey, Texture* > m_hashTable;
-        QVector< const QRhi* > m_rhiTable; // no QSet: we usually have only one entry
+        /*
+            Each RHI is used from its own render thread, with frames
+            being rendered independently. So a generation is about
+            the frames of one RHI only.
+         */
+        class RhiData
+        {
+          public:
+            const void* rhi;
+            quint64 generation;
+            bool generationPending;
+        };
+
+        RhiData& rhiData( const void* rhi );
+        void scheduleGeneration( RhiData& );
+
+        QHash< HashKey, Entry > m_hashTable;
+        QVector< RhiData > m_rhiTable; // no QHash: we usually have only one entry
+
+        qint64 m_bytes = 0;
+        quint64 m_counter = 0;
     };
 
     static Cache* s_cache;
+    static QBasicMutex s_mutex;
 }
 
 static void qskCleanupCache()
 {
+    const QMutexLocker locker( &s_mutex );
+
     delete s_cache;
     s_cache = nullptr;
 }
 
 static void qskCleanupRhi( const QRhi* rhi )
 {
+    const QMutexLocker locker( &s_mutex );
+
     if ( s_cache )
         s_cache->cleanupRhi( rhi );
 }
 
+Cache::~Cache()
+{
+    for ( const auto& entry : std::as_const( m_hashTable ) )
+        delete entry.texture;
+}
+
 Texture* Cache::texture( const void* rhi,
     const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
 {
     const HashKey key { rhi, stops, spreadMode };
 
-    auto texture = m_hashTable[key];
-    if ( texture == nullptr )
+    auto& data = rhiData( rhi );
+
+    auto& entry = m_hashTable[ key ];
+    if ( entry.texture == nullptr )
     {
-        texture = new Texture( stops, spreadMode );
-        m_hashTable[ key ] = texture;
+        entry.texture = new Texture( stops, spreadMode );
+        entry.bytes = entry.texture->textureSize().width() * 4;
+
+        m_bytes += entry.bytes;
+    }
+
+    entry.lastUsed = ++m_counter;
+    entry.generation = data.generation;
+
+    auto texture = entry.texture;
+
+    scheduleGeneration( data );
+
+    if ( m_bytes > budget )
+        evict( rhi );
+
+    return texture;
+}
+
+const Texture* Cache::cachedTexture( const void* rhi,
+    const QskGradientStops& stops, QskGradient::SpreadMode spreadMode ) const
+{
+    const auto it = m_hashTable.constFind( HashKey { rhi, stops, spreadMode } );
+    return ( it != m_hashTable.constEnd() ) ? it->texture : nullptr;
+}
+
+Cache::RhiData& Cache::rhiData( const void* rhi )
+{
+    for ( auto& data : m_rhiTable )
+    {
+        if ( data.rhi == rhi )
+            return data;
+    }
+
+    if ( rhi != nullptr )
+    {
+        auto myrhi = ( QRhi* )rhi;
+        myrhi->addCleanupCallback( qskCleanupRhi );
+    }
+
+    m_rhiTable += RhiData { rhi, 0, false };
+    return m_rhiTable.last();
+}
 
-        if ( rhi != nullptr )
+void Cache::scheduleGeneration( RhiData& data )
+{
+    if ( data.generationPending )
+        return;
+
+    /*
+        The textures might be in use by the renderer until the frame
+        has been completed. As the event loop of the render thread is not
+        processed while rendering a frame we start a new generation,
+        when returning to the event loop.
+     */
+
+    data.generationPending = true;
+
+    // called from the render thread, that is using the RHI
+    QTimer::singleShot( 0,
+        [ rhi = data.rhi ]()
         {
-            auto myrhi = ( QRhi* )rhi;
+            const QMutexLocker locker( &s_mutex );
 
-            if ( !m_rhiTable.contains( myrhi ) )
+            if ( s_cache )
             {
-                myrhi->addCleanupCallback( qskCleanupRhi );
-                m_rhiTable += myrhi;
+                for ( auto& entry : s_cache->m_rhiTable )
+                {
+                    if ( entry.rhi == rhi )
+                    {
+                        entry.generation++;
+                        entry.generationPending = false;
+                    }
+                }
             }
+        } );
+}
+
+void Cache::evict( const void* rhi )
+{
+    /*
+        Textures of other RHIs are not touched: their resources
+        must not be released from the thread of another RHI
+        and they might be in use by a frame, that is rendered
+        at the same time.
+     */
+    const auto generation = rhiData( rhi ).generation;
+
+    while ( m_bytes > budget )
+    {
+        auto lru = m_hashTable.end();
+
+        for ( auto it = m_hashTable.begin(); it != m_hashTable.end(); ++it )
+        {
+            if ( it.key().rhi != rhi )
+                continue;
+
+            if ( it->generation == generation )
+                continue; // maybe in use by the current frame
+
+            if ( lru == m_hashTable.end() || it->lastUsed < lru->lastUsed )
+                lru = it;
         }
-    }
 
-    return texture;
+        if ( lru == m_hashTable.end() )
+            break;
+
+        m_bytes -= lru->bytes;
+
+        delete lru->texture;
+        m_hashTable.erase( lru );
+    }
 }
 
 void Cache::cleanupRhi( const QRhi* rhi )
@@ -140,7 +288,9 @@ void Cache::cleanupRhi( const QRhi* rhi )
     {
         if ( it.key().rhi == rhi )
         {
-            delete it.value();
+            m_bytes -= it->bytes;
+
+            delete it->texture;
             it = m_hashTable.erase( it );
         }
         else
@@ -149,12 +299,21 @@ void Cache::cleanupRhi( const QRhi* rhi )
         }
     }
 
-    m_rhiTable.removeAll( rhi );
+    for ( int i = 0; i < m_rhiTable.count(); i++ )
+    {
+        if ( m_rhiTable[ i ].rhi == rhi )
+        {
+            m_rhiTable.remove( i );
+            break;
+        }
+    }
 }
 
 QSGTexture* QskColorRamp::texture( const void* rhi,
     const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
 {
+    const QMutexLocker locker( &s_mutex );
+
     if ( s_cache == nullptr )
     {
         s_cache = new Cache();
@@ -170,3 +329,34 @@ QSGTexture* QskColorRamp::texture( const void* rhi,
 
     return s_cache->texture( rhi, stops, spreadMode );
 }
+
+const QSGTexture* QskColorRamp::cachedTexture( const void* rhi,
+    const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+{
+    const QMutexLocker locker( &s_mutex );
+    return s_cache ? s_cache->cachedTexture( rhi, stops, spreadMode ) : nullptr;
+}
+
+void QskColorRamp::setBudget( int bytes )
+{
+    const QMutexLocker locker( &s_mutex );
+
+    if ( s_cache == nullptr )
+    {
+        s_cache = new Cache();
+        qAddPostRoutine( qskCleanupCache );
+    }
+
+    /*
+        We don't know the thread we are called from. So textures
+        exceeding the budget are evicted with the next request
+        for a texture of their RHI.
+     */
+    s_cache->budget = qMax( bytes, 0 );
+}
+
+int QskColorRamp::budget()
+{
+    const QMutexLocker locker( &s_mutex );
+    return s_cache ? s_cache->budget : 1024 * 1024;
+}
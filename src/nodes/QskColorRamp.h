@@ -11,10 +11,27 @@
 
 class QSGTexture;
 
+/*
+    Textures with the color tables of gradients, that are shared
+    between all gradient materials.
+
+    Textures are kept until their total size exceeds a budget, when the
+    least recently used ones are deleted. Textures, that have been used
+    since the last time the event loop was processed - what usually
+    means: in the current frame - are never deleted.
+ */
 namespace QskColorRamp
 {
     QSGTexture* texture( const void* rhi,
         const QskGradientStops&, QskGradient::SpreadMode );
+
+    // lookup without creating/touching a texture, nullptr when not cached
+    const QSGTexture* cachedTexture( const void* rhi,
+        const QskGradientStops&, QskGradient::SpreadMode );
+
+    // size in bytes, default: 1MB
+    void setBudget( int bytes );
+    int budget();
 }
 
 #endif
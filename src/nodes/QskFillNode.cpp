@@ -11,8 +11,125 @@
 #include <qsgflatcolormaterial.h>
 #include <qsgvertexcolormaterial.h>
 #include <qglobalstatic.h>
+#include <qhash.h>
+#include <qmutex.h>
+
+namespace
+{
+    /*
+        Sharing the materials avoids allocating one material per node for
+        the very common case of fillings with a color from the skin. This is
+        about memory only: QSGFlatColorMaterial::compare() is based on the
+        color, so the renderer merges nodes with the same color anyway.
+
+        The nodes might live in different render threads, so we need a mutex.
+        The materials are reference counted and deleted, when not being
+        used anymore - otherwise animating a color would make the pool
+        grow with every frame.
+     */
+    class FlatColorMaterials
+    {
+      public:
+        ~FlatColorMaterials()
+        {
+            for ( const auto& entry : std::as_const( m_entries ) )
+                delete entry.material;
+        }
+
+        QSGFlatColorMaterial* acquire( QRgb rgb )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            auto& entry = m_entries[ rgb ];
+            if ( entry.material == nullptr )
+            {
+                entry.material = new QSGFlatColorMaterial();
+                entry.material->setColor( QColor::fromRgba( rgb ) );
+            }
+
+            entry.refCount++;
+            return entry.material;
+        }
+
+        void release( QSGFlatColorMaterial* material )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            const auto it = m_entries.find( material->color().rgba() );
+            if ( it != m_entries.end() && it->material == material )
+            {
+                if ( --it->refCount == 0 )
+                {
+                    delete it->material;
+                    m_entries.erase( it );
+                }
+            }
+        }
+
+      private:
+        class Entry
+        {
+          public:
+            QSGFlatColorMaterial* material = nullptr;
+            int refCount = 0;
+        };
+
+        QMutex m_mutex;
+        QHash< QRgb, Entry > m_entries;
+    };
+}
 
 Q_GLOBAL_STATIC( QSGVertexColorMaterial, qskMaterialColorVertex )
+Q_GLOBAL_STATIC( FlatColorMaterials, qskFlatColorMaterials )
+
+static inline void qskReleaseFlatColorMaterial( QSGMaterial* material )
+{
+    if ( !qskFlatColorMaterials.isDestroyed() )
+        qskFlatColorMaterials->release( static_cast< QSGFlatColorMaterial* >( material ) );
+}
+
+static void qskSetFlatColorMaterial( QSGGeometryNode* node, QRgb rgb, bool isShared )
+{
+    const auto oldMaterial = node->material();
+    const bool ownsOldMaterial = node->flags() & QSGNode::OwnsMaterial;
+
+    QSGFlatColorMaterial* material = nullptr;
+    if ( !qskFlatColorMaterials.isDestroyed() )
+        material = qskFlatColorMaterials->acquire( rgb );
+
+    const bool ownsMaterial = ( material == nullptr );
+    if ( ownsMaterial )
+    {
+        // shutting down
+        material = new QSGFlatColorMaterial();
+        material->setColor( QColor::fromRgba( rgb ) );
+    }
+
+    node->setFlag( QSGNode::OwnsMaterial, false );
+    node->setMaterial( material );
+    node->setFlag( QSGNode::OwnsMaterial, ownsMaterial );
+
+    if ( ownsOldMaterial )
+        delete oldMaterial;
+    else if ( isShared )
+        qskReleaseFlatColorMaterial( oldMaterial );
+}
+
+static inline void qskSetGeometryColored( QSGGeometry& geometry, bool on )
+{
+    const bool isColored = geometry.attributeCount() != 1;
+    if ( on == isColored )
+        return;
+
+    /*
+        The geometry is an embedded member and can't be replaced. As it
+        is always empty, when the coloring changes, we can overwrite it.
+     */
+    const QSGGeometry g( on ? QSGGeometry::defaultAttributes_ColoredPoint2D()
+        : QSGGeometry::defaultAttributes_Point2D(), 0 );
+
+    memcpy( ( void* ) &geometry, ( void* ) &g, sizeof( QSGGeometry ) );
+}
 
 static inline QskGradient::Type qskGradientType( QskFillNode::Coloring coloring )
 {
@@ -56,6 +173,8 @@ QskFillNode::QskFillNode( QskFillNodePrivate& dd )
 
 QskFillNode::~QskFillNode()
 {
+    if ( d_func()->coloring == Monochrome && !( flags() & QSGNode::OwnsMaterial ) )
+        qskReleaseFlatColorMaterial( material() );
 }
 
 void QskFillNode::resetGeometry()
@@ -70,16 +189,21 @@ void QskFillNode::setColoring( Coloring coloring )
     if ( coloring == d->coloring )
         return;
 
+    if ( coloring == Monochrome )
+    {
+        // the default color of QSGFlatColorMaterial
+        setColoring( QColor( Qt::white ) );
+        return;
+    }
+
+    const auto oldMaterial = material();
+    const bool isSharedFlat = ( d->coloring == Monochrome )
+        && !( flags() & QSGNode::OwnsMaterial );
+
     d->coloring = coloring;
 
     switch( coloring )
     {
-        case Monochrome:
-        {
-            setMaterial( new QSGFlatColorMaterial() );
-            break;
-        }
-
         case Polychrome:
         {
             setMaterial( qskMaterialColorVertex );
@@ -98,6 +222,9 @@ void QskFillNode::setColoring( Coloring coloring )
         }
     }
 
+    if ( isSharedFlat )
+        qskReleaseFlatColorMaterial( oldMaterial );
+
     if ( material() == qskMaterialColorVertex )
     {
         /*
@@ -108,22 +235,12 @@ void QskFillNode::setColoring( Coloring coloring )
             to use this type of coloring for monochrome fillings: memory vs. performance.
          */
         setFlag( QSGNode::OwnsMaterial, false ); // shared: do not delete
-
-        if ( !isGeometryColored() )
-        {
-            const QSGGeometry g( QSGGeometry::defaultAttributes_ColoredPoint2D(), 0 );
-            memcpy( ( void* ) &d->geometry, ( void* ) &g, sizeof( QSGGeometry ) );
-        }
+        qskSetGeometryColored( d->geometry, true );
     }
     else
     {
         setFlag( QSGNode::OwnsMaterial, true );
-
-        if ( isGeometryColored() )
-        {
-            const QSGGeometry g( QSGGeometry::defaultAttributes_Point2D(), 0 );
-            memcpy( ( void* ) &d->geometry, ( void* ) &g, sizeof( QSGGeometry ) );
-        }
+        qskSetGeometryColored( d->geometry, false );
     }
 }
 
@@ -134,16 +251,30 @@ QskFillNode::Coloring QskFillNode::coloring() const
 
 void QskFillNode::setColoring( const QColor& color )
 {
-    setColoring( Monochrome );
+    Q_D( QskFillNode );
 
-    const auto colorRgb = color.toRgb();
+    const auto rgb = color.rgba();
 
-    auto mat = static_cast< QSGFlatColorMaterial* >( material() );
-    if ( mat->color() != colorRgb )
+    if ( d->coloring == Monochrome )
     {
-        mat->setColor( colorRgb );
-        markDirty( QSGNode::DirtyMaterial );
+        const auto mat = static_cast< const QSGFlatColorMaterial* >( material() );
+        if ( mat->color().rgba() == rgb )
+            return;
     }
+
+    /*
+        Instead of modifying the color of the material we switch to
+        a material, that is shared with all other nodes of the same color
+        ( see FlatColorMaterials ).
+     */
+    const bool isShared = ( d->coloring == Monochrome )
+        && !( flags() & QSGNode::OwnsMaterial );
+
+    qskSetFlatColorMaterial( this, rgb, isShared );
+    markDirty( QSGNode::DirtyMaterial );
+
+    d->coloring = Monochrome;
+    qskSetGeometryColored( d->geometry, false );
 }
 
 void QskFillNode::setColoring( const QRectF& rect, const QskGradient& gradient )
@@ -0,0 +1,334 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskGeometryCache.h"
+
+#include <qsggeometry.h>
+#include <qbytearray.h>
+#include <qhash.h>
+#include <qmutex.h>
+#include <qpainterpath.h>
+#include <qpoint.h>
+
+#include <cstring>
+
+#ifndef QT_NO_DEBUG_STREAM
+#include <qdebug.h>
+#endif
+
+namespace
+{
+    class Entry
+    {
+      public:
+        ~Entry()
+        {
+            delete key;
+        }
+
+        const QskGeometryCache::Key* key = nullptr;
+
+        QByteArray vertices;
+
+        int vertexCount = 0;
+        int sizeOfVertex = 0;
+        uint drawingMode = 0;
+
+        // least recently used order
+        Entry* prev = nullptr;
+        Entry* next = nullptr;
+    };
+
+    class Cache
+    {
+      public:
+        ~Cache()
+        {
+            clear();
+        }
+
+        Entry* find( const QskGeometryCache::Key& key )
+        {
+            auto entry = entries.value( key.hash() );
+
+            if ( entry && entry->key->isEqual( key ) )
+            {
+                touch( entry );
+                return entry;
+            }
+
+            return nullptr;
+        }
+
+        Entry* insert( const QskGeometryCache::Key& key )
+        {
+            auto& entry = entries[ key.hash() ];
+
+            if ( entry )
+            {
+                // another key with the same hash value gets replaced
+                bytes -= entry->vertices.size();
+
+                delete entry->key;
+                unlink( entry );
+            }
+            else
+            {
+                entry = new Entry();
+            }
+
+            entry->key = key.clone();
+            pushFront( entry );
+
+            return entry;
+        }
+
+        void evict( qint64 budget )
+        {
+            while ( bytes > budget && m_last )
+            {
+                auto entry = m_last;
+
+                unlink( entry );
+                entries.remove( entry->key->hash() );
+
+                bytes -= entry->vertices.size();
+                delete entry;
+
+                statistics.evictions++;
+            }
+        }
+
+        void clear()
+        {
+            qDeleteAll( entries );
+            entries.clear();
+
+            m_first = m_last = nullptr;
+            bytes = 0;
+        }
+
+        QMutex mutex;
+
+        QHash< QskHashValue, Entry* > entries;
+        QskGeometryCache::Statistics statistics;
+
+        qint64 bytes = 0;
+        int budget = 4 * 1024 * 1024;
+
+      private:
+        inline void touch( Entry* entry )
+        {
+            if ( entry != m_first )
+            {
+                unlink( entry );
+                pushFront( entry );
+            }
+        }
+
+        inline void pushFront( Entry* entry )
+        {
+            entry->prev = nullptr;
+            entry->next = m_first;
+
+            if ( m_first )
+                m_first->prev = entry;
+            else
+                m_last = entry;
+
+            m_first = entry;
+        }
+
+        inline void unlink( Entry* entry )
+        {
+            if ( entry->prev )
+                entry->prev->next = entry->next;
+            else
+                m_first = entry->next;
+
+            if ( entry->next )
+                entry->next->prev = entry->prev;
+            else
+                m_last = entry->prev;
+
+            entry->prev = entry->next = nullptr;
+        }
+
+        // most recently used first
+        Entry* m_first = nullptr;
+        Entry* m_last = nullptr;
+    };
+}
+
+Q_GLOBAL_STATIC( Cache, qskCache )
+
+bool QskGeometryCache::copyGeometry(
+    const Key& key, const QPointF& offset, QSGGeometry& geometry )
+{
+    if ( qskCache.isDestroyed() )
+        return false;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+
+    const auto entry = cache->find( key );
+    if ( entry == nullptr || entry->sizeOfVertex != geometry.sizeOfVertex() )
+    {
+        cache->statistics.misses++;
+        return false;
+    }
+
+    cache->statistics.hits++;
+
+    geometry.setDrawingMode( entry->drawingMode );
+    geometry.allocate( entry->vertexCount );
+
+    std::memcpy( geometry.vertexData(),
+        entry->vertices.constData(), entry->vertices.size() );
+    geometry.markVertexDataDirty();
+
+    translateGeometry( offset, geometry );
+
+    return true;
+}
+
+void QskGeometryCache::insertGeometry( const Key& key, const QSGGeometry& geometry )
+{
+    if ( qskCache.isDestroyed() || geometry.indexCount() > 0 )
+        return;
+
+    const auto bytes = geometry.vertexCount() * geometry.sizeOfVertex();
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+
+    if ( bytes > cache->budget / 4 )
+    {
+        // huge geometries would replace too many others
+        return;
+    }
+
+    auto entry = cache->insert( key );
+
+    entry->vertices = QByteArray(
+        static_cast< const char* >( geometry.vertexData() ), bytes );
+    entry->vertexCount = geometry.vertexCount();
+    entry->sizeOfVertex = geometry.sizeOfVertex();
+    entry->drawingMode = geometry.drawingMode();
+
+    cache->bytes += bytes;
+    cache->evict( cache->budget );
+}
+
+void QskGeometryCache::translateGeometry( const QPointF& offset, QSGGeometry& geometry )
+{
+    if ( offset.isNull() )
+        return;
+
+    const auto dx = static_cast< float >( offset.x() );
+    const auto dy = static_cast< float >( offset.y() );
+
+    // all vertex types of the box renderer start with x/y as floats
+
+    auto data = static_cast< char* >( geometry.vertexData() );
+    const auto stride = geometry.sizeOfVertex();
+
+    for ( int i = 0; i < geometry.vertexCount(); i++ )
+    {
+        auto xy = reinterpret_cast< float* >( data );
+        xy[ 0 ] += dx;
+        xy[ 1 ] += dy;
+
+        data += stride;
+    }
+
+    geometry.markVertexDataDirty();
+}
+
+QskHashValue QskGeometryCache::pathHash( const QPainterPath& path, QskHashValue seed )
+{
+    auto hash = ::qHash( static_cast< int >( path.fillRule() ), seed );
+
+    for ( int i = 0; i < path.elementCount(); i++ )
+    {
+        const auto element = path.elementAt( i );
+
+        hash = ::qHash( static_cast< int >( element.type ), hash );
+        hash = ::qHash( element.x, hash );
+        hash = ::qHash( element.y, hash );
+    }
+
+    return hash;
+}
+
+void QskGeometryCache::setBudget( int bytes )
+{
+    if ( qskCache.isDestroyed() )
+        return;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+
+    cache->budget = qMax( bytes, 0 );
+    cache->evict( cache->budget );
+}
+
+int QskGeometryCache::budget()
+{
+    if ( qskCache.isDestroyed() )
+        return 0;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+    return cache->budget;
+}
+
+void QskGeometryCache::clear()
+{
+    if ( qskCache.isDestroyed() )
+        return;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+    cache->clear();
+}
+
+QskGeometryCache::Statistics QskGeometryCache::statistics()
+{
+    if ( qskCache.isDestroyed() )
+        return Statistics();
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+
+    auto statistics = cache->statistics;
+    statistics.entryCount = cache->entries.count();
+    statistics.bytes = cache->bytes;
+
+    return statistics;
+}
+
+void QskGeometryCache::debugStatistics( QDebug debug )
+{
+#ifndef QT_NO_DEBUG_STREAM
+    const auto s = statistics();
+
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+    debug << '(';
+    debug << "hits: " << s.hits << ", misses: " << s.misses
+          << ", evictions: " << s.evictions
+          << ", entries: " << s.entryCount << ", bytes: " << s.bytes;
+    debug << ')';
+#else
+    Q_UNUSED( debug )
+#endif
+}
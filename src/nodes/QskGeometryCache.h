@@ -0,0 +1,114 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_GEOMETRY_CACHE_H
+#define QSK_GEOMETRY_CACHE_H
+
+#include "QskGlobal.h"
+
+class QSGGeometry;
+class QPainterPath;
+class QPointF;
+class QDebug;
+
+/*
+    Tessellations ( boxes, shapes, strokes ), that are shared between
+    all nodes of the process.
+
+    The vertices are stored without translation - f.e. relative to the
+    top left corner of a box - so that nodes with the same size, shape,
+    colors etc. can reuse the tessellation regardless of their position.
+    The key is made of these attributes and a hash value of them, that
+    has to be calculated by the caller. Entries are found by the hash value,
+    but are only a hit, when the attributes are equal.
+
+    Entries are removed in least recently used order, when the total size
+    of the vertices exceeds a budget.
+
+    The functions are thread safe.
+ */
+namespace QskGeometryCache
+{
+    class Statistics
+    {
+      public:
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+
+        int entryCount = 0;
+        qint64 bytes = 0;
+    };
+
+    class QSK_EXPORT Key
+    {
+      public:
+        inline Key( QskHashValue hash ) noexcept
+            : m_hash( hash )
+        {
+        }
+
+        virtual ~Key() = default;
+
+        virtual bool isEqual( const Key& ) const = 0;
+        virtual Key* clone() const = 0;
+
+        inline QskHashValue hash() const noexcept { return m_hash; }
+
+      private:
+        const QskHashValue m_hash;
+    };
+
+    // T needs to be copyable and to implement operator==
+    template< typename T >
+    class KeyValue final : public Key
+    {
+      public:
+        inline KeyValue( QskHashValue hash, const T& value )
+            : Key( hash )
+            , value( value )
+        {
+        }
+
+        bool isEqual( const Key& other ) const override
+        {
+            const auto key = dynamic_cast< const KeyValue< T >* >( &other );
+            return key && ( key->value == value );
+        }
+
+        Key* clone() const override
+        {
+            return new KeyValue< T >( *this );
+        }
+
+        const T value;
+    };
+
+    /*
+        Copies the vertices for the key - translated by offset - into
+        the geometry. Returns false, when there is no entry for the key.
+     */
+    QSK_EXPORT bool copyGeometry( const Key&, const QPointF& offset, QSGGeometry& );
+
+    // Stores the vertices of geometry, that have to be relative to ( 0, 0 )
+    QSK_EXPORT void insertGeometry( const Key&, const QSGGeometry& );
+
+    // translating the vertices of a geometry created for ( 0, 0 )
+    QSK_EXPORT void translateGeometry( const QPointF& offset, QSGGeometry& );
+
+    // a hash value of the elements and the fill rule of a path
+    QSK_EXPORT QskHashValue pathHash( const QPainterPath&, QskHashValue seed = 0 );
+
+    // size in bytes of all vertices, default: 4MB
+    QSK_EXPORT void setBudget( int bytes );
+    QSK_EXPORT int budget();
+
+    QSK_EXPORT void clear();
+
+    QSK_EXPORT Statistics statistics();
+    QSK_EXPORT void debugStatistics( QDebug );
+}
+
+#endif
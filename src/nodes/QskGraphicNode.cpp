@@ -56,6 +56,19 @@ void QskGraphicNode::paint( QPainter* painter, const QSize& size, const void* no
     graphic.render( painter, rect, colorFilter, Qt::IgnoreAspectRatio );
 }
 
+QskPaintedNode::PaintFunction QskGraphicNode::paintFunction( const void* nodeData ) const
+{
+    const auto graphicData = reinterpret_cast< const GraphicData* >( nodeData );
+
+    // QskGraphic/QskColorFilter are implicitly shared: copies are cheap
+    return [ graphic = graphicData->graphic, colorFilter = graphicData->colorFilter ](
+        QPainter* painter, const QSize& size )
+    {
+        const QRectF rect( 0, 0, size.width(), size.height() );
+        graphic.render( painter, rect, colorFilter, Qt::IgnoreAspectRatio );
+    };
+}
+
 QskHashValue QskGraphicNode::hash( const void* nodeData ) const
 {
     const auto graphicData = reinterpret_cast< const GraphicData* >( nodeData );
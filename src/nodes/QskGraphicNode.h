@@ -23,6 +23,7 @@ class QSK_EXPORT QskGraphicNode : public QskPaintedNode
   private:
     virtual void paint( QPainter*, const QSize&, const void* nodeData ) override;
     virtual QskHashValue hash( const void* nodeData ) const override;
+    virtual PaintFunction paintFunction( const void* nodeData ) const override;
 };
 
 #endif
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskLayerNode.h"
+#include "QskSceneTexture.h"
+
+#include <qsgtexturematerial.h>
+
+QskLayerNode::QskLayerNode()
+    : m_quadNode( new QSGGeometryNode() )
+{
+    setFlag( QSGNode::UsePreprocess, true );
+
+    auto geometry = new QSGGeometry(
+        QSGGeometry::defaultAttributes_TexturedPoint2D(), 4 );
+    geometry->setDrawingMode( QSGGeometry::DrawTriangleStrip );
+
+    /*
+        The texture is transparent beyond the items of the subtree,
+        so we always need blending ( see updateNode ). Unfortunately
+        QSGSimpleTextureNode switches to QSGOpaqueTextureMaterial for
+        an opacity of 1.
+     */
+    auto material = new QSGTextureMaterial();
+    material->setFiltering( QSGTexture::Linear );
+
+    m_quadNode->setGeometry( geometry );
+    m_quadNode->setMaterial( material );
+    m_quadNode->setFlags( QSGNode::OwnsGeometry | QSGNode::OwnsMaterial );
+
+    appendChildNode( m_quadNode );
+}
+
+QskLayerNode::~QskLayerNode()
+{
+    delete m_texture;
+}
+
+void QskLayerNode::updateNode( const QQuickWindow* window,
+    const QSGRootNode* rootNode, const QRectF& rect )
+{
+    if ( m_texture == nullptr )
+    {
+        m_texture = new QskSceneTexture( window );
+
+        auto material = static_cast< QSGTextureMaterial* >( m_quadNode->material() );
+        material->setTexture( m_texture );
+
+        /*
+            setTexture() decides about blending from hasAlphaChannel(),
+            what is false for QskSceneTexture.
+         */
+        material->setFlag( QSGMaterial::Blending, true );
+
+        m_quadNode->markDirty( QSGNode::DirtyMaterial );
+    }
+
+    if ( rootNode != m_rootNode )
+    {
+        m_rootNode = rootNode;
+        m_dirty = true;
+    }
+
+    if ( rect != m_rect )
+    {
+        m_rect = rect;
+        m_dirty = true;
+
+        QSGGeometry::updateTexturedRectGeometry( m_quadNode->geometry(),
+            m_rect, m_texture->normalizedTextureSubRect() );
+
+        m_quadNode->markDirty( QSGNode::DirtyGeometry );
+    }
+}
+
+void QskLayerNode::preprocess()
+{
+    if ( m_texture == nullptr || m_rootNode == nullptr || m_rect.isEmpty() )
+        return;
+
+    // the texture gets dirty, whenever a node of the subtree has been changed
+    if ( m_dirty || m_texture->isDirty() )
+    {
+        m_texture->render( m_rootNode, nullptr, m_rect );
+        m_dirty = false;
+
+        // the render target might have been recreated
+        m_quadNode->markDirty( QSGNode::DirtyMaterial );
+    }
+}
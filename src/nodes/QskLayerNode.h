@@ -0,0 +1,47 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_LAYER_NODE_H
+#define QSK_LAYER_NODE_H
+
+#include "QskGlobal.h"
+#include <qsgnode.h>
+
+class QskSceneTexture;
+class QSGRootNode;
+class QQuickWindow;
+
+/*
+    A textured quad displaying the subtree below a QSGRootNode
+    ( see qskSetScenegraphAnchor ).
+
+    The subtree is rendered into a QskSceneTexture right before the frame
+    is rendered ( see QSGNode::preprocess ), but only when a node of
+    the subtree has been changed. As long as nothing changes the main renderer
+    only has to composite the texture.
+ */
+class QSK_EXPORT QskLayerNode : public QSGOpacityNode
+{
+    using Inherited = QSGOpacityNode;
+
+  public:
+    QskLayerNode();
+    ~QskLayerNode() override;
+
+    void updateNode( const QQuickWindow*, const QSGRootNode*, const QRectF& );
+
+    void preprocess() override;
+
+  private:
+    QskSceneTexture* m_texture = nullptr;
+    const QSGRootNode* m_rootNode = nullptr;
+
+    QSGGeometryNode* m_quadNode;
+
+    QRectF m_rect;
+    bool m_dirty = true;
+};
+
+#endif
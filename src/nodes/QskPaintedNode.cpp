@@ -6,6 +6,8 @@
 #include "QskPaintedNode.h"
 #include "QskSGNode.h"
 #include "QskTextureRenderer.h"
+#include "QskTextureCache.h"
+#include "QskTextureAtlas.h"
 #include "QskInternalMacros.h"
 #include "QskQuick.h"
 
@@ -13,6 +15,12 @@
 #include <qquickwindow.h>
 #include <qimage.h>
 #include <qpainter.h>
+#include <qpointer.h>
+#include <qrunnable.h>
+#include <qthreadpool.h>
+#include <qcoreapplication.h>
+
+#include <typeinfo>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qsgplaintexture_p.h>
@@ -32,6 +40,15 @@ static inline QSGImageNode::TextureCoordinatesTransformMode
     return mode;
 }
 
+static inline const void* qskCacheCategory( const QskPaintedNode* node )
+{
+    /*
+        The hash values of different node classes are calculated
+        from unrelated data and must not be matched against each other.
+     */
+    return &typeid( *node );
+}
+
 namespace
 {
     const quint8 imageRole = 250; // reserved for internal use
@@ -43,14 +60,136 @@ namespace
 
         return static_cast< QSGImageNode* >( node );
     }
+
+    class PaintHelper : public QskTextureRenderer::PaintHelper
+    {
+      public:
+        PaintHelper( QskPaintedNode* node, const void* nodeData )
+            : m_node( node )
+            , m_nodeData( nodeData )
+        {
+        }
+
+        void paint( QPainter* painter, const QSize& size ) override
+        {
+            m_node->paint( painter, size, m_nodeData );
+        }
+
+      private:
+        QskPaintedNode* m_node;
+        const void* m_nodeData;
+    };
+
+    inline void releaseTexture( QSGImageNode* imageNode )
+    {
+        if ( !imageNode->ownsTexture() )
+        {
+            if ( !QskTextureAtlas::release( imageNode ) )
+                QskTextureCache::release( imageNode->texture() );
+        }
+    }
+
+    QSGImageNode* ensureImageNode( QSGNode* parentNode, QQuickWindow* window )
+    {
+        auto imageNode = findImageNode( parentNode );
+        if ( imageNode == nullptr )
+        {
+            imageNode = window->createImageNode();
+
+            imageNode->setOwnsTexture( true );
+            QskSGNode::setNodeRole( imageNode, imageRole );
+
+            parentNode->appendChildNode( imageNode );
+        }
+
+        return imageNode;
+    }
+
+    void setTexture( QSGImageNode* imageNode, QSGTexture* texture, bool isShared )
+    {
+        const auto oldTexture = imageNode->texture();
+        const bool ownsOldTexture = imageNode->ownsTexture();
+
+        imageNode->setOwnsTexture( false );
+        imageNode->setTexture( texture );
+        imageNode->setOwnsTexture( !isShared );
+
+        if ( oldTexture )
+        {
+            // the pages of the atlas are unknown to the cache
+            if ( !ownsOldTexture )
+                QskTextureCache::release( oldTexture );
+            else if ( oldTexture != texture )
+                delete oldTexture;
+        }
+    }
 }
 
+template< typename Paint >
+static QImage qskCreateImage( const QSize& size, qreal ratio, Paint paint )
+{
+    QImage image( size, QImage::Format_RGBA8888_Premultiplied );
+    image.fill( Qt::transparent );
+
+    QPainter painter( &image );
+
+    /*
+        setting a devicePixelRatio for the image only works for
+        value >= 1.0. So we have to scale manually.
+     */
+    painter.scale( ratio, ratio );
+
+    paint( &painter, size / ratio );
+
+    painter.end();
+
+    return image;
+}
+
+class QskPaintedNode::PaintJob
+{
+  public:
+    PaintJob( const QSize& size, qreal ratio, QskHashValue hash )
+        : size( size )
+        , devicePixelRatio( ratio )
+        , hash( hash )
+    {
+    }
+
+    inline void cancel() { m_cancelled.storeRelaxed( 1 ); }
+    inline bool isCancelled() const { return m_cancelled.loadRelaxed(); }
+
+    inline void setImage( const QImage& image )
+    {
+        m_image = image;
+        m_finished.storeRelease( 1 );
+    }
+
+    // the image must not be accessed before the job is finished
+    inline bool isFinished() const { return m_finished.loadAcquire(); }
+    inline const QImage& image() const { return m_image; }
+
+    const QSize size;
+    const qreal devicePixelRatio;
+    const QskHashValue hash;
+
+  private:
+    QImage m_image;
+
+    QAtomicInt m_cancelled = 0;
+    QAtomicInt m_finished = 0;
+};
+
 QskPaintedNode::QskPaintedNode()
 {
 }
 
 QskPaintedNode::~QskPaintedNode()
 {
+    cancelPaintJob();
+
+    if ( auto imageNode = findImageNode( this ) )
+        releaseTexture( imageNode );
 }
 
 void QskPaintedNode::setRenderHint( RenderHint renderHint )
@@ -86,6 +225,11 @@ QSize QskPaintedNode::textureSize() const
 {
     if ( const auto imageNode = findImageNode( this ) )
     {
+        // when being in the atlas we have a sub rectangle of a page
+        const auto sourceRect = imageNode->sourceRect();
+        if ( !sourceRect.isEmpty() )
+            return sourceRect.size().toSize();
+
         if ( auto texture = imageNode->texture() )
             return texture->textureSize();
     }
@@ -104,10 +248,17 @@ void QskPaintedNode::update( QQuickWindow* window,
 {
     auto imageNode = findImageNode( this );
 
+    m_window = window;
+    m_rect = rect;
+
     if ( rect.isEmpty() )
     {
+        cancelPaintJob();
+
         if ( imageNode )
         {
+            releaseTexture( imageNode );
+
             removeChildNode( imageNode );
             delete imageNode;
         }
@@ -115,16 +266,6 @@ void QskPaintedNode::update( QQuickWindow* window,
         return;
     }
 
-    if ( imageNode == nullptr )
-    {
-        imageNode = window->createImageNode();
-
-        imageNode->setOwnsTexture( true );
-        QskSGNode::setNodeRole( imageNode, imageRole );
-
-        appendChildNode( imageNode );
-    }
-
     QSize imageSize;
 
     {
@@ -142,37 +283,208 @@ void QskPaintedNode::update( QQuickWindow* window,
         m_hash = newHash;
         isTextureDirty = true;
     }
+    else if ( m_paintJob )
+    {
+        // waiting for the result of a job for the same content
+        isTextureDirty = ( imageSize != m_paintJob->size );
+    }
     else
     {
         isTextureDirty = ( imageSize != textureSize() );
     }
 
-
     if ( isTextureDirty )
-        updateTexture( window, imageSize, nodeData );
+    {
+        PaintFunction function;
+        if ( m_renderHint == RasterAsync )
+            function = paintFunction( nodeData );
+
+        if ( function )
+        {
+            startPaintJob( window, imageSize, std::move( function ) );
+        }
+        else
+        {
+            cancelPaintJob();
+
+            imageNode = ensureImageNode( this, window );
+            updateTexture( window, imageSize, nodeData );
+        }
+
+        imageNode = findImageNode( this );
+    }
+
+    if ( imageNode )
+    {
+        // until a job has finished the previous texture gets stretched
+        imageNode->setRect( rect );
+        imageNode->setTextureCoordinatesTransform(
+            qskEffectiveTransformMode( m_mirrored ) );
+    }
+}
+
+void QskPaintedNode::startPaintJob( QQuickWindow* window,
+    const QSize& size, PaintFunction&& function )
+{
+    cancelPaintJob();
+
+    const auto ratio = window->effectiveDevicePixelRatio();
+
+    if ( m_hash != 0 )
+    {
+        if ( auto texture = QskTextureCache::acquire(
+            window, qskCacheCategory( this ), m_hash, size, ratio ) )
+        {
+            // already painted for another node
+            auto imageNode = ensureImageNode( this, window );
+
+            if ( !imageNode->ownsTexture() )
+                QskTextureAtlas::release( imageNode );
+
+            imageNode->setSourceRect( QRectF() );
+            setTexture( imageNode, texture, true );
+
+            return;
+        }
+    }
 
-    imageNode->setRect( rect );
+    m_paintJob = std::make_shared< PaintJob >( size, ratio, m_hash );
+
+    // checking for the result before each frame
+    setFlag( QSGNode::UsePreprocess, true );
+
+    auto runnable = QRunnable::create(
+        [ job = m_paintJob, window = QPointer< QQuickWindow >( window ),
+            function = std::move( function ) ]()
+        {
+            // the size might have been changed again, before we were started
+            if ( job->isCancelled() )
+                return;
+
+            const auto image = qskCreateImage(
+                job->size, job->devicePixelRatio, function );
+
+            if ( job->isCancelled() )
+                return;
+
+            job->setImage( image );
+
+            // the texture is uploaded in QskPaintedNode::preprocess
+            QMetaObject::invokeMethod( QCoreApplication::instance(),
+                [ window ]() { if ( window ) window->update(); },
+                Qt::QueuedConnection );
+        } );
+
+    QThreadPool::globalInstance()->start( runnable );
+}
+
+void QskPaintedNode::cancelPaintJob()
+{
+    if ( m_paintJob )
+    {
+        m_paintJob->cancel();
+        m_paintJob.reset();
+    }
+}
+
+void QskPaintedNode::preprocess()
+{
+    if ( m_paintJob == nullptr || !m_paintJob->isFinished() )
+        return;
+
+    const auto job = std::move( m_paintJob );
+
+    if ( m_window == nullptr || m_rect.isEmpty() )
+        return;
+
+    auto texture = m_window->createTextureFromImage( job->image() );
+
+    const bool isShared = ( job->hash != 0 );
+    if ( isShared )
+    {
+        texture = QskTextureCache::insert( m_window, qskCacheCategory( this ),
+            job->hash, job->size, job->devicePixelRatio, texture );
+    }
+
+    auto imageNode = ensureImageNode( this, m_window );
+
+    if ( !imageNode->ownsTexture() )
+        QskTextureAtlas::release( imageNode );
+
+    imageNode->setSourceRect( QRectF() );
+    setTexture( imageNode, texture, isShared );
+
+    imageNode->setRect( m_rect );
     imageNode->setTextureCoordinatesTransform(
         qskEffectiveTransformMode( m_mirrored ) );
 }
 
+QskPaintedNode::PaintFunction QskPaintedNode::paintFunction( const void* ) const
+{
+    return PaintFunction();
+}
+
 void QskPaintedNode::updateTexture( QQuickWindow* window,
     const QSize& size, const void* nodeData )
 {
     auto imageNode = findImageNode( this );
 
+    // the node might be registered for an entry of the atlas
+    if ( !imageNode->ownsTexture() )
+        QskTextureAtlas::release( imageNode );
+
+    if ( m_hash != 0 )
+    {
+        /*
+            Nodes with the same hash value have the same content, so we
+            can share the textures - f.e. the icons of a list box.
+            Small ones are packed into the atlas, so that they can be
+            batched by the renderer.
+         */
+        PaintHelper helper( this, nodeData );
+
+        if ( auto texture = QskTextureAtlas::acquire( imageNode,
+            window, qskCacheCategory( this ), m_hash, size, &helper ) )
+        {
+            setTexture( imageNode, texture, true );
+            return;
+        }
+
+        imageNode->setSourceRect( QRectF() );
+
+        const auto ratio = window->effectiveDevicePixelRatio();
+
+        const auto category = qskCacheCategory( this );
+
+        auto texture = QskTextureCache::acquire( window, category, m_hash, size, ratio );
+        if ( texture == nullptr )
+        {
+            texture = QskTextureCache::insert( window, category, m_hash, size, ratio,
+                createTexture( window, size, nodeData ) );
+        }
+
+        setTexture( imageNode, texture, true );
+        return;
+    }
+
+    imageNode->setSourceRect( QRectF() );
+
+    // a shared texture must not be modified
+    QSGPlainTexture* texture = nullptr;
+    if ( imageNode->ownsTexture() )
+        texture = qobject_cast< QSGPlainTexture* >( imageNode->texture() );
+
     if ( ( m_renderHint == OpenGL ) && qskIsOpenGLWindow( window ) )
     {
         const auto textureId = createTextureGL( window, size, nodeData );
 
-        auto texture = qobject_cast< QSGPlainTexture* >( imageNode->texture() );
         if ( texture == nullptr )
         {
             texture = new QSGPlainTexture;
             texture->setHasAlphaChannel( true );
             texture->setOwnsTexture( true );
 
-            imageNode->setTexture( texture );
+            setTexture( imageNode, texture, false );
         }
 
         QskTextureRenderer::setTextureId( window, textureId, size, texture );
@@ -181,57 +493,44 @@ void QskPaintedNode::updateTexture( QQuickWindow* window,
     {
         const auto image = createImage( window, size, nodeData );
 
-        if ( auto texture = qobject_cast< QSGPlainTexture* >( imageNode->texture() ) )
+        if ( texture )
             texture->setImage( image );
         else
-            imageNode->setTexture( window->createTextureFromImage( image ) );
+            setTexture( imageNode, window->createTextureFromImage( image ), false );
     }
 }
 
-QImage QskPaintedNode::createImage( QQuickWindow* window,
+QSGTexture* QskPaintedNode::createTexture( QQuickWindow* window,
     const QSize& size, const void* nodeData )
 {
-    QImage image( size, QImage::Format_RGBA8888_Premultiplied );
-    image.fill( Qt::transparent );
-
-    QPainter painter( &image );
+    if ( ( m_renderHint == OpenGL ) && qskIsOpenGLWindow( window ) )
+    {
+        auto texture = new QSGPlainTexture;
+        texture->setHasAlphaChannel( true );
+        texture->setOwnsTexture( true );
 
-    /*
-        setting a devicePixelRatio for the image only works for
-        value >= 1.0. So we have to scale manually.
-     */
-    const auto ratio = window->effectiveDevicePixelRatio();
-    painter.scale( ratio, ratio );
+        QskTextureRenderer::setTextureId( window,
+            createTextureGL( window, size, nodeData ), size, texture );
 
-    paint( &painter, size / ratio, nodeData );
+        return texture;
+    }
 
-    painter.end();
+    return window->createTextureFromImage( createImage( window, size, nodeData ) );
+}
 
-    return image;
+QImage QskPaintedNode::createImage( QQuickWindow* window,
+    const QSize& size, const void* nodeData )
+{
+    return qskCreateImage( size, window->effectiveDevicePixelRatio(),
+        [ this, nodeData ]( QPainter* painter, const QSize& paintSize )
+        {
+            paint( painter, paintSize, nodeData );
+        } );
 }
 
 quint32 QskPaintedNode::createTextureGL(
     QQuickWindow* window, const QSize& size, const void* nodeData )
 {
-    class PaintHelper : public QskTextureRenderer::PaintHelper
-    {
-      public:
-        PaintHelper( QskPaintedNode* node, const void* nodeData )
-            : m_node( node )
-            , m_nodeData( nodeData )
-        {
-        }
-
-        void paint( QPainter* painter, const QSize& size ) override
-        {
-            m_node->paint( painter, size, m_nodeData );
-        }
-
-      private:
-        QskPaintedNode* m_node;
-        const void* m_nodeData;
-    };
-
     PaintHelper helper( this, nodeData );
     return QskTextureRenderer::createTextureGL( window, size, &helper );
 }
@@ -9,9 +9,13 @@
 #include "QskGlobal.h"
 #include <qsgnode.h>
 
+#include <functional>
+#include <memory>
+
 class QQuickWindow;
 class QPainter;
 class QImage;
+class QSGTexture;
 
 class QSK_EXPORT QskPaintedNode : public QSGNode
 {
@@ -26,11 +30,17 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
 
         OpenGL might be ignored depending on the backend used by the
         application.
+
+        RasterAsync paints into an image on a worker thread, so that expensive
+        contents do not stall the frame. The previous texture is displayed until
+        the new one is available. Nodes, that do not implement paintFunction(),
+        fall back to Raster.
      */
     enum RenderHint : quint8
     {
         Raster,
-        OpenGL
+        OpenGL,
+        RasterAsync
     };
 
     QskPaintedNode();
@@ -47,21 +57,51 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
 
     virtual void paint( QPainter*, const QSize&, const void* nodeData ) = 0;
 
+    void preprocess() override;
+
   protected:
+    using PaintFunction = std::function< void( QPainter*, const QSize& ) >;
+
+    /*
+        A function for RasterAsync, that paints the same as paint(), but is called
+        from a worker thread. So it must not depend on nodeData, that is only valid
+        during update(), and all values have to be captured by copy.
+        The default implementation returns an empty function.
+     */
+    virtual PaintFunction paintFunction( const void* nodeData ) const;
+
     void update( QQuickWindow*, const QRectF&, const QSizeF&, const void* nodeData );
 
-    // a hash value of '0' always results in repainting
+    /*
+        A hash value of '0' always results in repainting. Otherwise
+        the texture is shared with all other nodes of the window
+        of the same class having the same hash value and texture size -
+        see QskTextureCache and QskTextureAtlas.
+        So the hash value has to include everything, that has an effect
+        on the rasterized result, but it does not need to be unique
+        between different classes.
+     */
     virtual QskHashValue hash( const void* nodeData ) const = 0;
 
   private:
     void updateTexture( QQuickWindow*, const QSize&, const void* nodeData );
+    QSGTexture* createTexture( QQuickWindow*, const QSize&, const void* nodeData );
 
     QImage createImage( QQuickWindow*, const QSize&, const void* nodeData );
     quint32 createTextureGL( QQuickWindow*, const QSize&, const void* nodeData );
 
+    void startPaintJob( QQuickWindow*, const QSize&, PaintFunction&& );
+    void cancelPaintJob();
+
     RenderHint m_renderHint = OpenGL;
     Qt::Orientations m_mirrored;
     QskHashValue m_hash = 0;
+
+    class PaintJob;
+    std::shared_ptr< PaintJob > m_paintJob;
+
+    QQuickWindow* m_window = nullptr;
+    QRectF m_rect;
 };
 
 #endif
@@ -6,6 +6,7 @@
 #include "QskPlainTextRenderer.h"
 #include "QskTextColors.h"
 #include "QskTextOptions.h"
+#include "QskTextCache.h"
 #include "QskInternalMacros.h"
 
 #include <qfontmetrics.h>
@@ -96,8 +97,9 @@ static qreal qskLayoutText( QTextLayout* layout,
 }
 
 static void qskRenderText(
-    QQuickItem* item, QSGNode* parentNode, const QTextLayout& layout, qreal baseLine,
-    const QColor& color, QQuickText::TextStyle style, const QColor& styleColor )
+    QQuickItem* item, QSGNode* parentNode, const QList< QGlyphRun >& glyphRuns,
+    qreal baseLine, const QColor& color, QQuickText::TextStyle style,
+    const QColor& styleColor )
 {
     auto renderContext = QQuickItemPrivate::get(item)->sceneGraphRenderContext();
     auto sgContext = renderContext->sceneGraphContext();
@@ -119,49 +121,44 @@ static void qskRenderText(
 
     const QPointF position( 0, baseLine );
 
-    for ( int i = 0; i < layout.lineCount(); ++i )
+    for ( const auto& glyphRun : glyphRuns )
     {
-        const auto glyphRuns = layout.lineAt( i ).glyphRuns();
-
-        for ( const auto& glyphRun : glyphRuns )
+        if ( glyphNode == nullptr )
         {
-            if ( glyphNode == nullptr )
-            {
-                const bool preferNativeGlyphNode = false; // QskTextOptions?
-                constexpr int renderQuality = -1; // QQuickText::DefaultRenderTypeQuality
+            const bool preferNativeGlyphNode = false; // QskTextOptions?
+            constexpr int renderQuality = -1; // QQuickText::DefaultRenderTypeQuality
 
 #if QT_VERSION >= QT_VERSION_CHECK( 6, 7, 0 )
-                const auto renderType = preferNativeGlyphNode
-                    ? QSGTextNode::QtRendering : QSGTextNode::NativeRendering;
-                glyphNode = sgContext->createGlyphNode(
-                    renderContext, renderType, renderQuality );
+            const auto renderType = preferNativeGlyphNode
+                ? QSGTextNode::QtRendering : QSGTextNode::NativeRendering;
+            glyphNode = sgContext->createGlyphNode(
+                renderContext, renderType, renderQuality );
 #elif QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
-                glyphNode = sgContext->createGlyphNode(
-                    renderContext, preferNativeGlyphNode, renderQuality );
+            glyphNode = sgContext->createGlyphNode(
+                renderContext, preferNativeGlyphNode, renderQuality );
 #else
-                Q_UNUSED( renderQuality );
-                glyphNode = sgContext->createGlyphNode(
-                    renderContext, preferNativeGlyphNode );
+            Q_UNUSED( renderQuality );
+            glyphNode = sgContext->createGlyphNode(
+                renderContext, preferNativeGlyphNode );
 #endif
 
 #if QT_VERSION < QT_VERSION_CHECK( 6, 7, 0 )
-                glyphNode->setOwnerElement( item );
+            glyphNode->setOwnerElement( item );
 #endif
 
-                glyphNode->setFlags( QSGNode::OwnedByParent | GlyphFlag );
-            }
+            glyphNode->setFlags( QSGNode::OwnedByParent | GlyphFlag );
+        }
 
-            glyphNode->setStyle( style );
-            glyphNode->setColor( color );
-            glyphNode->setStyleColor( styleColor );
-            glyphNode->setGlyphs( position, glyphRun );
-            glyphNode->update();
+        glyphNode->setStyle( style );
+        glyphNode->setColor( color );
+        glyphNode->setStyleColor( styleColor );
+        glyphNode->setGlyphs( position, glyphRun );
+        glyphNode->update();
 
-            if ( glyphNode->parent() != parentNode )
-                parentNode->appendChildNode( glyphNode );
+        if ( glyphNode->parent() != parentNode )
+            parentNode->appendChildNode( glyphNode );
 
-            glyphNode = static_cast< QSGGlyphNode* >( glyphNode->nextSibling() );
-        }
+        glyphNode = static_cast< QSGGlyphNode* >( glyphNode->nextSibling() );
     }
 
     // Remove leftover glyphs
@@ -183,36 +180,50 @@ void QskPlainTextRenderer::updateNode( const QString& text,
     Qt::Alignment alignment, const QRectF& rect,
     const QQuickItem* item, QSGTransformNode* node )
 {
-    QTextOption textOption( alignment );
-    textOption.setWrapMode( static_cast< QTextOption::WrapMode >( options.wrapMode() ) );
+    QskTextCache::Layout textLayout;
 
-    QString tmp = text;
+    if ( !QskTextCache::layout( text, font, options, alignment, rect.width(), textLayout ) )
+    {
+        QTextOption textOption( alignment );
+        textOption.setWrapMode( static_cast< QTextOption::WrapMode >( options.wrapMode() ) );
+
+        QString tmp = text;
 
 #if 0
-    const int pos = tmp.indexOf( QLatin1Char( '\x9c' ) );
-    if ( pos != -1 )
-    {
-        // ST: string termination
+        const int pos = tmp.indexOf( QLatin1Char( '\x9c' ) );
+        if ( pos != -1 )
+        {
+            // ST: string termination
 
-        tmp = tmp.mid( 0, pos );
-        tmp.replace( QLatin1Char( '\n' ), QChar::LineSeparator );
-    }
-    else
+            tmp = tmp.mid( 0, pos );
+            tmp.replace( QLatin1Char( '\n' ), QChar::LineSeparator );
+        }
+        else
 #endif
-    if ( tmp.contains( QLatin1Char( '\n' ) ) )
-    {
-        tmp.replace( QLatin1Char('\n'), QChar::LineSeparator );
-    }
+        if ( tmp.contains( QLatin1Char( '\n' ) ) )
+        {
+            tmp.replace( QLatin1Char('\n'), QChar::LineSeparator );
+        }
+
+        QTextLayout layout;
+        layout.setFont( font );
+        layout.setTextOption( textOption );
+        layout.setText( tmp );
+
+        layout.beginLayout();
+        textLayout.textHeight = qskLayoutText( &layout, rect.width(), options );
+        layout.endLayout();
 
+        textLayout.boundingHeight = layout.boundingRect().height();
 
-    QTextLayout layout;
-    layout.setFont( font );
-    layout.setTextOption( textOption );
-    layout.setText( tmp );
+        for ( int i = 0; i < layout.lineCount(); ++i )
+            textLayout.glyphRuns += layout.lineAt( i ).glyphRuns();
+
+        QskTextCache::insertLayout( text, font, options,
+            alignment, rect.width(), textLayout );
+    }
 
-    layout.beginLayout();
-    const qreal textHeight = qskLayoutText( &layout, rect.width(), options );
-    layout.endLayout();
+    const auto textHeight = textLayout.textHeight;
 
     const qreal y0 = QFontMetricsF( font ).ascent();
 
@@ -235,12 +246,12 @@ void QskPlainTextRenderer::updateNode( const QString& text,
             between margins/paddings.
          */
 
-        const int bh = int( layout.boundingRect().height() );
+        const int bh = int( textLayout.boundingHeight );
         yBaseline = ( bh % 2 ) ? qFloor( yBaseline ) : qCeil( yBaseline );
     }
 
     qskRenderText(
-        const_cast< QQuickItem* >( item ), node, layout, yBaseline,
+        const_cast< QQuickItem* >( item ), node, textLayout.glyphRuns, yBaseline,
         colors.textColor(), static_cast< QQuickText::TextStyle >( style ),
         colors.styleColor() );
 }
@@ -223,7 +223,8 @@ namespace
     {
         m_dirty = false;
 
-        qskTryBlockTrailingNodes( m_finalNode, rootNode(), true, false );
+        if ( m_finalNode )
+            qskTryBlockTrailingNodes( m_finalNode, rootNode(), true, false );
 
 #if 0
         static int counter = 0;
@@ -231,7 +232,9 @@ namespace
         QSGNodeDumper::dump( rootNode() );
 #endif
         Inherited::render();
-        qskTryBlockTrailingNodes( m_finalNode, rootNode(), false, false );
+
+        if ( m_finalNode )
+            qskTryBlockTrailingNodes( m_finalNode, rootNode(), false, false );
     }
 
     void Renderer::nodeChanged( QSGNode* node, QSGNode::DirtyState state )
@@ -245,7 +248,8 @@ namespace
             the texture has already  been updated. In these situations we
             update the texture twice. Not so good ...
          */
-        if ( qskRenderOrderCompare( rootNode(), node, m_finalNode ) > 0 ) 
+        if ( m_finalNode == nullptr
+            || qskRenderOrderCompare( rootNode(), node, m_finalNode ) > 0 )
         {
             // triggering QSGRenderer::sceneGraphChanged signals
             Inherited::nodeChanged( node, state );
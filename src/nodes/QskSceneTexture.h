@@ -25,7 +25,11 @@ class QSK_EXPORT QskSceneTexture : public QSGTexture
     QskSceneTexture( const QQuickWindow* );
     ~QskSceneTexture();
 
-    void render( const QSGRootNode*, const QSGTransformNode*, const QRectF& );
+    /*
+        Rendering the subtree of the root node, but stopping at the final node.
+        Without a final node the complete subtree is rendered.
+     */
+    void render( const QSGRootNode*, const QSGTransformNode* finalNode, const QRectF& );
 
     QSize textureSize() const override;
 
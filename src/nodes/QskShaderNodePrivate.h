@@ -0,0 +1,200 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_SHADER_NODE_PRIVATE_H
+#define QSK_SHADER_NODE_PRIVATE_H
+
+/*
+    Code shared by the nodes, that are rendering from
+    a signed distance function: QskBoxShaderNode, QskArcShaderNode
+ */
+
+#include "QskGlobal.h"
+
+#include <qcolor.h>
+#include <qsgmaterial.h>
+#include <qsgmaterialshader.h>
+#include <qvector4d.h>
+
+#include <cmath>
+#include <cstring>
+
+// QSGMaterialRhiShader became QSGMaterialShader in Qt6
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    #include <QSGMaterialRhiShader>
+    using QskRhiShader = QSGMaterialRhiShader;
+#else
+    using QskRhiShader = QSGMaterialShader;
+#endif
+
+static inline QVector4D qskColorVector( const QColor& color )
+{
+    // premultiplied
+    const auto c = color.toRgb();
+    const auto a = c.alphaF();
+
+    return QVector4D( c.redF() * a, c.greenF() * a, c.blueF() * a, a );
+}
+
+template< typename State >
+static inline float qskPixelScale( const State& state )
+{
+    // the number of device pixels for one unit of the item coordinates
+    const auto m = state.combinedMatrix();
+    const auto r = state.viewportRect();
+
+    const auto sx = 0.5 * r.width() * std::hypot( m( 0, 0 ), m( 1, 0 ) );
+    const auto sy = 0.5 * r.height() * std::hypot( m( 0, 1 ), m( 1, 1 ) );
+
+    const auto scale = 0.5 * ( sx + sy );
+    return ( scale > 0.0 ) ? scale : 1.0;
+}
+
+template< typename Uniforms >
+class QskShaderMaterial : public QSGMaterial
+{
+  public:
+    QskShaderMaterial()
+    {
+        setFlag( QSGMaterial::Blending, true );
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+        setFlag( QSGMaterial::SupportsRhiShader, true );
+#endif
+    }
+
+    QSGMaterialType* type() const override
+    {
+        // one type for each type of Uniforms
+        static QSGMaterialType staticType;
+        return &staticType;
+    }
+
+    int compare( const QSGMaterial* other ) const override
+    {
+        auto material = static_cast< const QskShaderMaterial* >( other );
+
+        if ( material->m_uniforms == m_uniforms )
+            return 0;
+
+        return QSGMaterial::compare( other );
+    }
+
+    Uniforms m_uniforms;
+};
+
+class QskShaderRhi : public QskRhiShader
+{
+  public:
+    QskShaderRhi( const char* name )
+    {
+        const QString path = QStringLiteral( ":/qskinny/shaders/" ) + QLatin1String( name );
+
+        setShaderFileName( VertexStage, path + QStringLiteral( ".vert.qsb" ) );
+        setShaderFileName( FragmentStage, path + QStringLiteral( ".frag.qsb" ) );
+    }
+
+  protected:
+    /*
+        The uniform blocks start with the matrix. The offsets
+        of the pixel scale and the opacity depend on the shader.
+     */
+    bool updateStateData( RenderState& state, int pixelScaleOffset, int opacityOffset )
+    {
+        auto data = state.uniformData()->data();
+        bool changed = false;
+
+        if ( state.isMatrixDirty() )
+        {
+            const auto matrix = state.combinedMatrix();
+            memcpy( data + 0, matrix.constData(), 64 );
+
+            const auto pixelScale = qskPixelScale( state );
+            memcpy( data + pixelScaleOffset, &pixelScale, 4 );
+
+            changed = true;
+        }
+
+        if ( state.isOpacityDirty() )
+        {
+            const float opacity = state.opacity();
+            memcpy( data + opacityOffset, &opacity, 4 );
+
+            changed = true;
+        }
+
+        return changed;
+    }
+};
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+// the old type of shader - spcific for OpenGL
+
+class QskShaderGL : public QSGMaterialShader
+{
+  public:
+    QskShaderGL( const char* name )
+    {
+        const QString path = QStringLiteral( ":/qskinny/shaders/" ) + QLatin1String( name );
+
+        setShaderSourceFile( QOpenGLShader::Vertex, path + QStringLiteral( ".vert" ) );
+        setShaderSourceFile( QOpenGLShader::Fragment, path + QStringLiteral( ".frag" ) );
+    }
+
+    char const* const* attributeNames() const override
+    {
+        static char const* const names[] = { "in_vertex", "in_coord", nullptr };
+        return names;
+    }
+
+    void initialize() override
+    {
+        QSGMaterialShader::initialize();
+
+        auto p = program();
+
+        m_matrixId = p->uniformLocation( "matrix" );
+        m_opacityId = p->uniformLocation( "opacity" );
+        m_pixelScaleId = p->uniformLocation( "pixelScale" );
+    }
+
+    void updateState( const QSGMaterialShader::RenderState& state,
+        QSGMaterial* newMaterial, QSGMaterial* oldMaterial ) override final
+    {
+        auto p = program();
+
+        if ( state.isMatrixDirty() )
+        {
+            p->setUniformValue( m_matrixId, state.combinedMatrix() );
+            p->setUniformValue( m_pixelScaleId, qskPixelScale( state ) );
+        }
+
+        if ( state.isOpacityDirty() )
+            p->setUniformValue( m_opacityId, state.opacity() );
+
+        bool updateMaterial = ( oldMaterial == nullptr )
+            || newMaterial->compare( oldMaterial ) != 0;
+
+        updateMaterial |= state.isCachedMaterialDataDirty();
+
+        if ( updateMaterial )
+            updateUniforms( p, newMaterial );
+    }
+
+  protected:
+    // setting the uniforms, that are specific for the material
+    virtual void updateUniforms( QOpenGLShaderProgram*, const QSGMaterial* ) = 0;
+
+  private:
+    int m_matrixId = -1;
+    int m_opacityId = -1;
+    int m_pixelScaleId = -1;
+};
+
+#endif
+
+#endif
@@ -8,8 +8,12 @@
 #include "QskGradientDirection.h"
 #include "QskVertex.h"
 #include "QskFillNodePrivate.h"
+#include "QskGeometryCache.h"
 #include "QskInternalMacros.h"
 
+#include <qpainterpath.h>
+#include <qtransform.h>
+
 QSK_QT_PRIVATE_BEGIN
 #include <private/qvectorpath_p.h>
 #include <private/qtriangulator_p.h>
@@ -86,15 +90,60 @@ static void qskUpdateGeometry( const QPainterPath& path,
 
 #endif
 
+namespace
+{
+    class ShapeKey
+    {
+      public:
+        inline bool operator==( const ShapeKey& other ) const
+        {
+            return ( color == other.color ) && ( transform == other.transform )
+                && ( path == other.path );
+        }
+
+        QPainterPath path; // implicitly shared
+        QTransform transform;
+        QColor color;
+    };
+
+    using CacheKey = QskGeometryCache::KeyValue< ShapeKey >;
+}
+
+static QskHashValue qskShapeHash( const QPainterPath& path,
+    const QTransform& transform, const QColor& color )
+{
+    QskHashValue hash = 15000;
+
+    hash = QskGeometryCache::pathHash( path, hash );
+
+    const qreal m[] = { transform.m11(), transform.m12(),
+        transform.m21(), transform.m22() };
+    hash = qHashBits( m, sizeof( m ), hash );
+
+    if ( color.isValid() )
+        hash = ::qHash( color.rgba(), hash );
+
+    return ( hash != 0 ) ? hash : 1;
+}
+
 class QskShapeNodePrivate final : public QskFillNodePrivate
 {
   public:
+    inline void resetKey()
+    {
+        hasKey = false;
+        key = ShapeKey();
+        offset = QPointF();
+    }
+
     /*
-        Is there a better way to find out if the path has changed
-        beside storing a copy ( even, when internally with Copy On Write ) ?
+        Path, color and the transformation without translation of the
+        current geometry. As the path is implicitly shared, comparing it
+        with the one of the next update is usually a pointer comparison.
      */
-    QPainterPath path;
-    QTransform transform;
+    ShapeKey key;
+    QPointF offset;
+    bool hasKey = false;
 };
 
 QskShapeNode::QskShapeNode()
@@ -123,8 +172,7 @@ void QskShapeNode::updatePath( const QPainterPath& path,
 
     if ( path.isEmpty() || !gradient.isVisible() )
     {
-        d->path = QPainterPath();
-        d->transform = QTransform();
+        d->resetKey();
         resetGeometry();
 
         return;
@@ -142,10 +190,44 @@ void QskShapeNode::updatePath( const QPainterPath& path,
     else
         setColoring( rect, gradient );
 
-    if ( isDirty || ( transform != d->transform ) || ( path != d->path ) )
+    if ( transform.isAffine() )
+    {
+        /*
+            The triangulation of a path, that has been translated is the
+            translated triangulation. So we triangulate without translation
+            and can share the result with all nodes having the same path.
+         */
+        const QTransform linear( transform.m11(), transform.m12(),
+            transform.m21(), transform.m22(), 0.0, 0.0 );
+
+        const QPointF offset( transform.dx(), transform.dy() );
+        const ShapeKey shapeKey { path, linear, c };
+
+        if ( isDirty || !d->hasKey || !( shapeKey == d->key ) || ( offset != d->offset ) )
+        {
+            d->hasKey = true;
+            d->key = shapeKey;
+            d->offset = offset;
+
+            auto& geometry = *this->geometry();
+
+            const CacheKey key( qskShapeHash( path, linear, c ), shapeKey );
+
+            if ( !QskGeometryCache::copyGeometry( key, offset, geometry ) )
+            {
+                qskUpdateGeometry( path, linear, c, geometry );
+
+                QskGeometryCache::insertGeometry( key, geometry );
+                QskGeometryCache::translateGeometry( offset, geometry );
+            }
+
+            geometry.markVertexDataDirty();
+            markDirty( QSGNode::DirtyGeometry );
+        }
+    }
+    else
     {
-        d->path = path;
-        d->transform = transform;
+        d->resetKey();
 
         qskUpdateGeometry( path, transform, c, *geometry() );
 
@@ -7,9 +7,13 @@
 #include "QskVertex.h"
 #include "QskGradient.h"
 #include "QskRgbValue.h"
+#include "QskFillNodePrivate.h"
+#include "QskGeometryCache.h"
 #include "QskInternalMacros.h"
 
 #include <qpainterpath.h>
+#include <qpen.h>
+#include <qtransform.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qtriangulatingstroker_p.h>
@@ -33,7 +37,80 @@ static inline bool qskIsPenVisible( const QPen& pen )
     return true;
 }
 
+namespace
+{
+    class StrokeKey
+    {
+      public:
+        inline bool operator==( const StrokeKey& other ) const
+        {
+            return ( isColored == other.isColored ) && ( pen == other.pen )
+                && ( transform == other.transform ) && ( path == other.path );
+        }
+
+        QPainterPath path; // implicitly shared
+        QTransform transform;
+        QPen pen;
+        bool isColored = false;
+    };
+
+    using CacheKey = QskGeometryCache::KeyValue< StrokeKey >;
+}
+
+static QskHashValue qskStrokeHash( const QPainterPath& path,
+    const QTransform& transform, const QPen& pen, bool isColored )
+{
+    QskHashValue hash = 16000;
+
+    hash = QskGeometryCache::pathHash( path, hash );
+
+    const qreal m[] = { transform.m11(), transform.m12(),
+        transform.m21(), transform.m22() };
+    hash = qHashBits( m, sizeof( m ), hash );
+
+    hash = ::qHash( pen.widthF(), hash );
+    hash = ::qHash( pen.miterLimit(), hash );
+    hash = ::qHash( pen.dashOffset(), hash );
+    hash = ::qHash( pen.isCosmetic(), hash );
+
+    const int styles[] = { pen.style(), pen.capStyle(), pen.joinStyle() };
+    hash = qHashBits( styles, sizeof( styles ), hash );
+
+    if ( pen.style() == Qt::CustomDashLine )
+    {
+        const auto pattern = pen.dashPattern();
+        hash = qHashBits( pattern.constData(),
+            pattern.size() * sizeof( qreal ), hash );
+    }
+
+    if ( isColored )
+        hash = ::qHash( pen.color().rgba(), hash );
+
+    return ( hash != 0 ) ? hash : 1;
+}
+
+class QskStrokeNodePrivate final : public QskFillNodePrivate
+{
+  public:
+    inline void resetKey()
+    {
+        hasKey = false;
+        key = StrokeKey();
+        offset = QPointF();
+    }
+
+    /*
+        Path, pen and the transformation without translation of the
+        current geometry. As the path is implicitly shared, comparing it
+        with the one of the next update is usually a pointer comparison.
+     */
+    StrokeKey key;
+    QPointF offset;
+    bool hasKey = false;
+};
+
 QskStrokeNode::QskStrokeNode()
+    : QskFillNode( *new QskStrokeNodePrivate )
 {
 }
 
@@ -47,8 +124,12 @@ void QskStrokeNode::updatePath( const QPainterPath& path, const QPen& pen )
 void QskStrokeNode::updatePath(
     const QPainterPath& path, const QTransform& transform, const QPen& pen )
 {
+    Q_D( QskStrokeNode );
+
     if ( path.isEmpty() || !qskIsPenVisible( pen ) )
     {
+        d->resetKey();
+
         resetGeometry();
         return;
     }
@@ -65,73 +146,126 @@ void QskStrokeNode::updatePath(
     else
         setColoring( pen.color() );
 
-    if ( true ) // For the moment we always update the geometry. TODO ...
+    /*
+        The stroke of a translated path is the translated stroke.
+        So the path is stroked without translation and the result
+        can be shared with all nodes having the same path and pen.
+     */
+    QTransform linear;
+    QPointF offset;
+
+    if ( transform.isAffine() )
+    {
+        linear.setMatrix( transform.m11(), transform.m12(), 0.0,
+            transform.m21(), transform.m22(), 0.0, 0.0, 0.0, 1.0 );
+        offset = QPointF( transform.dx(), transform.dy() );
+    }
+    else
     {
-        /*
-            Unfortunately QTriangulatingStroker does not offer on the fly
-            transformations - like with qTriangulate. TODO ...
-         */
-        const auto scaledPath = transform.map( path );
+        linear = transform;
+    }
 
-        auto effectivePen = pen;
+    auto keyPen = pen;
+    if ( !isGeometryColored() )
+        keyPen.setColor( Qt::black ); // not part of the vertices
 
-        if ( !effectivePen.isCosmetic() )
-        {
-            const auto scaleFactor = qMin( transform.m11(), transform.m22() );
-            if ( scaleFactor != 1.0 )
-            {
-                effectivePen.setWidth( effectivePen.widthF() * scaleFactor );
-                effectivePen.setCosmetic( false );
-            }
-        }
+    const StrokeKey strokeKey { path, linear, keyPen, isGeometryColored() };
+
+    if ( transform.isAffine() )
+    {
+        if ( d->hasKey && ( strokeKey == d->key ) && ( offset == d->offset ) )
+            return;
+
+        d->hasKey = true;
+        d->key = strokeKey;
+        d->offset = offset;
+    }
+    else
+    {
+        d->resetKey();
+    }
+
+    const auto hash = transform.isAffine()
+        ? qskStrokeHash( path, linear, pen, isGeometryColored() ) : 0;
+
+    auto& geometry = *this->geometry();
+
+    const CacheKey key( hash, strokeKey );
 
-        QTriangulatingStroker stroker;
+    if ( hash != 0 && QskGeometryCache::copyGeometry( key, offset, geometry ) )
+    {
+        markDirty( QSGNode::DirtyGeometry );
+        return;
+    }
+
+    /*
+        Unfortunately QTriangulatingStroker does not offer on the fly
+        transformations - like with qTriangulate. TODO ...
+     */
+    const auto scaledPath = linear.map( path );
 
-        if ( pen.style() == Qt::SolidLine )
+    auto effectivePen = pen;
+
+    if ( !effectivePen.isCosmetic() )
+    {
+        const auto scaleFactor = qMin( linear.m11(), linear.m22() );
+        if ( scaleFactor != 1.0 )
         {
-            // clipRect, renderHint are ignored in QTriangulatingStroker::process
-            stroker.process( qtVectorPathForPath( scaledPath ), effectivePen, {}, {} );
+            effectivePen.setWidth( effectivePen.widthF() * scaleFactor );
+            effectivePen.setCosmetic( false );
         }
-        else
-        {
-            constexpr QRectF clipRect; // empty rect: no clipping
+    }
 
-            QDashedStrokeProcessor dashStroker;
-            dashStroker.process( qtVectorPathForPath( scaledPath ),
-                effectivePen, clipRect, {} );
+    QTriangulatingStroker stroker;
 
-            const QVectorPath dashedVectorPath( dashStroker.points(),
-                dashStroker.elementCount(), dashStroker.elementTypes(), 0 );
+    if ( pen.style() == Qt::SolidLine )
+    {
+        // clipRect, renderHint are ignored in QTriangulatingStroker::process
+        stroker.process( qtVectorPathForPath( scaledPath ), effectivePen, {}, {} );
+    }
+    else
+    {
+        constexpr QRectF clipRect; // empty rect: no clipping
 
-            stroker.process( dashedVectorPath, effectivePen, {}, {} );
-        }
+        QDashedStrokeProcessor dashStroker;
+        dashStroker.process( qtVectorPathForPath( scaledPath ),
+            effectivePen, clipRect, {} );
 
-        auto& geometry = *this->geometry();
+        const QVectorPath dashedVectorPath( dashStroker.points(),
+            dashStroker.elementCount(), dashStroker.elementTypes(), 0 );
 
-        // 2 vertices for each point
-        geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
-        geometry.allocate( stroker.vertexCount() / 2 );
+        stroker.process( dashedVectorPath, effectivePen, {}, {} );
+    }
 
-        if ( isGeometryColored() )
-        {
-            const QskVertex::Color c( pen.color() );
+    // 2 vertices for each point
+    geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
+    geometry.allocate( stroker.vertexCount() / 2 );
 
-            const auto v = stroker.vertices();
-            auto points = geometry.vertexDataAsColoredPoint2D();
+    if ( isGeometryColored() )
+    {
+        const QskVertex::Color c( pen.color() );
 
-            for ( int i = 0; i < geometry.vertexCount(); i++ )
-            {
-                const auto j = 2 * i;
-                points[i].set( v[j], v[j + 1], c.r, c.g, c.b, c.a );
-            }
-        }
-        else
+        const auto v = stroker.vertices();
+        auto points = geometry.vertexDataAsColoredPoint2D();
+
+        for ( int i = 0; i < geometry.vertexCount(); i++ )
         {
-            memcpy( geometry.vertexData(), stroker.vertices(),
-                stroker.vertexCount() * sizeof( float ) );
+            const auto j = 2 * i;
+            points[i].set( v[j], v[j + 1], c.r, c.g, c.b, c.a );
         }
+    }
+    else
+    {
+        memcpy( geometry.vertexData(), stroker.vertices(),
+            stroker.vertexCount() * sizeof( float ) );
+    }
 
-        geometry.markVertexDataDirty();
-        markDirty( QSGNode::DirtyGeometry );
+    if ( hash != 0 )
+    {
+        QskGeometryCache::insertGeometry( key, geometry );
+        QskGeometryCache::translateGeometry( offset, geometry );
     }
+
+    geometry.markVertexDataDirty();
+    markDirty( QSGNode::DirtyGeometry );
 }
@@ -13,6 +13,8 @@ class QPen;
 class QPainterPath;
 class QPolygonF;
 
+class QskStrokeNodePrivate;
+
 class QSK_EXPORT QskStrokeNode : public QskFillNode
 {
     using Inherited = QskFillNode;
@@ -23,6 +25,9 @@ class QSK_EXPORT QskStrokeNode : public QskFillNode
 
     void updatePath( const QPainterPath&, const QPen& );
     void updatePath( const QPainterPath&, const QTransform&, const QPen& );
+
+  private:
+    Q_DECLARE_PRIVATE( QskStrokeNode )
 };
 
 #endif
@@ -0,0 +1,276 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskTextCache.h"
+#include "QskTextOptions.h"
+
+#include <qcache.h>
+#include <qfont.h>
+#include <qmutex.h>
+#include <qsize.h>
+#include <qthreadstorage.h>
+
+#ifndef QT_NO_DEBUG_STREAM
+#include <qdebug.h>
+#endif
+
+namespace
+{
+    class Key
+    {
+      public:
+        inline bool operator==( const Key& other ) const
+        {
+            return ( alignment == other.alignment )
+                && ( constraint == other.constraint )
+                && ( options == other.options )
+                && ( font == other.font )
+                && ( text == other.text );
+        }
+
+        QString text;
+        QFont font;
+        QskTextOptions options;
+        QSizeF constraint;
+        int alignment;
+    };
+
+    inline QskHashValue qHash( const Key& key, QskHashValue seed = 0 )
+    {
+        auto h = ::qHash( key.text, seed );
+        h = ::qHash( key.font, h );
+        h = key.options.hash( h );
+        h = ::qHash( key.constraint.width(), h );
+        h = ::qHash( key.constraint.height(), h );
+
+        return ::qHash( key.alignment, h );
+    }
+
+    class Cache
+    {
+      public:
+        Cache()
+        {
+            sizes.setMaxCost( capacity );
+        }
+
+        QMutex mutex;
+
+        QCache< Key, QSizeF > sizes;
+        QskTextCache::Statistics statistics;
+
+        int capacity = 500;
+        int generation = 0;
+    };
+
+    class LayoutCache
+    {
+      public:
+        QCache< Key, QskTextCache::Layout > layouts;
+        int generation = -1;
+    };
+}
+
+Q_GLOBAL_STATIC( Cache, qskCache )
+Q_GLOBAL_STATIC( QThreadStorage< LayoutCache* >, qskLayoutCaches )
+
+static LayoutCache* qskLayoutCache( int capacity, int generation )
+{
+    if ( qskLayoutCaches.isDestroyed() )
+        return nullptr;
+
+    auto& storage = *qskLayoutCaches;
+
+    if ( !storage.hasLocalData() )
+        storage.setLocalData( new LayoutCache() );
+
+    auto cache = storage.localData();
+
+    // capacity/clear() might have been changed from another thread
+    if ( cache->generation != generation )
+    {
+        cache->layouts.clear();
+        cache->generation = generation;
+    }
+
+    if ( cache->layouts.maxCost() != capacity )
+        cache->layouts.setMaxCost( capacity );
+
+    return cache;
+}
+
+static inline Key qskLayoutKey( const QString& text, const QFont& font,
+    const QskTextOptions& options, Qt::Alignment alignment, qreal width )
+{
+    return { text, font, options, QSizeF( width, -1.0 ), static_cast< int >( alignment ) };
+}
+
+void QskTextCache::setCapacity( int capacity )
+{
+    if ( qskCache.isDestroyed() )
+        return;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+
+    cache->capacity = qMax( capacity, 0 );
+    cache->sizes.setMaxCost( cache->capacity );
+}
+
+int QskTextCache::capacity()
+{
+    if ( qskCache.isDestroyed() )
+        return 0;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+    return cache->capacity;
+}
+
+void QskTextCache::clear()
+{
+    if ( qskCache.isDestroyed() )
+        return;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+
+    cache->sizes.clear();
+    cache->generation++;
+}
+
+QskTextCache::Statistics QskTextCache::statistics()
+{
+    if ( qskCache.isDestroyed() )
+        return Statistics();
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+    return cache->statistics;
+}
+
+void QskTextCache::resetStatistics()
+{
+    if ( qskCache.isDestroyed() )
+        return;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+    cache->statistics = Statistics();
+}
+
+void QskTextCache::debugStatistics( QDebug debug )
+{
+#ifndef QT_NO_DEBUG_STREAM
+    const auto s = statistics();
+
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+    debug << '(';
+    debug << "size hits: " << s.sizeHits
+          << ", size misses: " << s.sizeMisses
+          << ", layout hits: " << s.layoutHits
+          << ", layout misses: " << s.layoutMisses;
+    debug << ')';
+#else
+    Q_UNUSED( debug )
+#endif
+}
+
+bool QskTextCache::textSize( const QString& text, const QFont& font,
+    const QskTextOptions& options, const QSizeF& constraint, QSizeF& size )
+{
+    if ( qskCache.isDestroyed() )
+        return false;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+
+    if ( cache->capacity == 0 )
+        return false;
+
+    if ( auto cachedSize = cache->sizes.object( { text, font, options, constraint, -1 } ) )
+    {
+        cache->statistics.sizeHits++;
+
+        size = *cachedSize;
+        return true;
+    }
+
+    cache->statistics.sizeMisses++;
+    return false;
+}
+
+void QskTextCache::insertTextSize( const QString& text, const QFont& font,
+    const QskTextOptions& options, const QSizeF& constraint, const QSizeF& size )
+{
+    if ( qskCache.isDestroyed() )
+        return;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+
+    if ( cache->capacity > 0 )
+        cache->sizes.insert( { text, font, options, constraint, -1 }, new QSizeF( size ) );
+}
+
+bool QskTextCache::layout( const QString& text, const QFont& font,
+    const QskTextOptions& options, Qt::Alignment alignment, qreal width, Layout& layout )
+{
+    if ( qskCache.isDestroyed() )
+        return false;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+
+    if ( cache->capacity == 0 )
+        return false;
+
+    auto layoutCache = qskLayoutCache( cache->capacity, cache->generation );
+    if ( layoutCache == nullptr )
+        return false;
+
+    const auto key = qskLayoutKey( text, font, options, alignment, width );
+
+    if ( auto cachedLayout = layoutCache->layouts.object( key ) )
+    {
+        cache->statistics.layoutHits++;
+
+        layout = *cachedLayout;
+        return true;
+    }
+
+    cache->statistics.layoutMisses++;
+    return false;
+}
+
+void QskTextCache::insertLayout( const QString& text, const QFont& font,
+    const QskTextOptions& options, Qt::Alignment alignment, qreal width,
+    const Layout& layout )
+{
+    if ( qskCache.isDestroyed() )
+        return;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+
+    if ( cache->capacity == 0 )
+        return;
+
+    if ( auto layoutCache = qskLayoutCache( cache->capacity, cache->generation ) )
+    {
+        const auto key = qskLayoutKey( text, font, options, alignment, width );
+        layoutCache->layouts.insert( key, new Layout( layout ) );
+    }
+}
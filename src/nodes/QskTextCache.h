@@ -0,0 +1,77 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_TEXT_CACHE_H
+#define QSK_TEXT_CACHE_H
+
+#include "QskGlobal.h"
+
+#include <qglyphrun.h>
+#include <qlist.h>
+#include <qnamespace.h>
+
+class QskTextOptions;
+
+class QString;
+class QFont;
+class QSizeF;
+class QDebug;
+
+/*
+    Layouts are asking for the size hints of the same texts over and over.
+    QskTextCache stores the results of QskTextRenderer::textSize() and
+    the lines of QskPlainTextRenderer::updateNode() in caches, that drop
+    the least recently used entries, when exceeding the capacity.
+
+    The sizes are shared between all threads, while the lines are cached
+    for each thread separately as the glyphs are bound to the font engines
+    of the thread.
+ */
+namespace QskTextCache
+{
+    class Statistics
+    {
+      public:
+        quint64 sizeHits = 0;
+        quint64 sizeMisses = 0;
+
+        quint64 layoutHits = 0;
+        quint64 layoutMisses = 0;
+    };
+
+    class Layout
+    {
+      public:
+        QList< QGlyphRun > glyphRuns;
+
+        qreal textHeight = 0.0;
+        qreal boundingHeight = 0.0;
+    };
+
+    // maximum number of entries for each cache, 0 disables caching
+    QSK_EXPORT void setCapacity( int );
+    QSK_EXPORT int capacity();
+
+    QSK_EXPORT void clear();
+
+    QSK_EXPORT Statistics statistics();
+    QSK_EXPORT void resetStatistics();
+    QSK_EXPORT void debugStatistics( QDebug );
+
+    // an invalid constraint stands for the unconstrained size
+    QSK_EXPORT bool textSize( const QString&, const QFont&,
+        const QskTextOptions&, const QSizeF& constraint, QSizeF& size );
+
+    QSK_EXPORT void insertTextSize( const QString&, const QFont&,
+        const QskTextOptions&, const QSizeF& constraint, const QSizeF& size );
+
+    QSK_EXPORT bool layout( const QString&, const QFont&,
+        const QskTextOptions&, Qt::Alignment, qreal width, Layout& );
+
+    QSK_EXPORT void insertLayout( const QString&, const QFont&,
+        const QskTextOptions&, Qt::Alignment, qreal width, const Layout& );
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "QskPlainTextRenderer.h"
 #include "QskRichTextRenderer.h"
 #include "QskTextOptions.h"
+#include "QskTextCache.h"
 
 #include <qrect.h>
 
@@ -17,20 +18,38 @@
 QSizeF QskTextRenderer::textSize(
     const QString& text, const QFont& font, const QskTextOptions& options )
 {
+    QSizeF size;
+
+    if ( QskTextCache::textSize( text, font, options, QSizeF(), size ) )
+        return size;
+
     if ( options.effectiveFormat( text ) == QskTextOptions::PlainText )
-        return QskPlainTextRenderer::textSize( text, font, options );
+        size = QskPlainTextRenderer::textSize( text, font, options );
     else
-        return QskRichTextRenderer::textSize( text, font, options );
+        size = QskRichTextRenderer::textSize( text, font, options );
+
+    QskTextCache::insertTextSize( text, font, options, QSizeF(), size );
+
+    return size;
 }
 
 QSizeF QskTextRenderer::textSize(
     const QString& text, const QFont& font, const QskTextOptions& options,
-    const QSizeF& size )
+    const QSizeF& constraint )
 {
+    QSizeF size;
+
+    if ( QskTextCache::textSize( text, font, options, constraint, size ) )
+        return size;
+
     if ( options.effectiveFormat( text ) == QskTextOptions::PlainText )
-        return QskPlainTextRenderer::textRect( text, font, options, size ).size();
+        size = QskPlainTextRenderer::textRect( text, font, options, constraint ).size();
     else
-        return QskRichTextRenderer::textRect( text, font, options, size ).size();
+        size = QskRichTextRenderer::textRect( text, font, options, constraint ).size();
+
+    QskTextCache::insertTextSize( text, font, options, constraint, size );
+
+    return size;
 }
 
 void QskTextRenderer::updateNode(
@@ -0,0 +1,573 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskTextureAtlas.h"
+#include "QskTextureCachePrivate.h"
+#include "QskInternalMacros.h"
+
+#include <qsgimagenode.h>
+#include <qquickwindow.h>
+#include <qimage.h>
+#include <qpainter.h>
+#include <qhash.h>
+#include <qmutex.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qsgplaintexture_p.h>
+QSK_QT_PRIVATE_END
+
+#include <algorithm>
+
+namespace
+{
+    const int pageSize = 512;
+    const int maxPageCount = 4;
+
+    // transparent pixels around each entry avoiding bleeding when filtering
+    const int padding = 1;
+
+    using Key = QskTextureKey;
+
+    /*
+        A simple shelf packer: entries are put side by side into
+        rows ( shelves ) of a height, that is not much larger than
+        the height of the entry.
+     */
+    class Layout
+    {
+      public:
+        bool allocate( const QSize& size, QRect& rect )
+        {
+            const int w = size.width() + 2 * padding;
+            const int h = size.height() + 2 * padding;
+
+            if ( w > pageSize )
+                return false;
+
+            for ( auto& shelf : m_shelves )
+            {
+                if ( ( h <= shelf.height ) && ( shelf.height <= h + h / 4 + 2 )
+                    && ( shelf.x + w <= pageSize ) )
+                {
+                    rect = QRect( shelf.x + padding, shelf.y + padding,
+                        size.width(), size.height() );
+
+                    shelf.x += w;
+                    return true;
+                }
+            }
+
+            if ( m_height + h > pageSize )
+                return false;
+
+            rect = QRect( padding, m_height + padding, size.width(), size.height() );
+
+            m_shelves += Shelf { m_height, h, w };
+            m_height += h;
+
+            return true;
+        }
+
+      private:
+        struct Shelf
+        {
+            int y;
+            int height;
+            int x;
+        };
+
+        QVector< Shelf > m_shelves;
+        int m_height = 0;
+    };
+
+    class Page
+    {
+      public:
+        Page( QSGPlainTexture* texture, const QImage& image )
+            : image( image )
+            , texture( texture )
+        {
+        }
+
+        ~Page()
+        {
+            delete texture;
+        }
+
+        QImage image;
+        QSGPlainTexture* texture;
+        Layout layout;
+
+        // the image has been modified, since it has been uploaded
+        bool dirty = false;
+    };
+
+    class Entry
+    {
+      public:
+        Page* page;
+        QRect rect; // without padding
+        QVector< QSGImageNode* > nodes;
+    };
+
+    class WindowAtlas
+    {
+      public:
+        WindowAtlas( QQuickWindow* window )
+            : m_window( window )
+        {
+        }
+
+        ~WindowAtlas()
+        {
+            qDeleteAll( m_entries );
+            qDeleteAll( m_pages );
+        }
+
+        QSGTexture* acquire( QSGImageNode*, const Key&,
+            QskTextureRenderer::PaintHelper* );
+
+        bool release( QSGImageNode* );
+        void upload();
+
+        QskTextureAtlas::Statistics statistics;
+
+      private:
+        Page* createPage() const;
+
+        bool allocate( const QSize&, Page*&, QRect& );
+        bool compact( Page* );
+
+        QQuickWindow* m_window;
+
+        QVector< Page* > m_pages;
+        QHash< Key, Entry* > m_entries;
+        QHash< const QSGImageNode*, Entry* > m_nodes;
+    };
+
+    class Atlas
+    {
+      public:
+        /*
+            When the application is shutting down the graphics
+            resources might be gone already. As the pages
+            of a window are deleted, when its scene graph gets
+            invalidated, we intentionally leak, what is left.
+         */
+        ~Atlas() = default;
+
+        WindowAtlas* windowAtlas( QQuickWindow* );
+        void upload( const QQuickWindow* );
+        void invalidate( const QQuickWindow* );
+
+        QMutex mutex;
+        QHash< const QQuickWindow*, WindowAtlas* > windowAtlases;
+
+        bool enabled = false;
+    };
+}
+
+Q_GLOBAL_STATIC( Atlas, qskAtlas )
+
+static inline bool qskIsAtlasSupported( const QQuickWindow* window )
+{
+    /*
+        Only the batching renderers of the hardware accelerated
+        backends benefit from sharing a texture.
+     */
+    const auto renderer = window->rendererInterface();
+    if ( renderer == nullptr )
+        return false;
+
+    switch( renderer->graphicsApi() )
+    {
+        case QSGRendererInterface::Unknown:
+        case QSGRendererInterface::Software:
+        case QSGRendererInterface::OpenVG:
+            return false;
+
+        default:
+            return true;
+    }
+}
+
+QSGTexture* WindowAtlas::acquire( QSGImageNode* node,
+    const Key& key, QskTextureRenderer::PaintHelper* helper )
+{
+    auto entry = m_entries.value( key );
+
+    if ( entry )
+    {
+        statistics.hits++;
+
+        if ( entry->nodes.isEmpty() )
+            statistics.unusedCount--;
+    }
+    else
+    {
+        statistics.misses++;
+
+        Page* page;
+        QRect rect;
+
+        if ( !allocate( key.size, page, rect ) )
+        {
+            statistics.rejections++;
+            return nullptr;
+        }
+
+        QskTextureRenderer::paintRaster( page->image, rect.topLeft(),
+            key.size / key.ratio, key.ratio, helper );
+
+        // uploaded once for all entries of the frame: see upload()
+        page->dirty = true;
+
+        entry = new Entry { page, rect, {} };
+        m_entries.insert( key, entry );
+
+        statistics.entryCount++;
+    }
+
+    entry->nodes += node;
+    m_nodes.insert( node, entry );
+
+    statistics.nodeCount++;
+
+    node->setSourceRect( entry->rect );
+    return entry->page->texture;
+}
+
+bool WindowAtlas::release( QSGImageNode* node )
+{
+    auto entry = m_nodes.take( node );
+    if ( entry == nullptr )
+        return false;
+
+    /*
+        Entries without nodes are kept until the space
+        is needed for other entries.
+     */
+    entry->nodes.removeOne( node );
+
+    statistics.nodeCount--;
+
+    if ( entry->nodes.isEmpty() )
+        statistics.unusedCount++;
+
+    return true;
+}
+
+void WindowAtlas::upload()
+{
+    for ( auto page : std::as_const( m_pages ) )
+    {
+        if ( page->dirty )
+        {
+            /*
+                The texture drops its reference to the image, when
+                the upload is done. So painting the entries of the next
+                frame does not detach the image.
+             */
+            page->texture->setImage( page->image );
+            page->dirty = false;
+        }
+    }
+}
+
+Page* WindowAtlas::createPage() const
+{
+    QImage image( pageSize, pageSize, QImage::Format_RGBA8888_Premultiplied );
+    image.fill( Qt::transparent );
+
+    auto texture = m_window->createTextureFromImage(
+        image, QQuickWindow::TextureHasAlphaChannel );
+
+    // we need to be able to update the image of the texture
+    if ( auto plainTexture = qobject_cast< QSGPlainTexture* >( texture ) )
+        return new Page( plainTexture, image );
+
+    delete texture;
+    return nullptr;
+}
+
+bool WindowAtlas::allocate( const QSize& size, Page*& page, QRect& rect )
+{
+    for ( auto p : std::as_const( m_pages ) )
+    {
+        if ( p->layout.allocate( size, rect ) )
+        {
+            page = p;
+            return true;
+        }
+    }
+
+    for ( auto p : std::as_const( m_pages ) )
+    {
+        if ( compact( p ) && p->layout.allocate( size, rect ) )
+        {
+            page = p;
+            return true;
+        }
+    }
+
+    if ( m_pages.count() < maxPageCount )
+    {
+        page = createPage();
+        if ( page == nullptr )
+            return false;
+
+        m_pages += page;
+
+        statistics.pageCount++;
+
+        return page->layout.allocate( size, rect );
+    }
+
+    return false;
+}
+
+bool WindowAtlas::compact( Page* page )
+{
+    QVector< Entry* > entries;
+    bool hasUnusedEntries = false;
+
+    for ( auto entry : std::as_const( m_entries ) )
+    {
+        if ( entry->page == page )
+        {
+            if ( entry->nodes.isEmpty() )
+                hasUnusedEntries = true;
+            else
+                entries += entry;
+        }
+    }
+
+    if ( !hasUnusedEntries )
+        return false;
+
+    // packing the tall entries first results in less wasted space
+    std::sort( entries.begin(), entries.end(),
+        []( const Entry* e1, const Entry* e2 )
+        { return e1->rect.height() > e2->rect.height(); } );
+
+    Layout layout;
+
+    QVector< QRect > rects;
+    rects.reserve( entries.count() );
+
+    for ( const auto entry : std::as_const( entries ) )
+    {
+        QRect rect;
+        if ( !layout.allocate( entry->rect.size(), rect ) )
+            return false;
+
+        rects += rect;
+    }
+
+    /*
+        As all positions might change, the page needs to be uploaded
+        completely. But like for new entries it is done only once,
+        together with all other modifications of the frame.
+     */
+    QImage image( pageSize, pageSize, QImage::Format_RGBA8888_Premultiplied );
+    image.fill( Qt::transparent );
+
+    {
+        QPainter painter( &image );
+        painter.setCompositionMode( QPainter::CompositionMode_Source );
+
+        for ( int i = 0; i < entries.count(); i++ )
+            painter.drawImage( rects[ i ].topLeft(), page->image, entries[ i ]->rect );
+    }
+
+    for ( auto it = m_entries.begin(); it != m_entries.end(); )
+    {
+        auto entry = it.value();
+
+        if ( entry->page == page && entry->nodes.isEmpty() )
+        {
+            delete entry;
+            it = m_entries.erase( it );
+
+            statistics.entryCount--;
+            statistics.unusedCount--;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for ( int i = 0; i < entries.count(); i++ )
+    {
+        auto entry = entries[ i ];
+        entry->rect = rects[ i ];
+
+        for ( auto node : std::as_const( entry->nodes ) )
+            node->setSourceRect( entry->rect );
+    }
+
+    page->image = image;
+    page->layout = layout;
+    page->dirty = true;
+
+    statistics.compactions++;
+
+    return true;
+}
+
+WindowAtlas* Atlas::windowAtlas( QQuickWindow* window )
+{
+    auto& windowAtlas = windowAtlases[ window ];
+    if ( windowAtlas == nullptr )
+    {
+        windowAtlas = new WindowAtlas( window );
+
+        /*
+            The entries are painted, when the nodes are updated. After
+            synchronizing all of them are uploaded at once - before
+            the frame gets rendered.
+         */
+        QObject::connect( window, &QQuickWindow::afterSynchronizing,
+            window, [ window ]() { qskAtlas->upload( window ); },
+            Qt::DirectConnection );
+
+        QObject::connect( window, &QQuickWindow::sceneGraphInvalidated,
+            window, [ window ]() { qskAtlas->invalidate( window ); },
+            Qt::DirectConnection );
+
+        QObject::connect( window, &QObject::destroyed,
+            [ window ]()
+            {
+                if ( !qskAtlas.isDestroyed() )
+                    qskAtlas->invalidate( window );
+            } );
+    }
+
+    return windowAtlas;
+}
+
+void Atlas::upload( const QQuickWindow* window )
+{
+    const QMutexLocker locker( &mutex );
+
+    if ( auto windowAtlas = windowAtlases.value( window ) )
+        windowAtlas->upload();
+}
+
+void Atlas::invalidate( const QQuickWindow* window )
+{
+    const QMutexLocker locker( &mutex );
+    delete windowAtlases.take( window );
+}
+
+void QskTextureAtlas::setEnabled( bool on )
+{
+    if ( qskAtlas.isDestroyed() )
+        return;
+
+    auto atlas = qskAtlas();
+
+    // nodes, that are in the atlas already, will stay there
+    const QMutexLocker locker( &atlas->mutex );
+    atlas->enabled = on;
+}
+
+bool QskTextureAtlas::isEnabled()
+{
+    if ( qskAtlas.isDestroyed() )
+        return false;
+
+    auto atlas = qskAtlas();
+
+    const QMutexLocker locker( &atlas->mutex );
+    return atlas->enabled;
+}
+
+QSize QskTextureAtlas::maxEntrySize()
+{
+    return QSize( 64, 64 );
+}
+
+QSGTexture* QskTextureAtlas::acquire( QSGImageNode* node, QQuickWindow* window,
+    const void* category, QskHashValue hash, const QSize& size,
+    QskTextureRenderer::PaintHelper* helper )
+{
+    if ( node == nullptr || window == nullptr || size.isEmpty() )
+        return nullptr;
+
+    const auto maxSize = maxEntrySize();
+    if ( size.width() > maxSize.width() || size.height() > maxSize.height() )
+        return nullptr;
+
+    if ( qskAtlas.isDestroyed() )
+        return nullptr;
+
+    auto atlas = qskAtlas();
+
+    const QMutexLocker locker( &atlas->mutex );
+
+    if ( !atlas->enabled || !qskIsAtlasSupported( window ) )
+        return nullptr;
+
+    const Key key { category, hash, size, window->effectiveDevicePixelRatio() };
+    return atlas->windowAtlas( window )->acquire( node, key, helper );
+}
+
+bool QskTextureAtlas::release( QSGImageNode* node )
+{
+    if ( node == nullptr || qskAtlas.isDestroyed() )
+        return false;
+
+    auto atlas = qskAtlas();
+
+    const QMutexLocker locker( &atlas->mutex );
+
+    // usually we have only one window
+    for ( auto windowAtlas : std::as_const( atlas->windowAtlases ) )
+    {
+        if ( windowAtlas->release( node ) )
+            return true;
+    }
+
+    return false;
+}
+
+QskTextureAtlas::Statistics QskTextureAtlas::statistics( const QQuickWindow* window )
+{
+    if ( qskAtlas.isDestroyed() )
+        return Statistics();
+
+    auto atlas = qskAtlas();
+
+    const QMutexLocker locker( &atlas->mutex );
+
+    if ( auto windowAtlas = atlas->windowAtlases.value( window ) )
+        return windowAtlas->statistics;
+
+    return Statistics();
+}
+
+void QskTextureAtlas::debugStatistics( QDebug debug, const QQuickWindow* window )
+{
+#ifndef QT_NO_DEBUG_STREAM
+    const auto s = statistics( window );
+
+    qskDebugStatistics( debug,
+    {
+        { "hits", qint64( s.hits ) },
+        { "misses", qint64( s.misses ) },
+        { "rejections", qint64( s.rejections ) },
+        { "compactions", qint64( s.compactions ) },
+        { "pages", qint64( s.pageCount ) },
+        { "entries", qint64( s.entryCount ) },
+        { "unused", qint64( s.unusedCount ) },
+        { "nodes", qint64( s.nodeCount ) }
+    } );
+#else
+    Q_UNUSED( debug )
+    Q_UNUSED( window )
+#endif
+}
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_TEXTURE_ATLAS_H
+#define QSK_TEXTURE_ATLAS_H
+
+#include "QskGlobal.h"
+#include "QskTextureRenderer.h"
+
+class QSGTexture;
+class QSGImageNode;
+class QQuickWindow;
+class QSize;
+class QDebug;
+
+/*
+    Small rasterized graphics ( f.e. the icons of a list box ) are packed
+    into a couple of shared textures - the pages of the atlas. As the image
+    nodes share the same texture the renderer is able to batch them into
+    a single draw call.
+
+    The entries of the atlas are identified by a category, the hash value
+    of the node, the size in device pixels and the device pixel ratio - like
+    with QskTextureCache.
+
+    The space of entries, that are not used anymore, is reclaimed by
+    compacting a page, when there is no space left for a new entry.
+    Compacting changes the positions of the entries and the source rectangles
+    of the image nodes are adjusted. Graphics, that are too large or do not
+    fit into the atlas are supposed to fall back to a texture of their own.
+ */
+namespace QskTextureAtlas
+{
+    class Statistics
+    {
+      public:
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 rejections = 0;
+        quint64 compactions = 0;
+
+        int pageCount = 0;
+        int entryCount = 0;
+        int unusedCount = 0;
+        int nodeCount = 0;
+    };
+
+    /*
+        The atlas is disabled by default. Even when being enabled it is
+        only used for the hardware accelerated backends as the software
+        renderer does not batch.
+     */
+    QSK_EXPORT void setEnabled( bool );
+    QSK_EXPORT bool isEnabled();
+
+    // the maximum size ( in device pixels ) of an entry: 64x64
+    QSK_EXPORT QSize maxEntrySize();
+
+    /*
+        Looks up/creates an entry for the node and returns the texture
+        of its page. The source rectangle of the node is set to the position
+        of the entry. When getting nullptr the graphic has to be rendered
+        into a texture of its own.
+
+        The node has to be released before acquiring the next entry
+        and before it gets deleted.
+     */
+    QSK_EXPORT QSGTexture* acquire( QSGImageNode*, QQuickWindow*, const void* category,
+        QskHashValue, const QSize&, QskTextureRenderer::PaintHelper* );
+
+    // Returns false, when the node is unknown to the atlas
+    QSK_EXPORT bool release( QSGImageNode* );
+
+    QSK_EXPORT Statistics statistics( const QQuickWindow* );
+    QSK_EXPORT void debugStatistics( QDebug, const QQuickWindow* );
+}
+
+#endif
@@ -0,0 +1,338 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskTextureCache.h"
+#include "QskTextureCachePrivate.h"
+
+#include <qsgtexture.h>
+#include <qsize.h>
+#include <qquickwindow.h>
+#include <qhash.h>
+#include <qmutex.h>
+
+namespace
+{
+    using Key = QskTextureKey;
+
+    class Entry
+    {
+      public:
+        QSGTexture* texture = nullptr;
+        qint64 bytes = 0;
+        quint64 lastUsed = 0;
+        int refCount = 0;
+    };
+
+    class WindowCache
+    {
+      public:
+        WindowCache() = default;
+        ~WindowCache();
+
+        QSGTexture* acquire( const Key& );
+        QSGTexture* insert( const Key&, QSGTexture* );
+        bool release( const QSGTexture* );
+
+        void evict( qint64 budget );
+
+        QskTextureCache::Statistics statistics;
+
+      private:
+        QHash< Key, Entry > m_entries;
+        QHash< const QSGTexture*, Key > m_keys;
+
+        quint64 m_counter = 0;
+    };
+
+    class Cache
+    {
+      public:
+        /*
+            When the application is shutting down the graphics
+            resources might be gone already. As the textures
+            of a window are deleted, when its scene graph gets
+            invalidated, we intentionally leak, what is left.
+         */
+        ~Cache() = default;
+
+        WindowCache* windowCache( QQuickWindow* );
+        void invalidate( const QQuickWindow* );
+
+        QMutex mutex;
+        QHash< const QQuickWindow*, WindowCache* > windowCaches;
+
+        int budget = 16 * 1024 * 1024;
+    };
+}
+
+Q_GLOBAL_STATIC( Cache, qskCache )
+
+static inline qint64 qskTextureBytes( const QSize& size )
+{
+    // we always create RGBA8888 textures
+    return qint64( size.width() ) * size.height() * 4;
+}
+
+WindowCache::~WindowCache()
+{
+    for ( auto it = m_entries.begin(); it != m_entries.end(); ++it )
+        delete it.value().texture;
+}
+
+QSGTexture* WindowCache::acquire( const Key& key )
+{
+    auto it = m_entries.find( key );
+    if ( it == m_entries.end() )
+    {
+        statistics.misses++;
+        return nullptr;
+    }
+
+    auto& entry = it.value();
+
+    if ( entry.refCount++ == 0 )
+    {
+        statistics.unusedCount--;
+        statistics.unusedBytes -= entry.bytes;
+    }
+
+    entry.lastUsed = ++m_counter;
+    statistics.hits++;
+
+    return entry.texture;
+}
+
+QSGTexture* WindowCache::insert( const Key& key, QSGTexture* texture )
+{
+    auto& entry = m_entries[ key ];
+
+    if ( entry.texture )
+    {
+        /*
+            Should not happen as the node has checked the cache
+            before creating the texture. But we don't want to lose
+            the references of the old one.
+         */
+        delete texture;
+
+        if ( entry.refCount++ == 0 )
+        {
+            statistics.unusedCount--;
+            statistics.unusedBytes -= entry.bytes;
+        }
+
+        entry.lastUsed = ++m_counter;
+        return entry.texture;
+    }
+
+    entry.texture = texture;
+    entry.bytes = qskTextureBytes( key.size );
+    entry.refCount = 1;
+    entry.lastUsed = ++m_counter;
+
+    m_keys.insert( texture, key );
+
+    statistics.textureCount++;
+    statistics.bytes += entry.bytes;
+
+    return texture;
+}
+
+bool WindowCache::release( const QSGTexture* texture )
+{
+    const auto itKey = m_keys.constFind( texture );
+    if ( itKey == m_keys.constEnd() )
+        return false;
+
+    auto& entry = m_entries[ itKey.value() ];
+
+    if ( --entry.refCount == 0 )
+    {
+        statistics.unusedCount++;
+        statistics.unusedBytes += entry.bytes;
+    }
+
+    return true;
+}
+
+void WindowCache::evict( qint64 budget )
+{
+    while ( statistics.unusedBytes > budget )
+    {
+        auto lru = m_entries.end();
+
+        for ( auto it = m_entries.begin(); it != m_entries.end(); ++it )
+        {
+            const auto& entry = it.value();
+
+            if ( entry.refCount == 0 )
+            {
+                if ( lru == m_entries.end() || entry.lastUsed < lru.value().lastUsed )
+                    lru = it;
+            }
+        }
+
+        if ( lru == m_entries.end() )
+            break;
+
+        const auto& entry = lru.value();
+
+        statistics.evictions++;
+        statistics.textureCount--;
+        statistics.unusedCount--;
+        statistics.bytes -= entry.bytes;
+        statistics.unusedBytes -= entry.bytes;
+
+        m_keys.remove( entry.texture );
+        delete entry.texture;
+
+        m_entries.erase( lru );
+    }
+}
+
+WindowCache* Cache::windowCache( QQuickWindow* window )
+{
+    auto& windowCache = windowCaches[ window ];
+    if ( windowCache == nullptr )
+    {
+        windowCache = new WindowCache();
+
+        QObject::connect( window, &QQuickWindow::sceneGraphInvalidated,
+            window, [ window ]() { qskCache->invalidate( window ); },
+            Qt::DirectConnection );
+
+        QObject::connect( window, &QObject::destroyed,
+            [ window ]()
+            {
+                if ( !qskCache.isDestroyed() )
+                    qskCache->invalidate( window );
+            } );
+    }
+
+    return windowCache;
+}
+
+void Cache::invalidate( const QQuickWindow* window )
+{
+    const QMutexLocker locker( &mutex );
+    delete windowCaches.take( window );
+}
+
+QSGTexture* QskTextureCache::acquire( QQuickWindow* window, const void* category,
+    QskHashValue hash, const QSize& size, qreal devicePixelRatio )
+{
+    if ( window == nullptr || qskCache.isDestroyed() )
+        return nullptr;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+    return cache->windowCache( window )->acquire(
+        { category, hash, size, devicePixelRatio } );
+}
+
+QSGTexture* QskTextureCache::insert( QQuickWindow* window, const void* category,
+    QskHashValue hash, const QSize& size, qreal devicePixelRatio, QSGTexture* texture )
+{
+    if ( texture == nullptr || window == nullptr || qskCache.isDestroyed() )
+        return texture;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+
+    auto windowCache = cache->windowCache( window );
+    texture = windowCache->insert(
+        { category, hash, size, devicePixelRatio }, texture );
+
+    /*
+        Evicting is only done here as we know, that we are in the
+        render thread of the window and its graphics resources are bound.
+     */
+    windowCache->evict( cache->budget );
+
+    return texture;
+}
+
+bool QskTextureCache::release( const QSGTexture* texture )
+{
+    if ( texture == nullptr || qskCache.isDestroyed() )
+        return false;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+
+    // usually we have only one window
+    for ( auto windowCache : std::as_const( cache->windowCaches ) )
+    {
+        if ( windowCache->release( texture ) )
+            return true;
+    }
+
+    return false;
+}
+
+void QskTextureCache::setBudget( int bytes )
+{
+    if ( qskCache.isDestroyed() )
+        return;
+
+    auto cache = qskCache();
+
+    /*
+        Unused textures exceeding the new budget will be
+        deleted, when inserting the next texture.
+     */
+    const QMutexLocker locker( &cache->mutex );
+    cache->budget = qMax( bytes, 0 );
+}
+
+int QskTextureCache::budget()
+{
+    if ( qskCache.isDestroyed() )
+        return 0;
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+    return cache->budget;
+}
+
+QskTextureCache::Statistics QskTextureCache::statistics( const QQuickWindow* window )
+{
+    if ( qskCache.isDestroyed() )
+        return Statistics();
+
+    auto cache = qskCache();
+
+    const QMutexLocker locker( &cache->mutex );
+
+    if ( auto windowCache = cache->windowCaches.value( window ) )
+        return windowCache->statistics;
+
+    return Statistics();
+}
+
+void QskTextureCache::debugStatistics( QDebug debug, const QQuickWindow* window )
+{
+#ifndef QT_NO_DEBUG_STREAM
+    const auto s = statistics( window );
+
+    qskDebugStatistics( debug,
+    {
+        { "hits", qint64( s.hits ) },
+        { "misses", qint64( s.misses ) },
+        { "evictions", qint64( s.evictions ) },
+        { "textures", qint64( s.textureCount ) },
+        { "unused", qint64( s.unusedCount ) },
+        { "bytes", qint64( s.bytes ) },
+        { "unused bytes", qint64( s.unusedBytes ) }
+    } );
+#else
+    Q_UNUSED( debug )
+    Q_UNUSED( window )
+#endif
+}
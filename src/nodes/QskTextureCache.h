@@ -0,0 +1,81 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_TEXTURE_CACHE_H
+#define QSK_TEXTURE_CACHE_H
+
+#include "QskGlobal.h"
+
+class QSGTexture;
+class QQuickWindow;
+class QSize;
+class QDebug;
+
+/*
+    Textures of rasterized nodes ( f.e. QskGraphicNode ), that are shared
+    between all nodes of a window with the same content.
+
+    The key is made of a category - an address identifying the kind of
+    content, f.e. the type_info of the node - the hash value of the node -
+    what needs to include everything that has an effect on the result,
+    like a color filter - the size of the texture and the device pixel ratio.
+    As hash values of different kinds of content are unrelated, they
+    can only be matched within the same category.
+
+    Textures are reference counted. Textures, that are not in use anymore,
+    are kept until the total size of them exceeds a budget, when the least
+    recently used ones are deleted.
+
+    All textures of a window are deleted, when its scene graph gets
+    invalidated.
+
+    Acquiring/releasing has to be done from the render thread of the window.
+ */
+namespace QskTextureCache
+{
+    class Statistics
+    {
+      public:
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+
+        int textureCount = 0;
+        int unusedCount = 0;
+
+        qint64 bytes = 0;
+        qint64 unusedBytes = 0;
+    };
+
+    /*
+        Returns a texture with an incremented reference counter
+        or nullptr, when there is no texture for the key.
+     */
+    QSK_EXPORT QSGTexture* acquire( QQuickWindow*, const void* category,
+        QskHashValue, const QSize&, qreal devicePixelRatio );
+
+    /*
+        Takes ownership of the texture and stores it with a
+        reference counter of 1. The texture should not be
+        modified afterwards.
+
+        In case of a texture being in the cache already for the key
+        the passed one is deleted and the cached one is returned.
+     */
+    QSK_EXPORT QSGTexture* insert( QQuickWindow*, const void* category,
+        QskHashValue, const QSize&, qreal devicePixelRatio, QSGTexture* );
+
+    // Returns false, when the texture is unknown to the cache
+    QSK_EXPORT bool release( const QSGTexture* );
+
+    // size in bytes for unused textures, default: 16MB
+    QSK_EXPORT void setBudget( int bytes );
+    QSK_EXPORT int budget();
+
+    QSK_EXPORT Statistics statistics( const QQuickWindow* );
+    QSK_EXPORT void debugStatistics( QDebug, const QQuickWindow* );
+}
+
+#endif
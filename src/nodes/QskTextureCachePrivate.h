@@ -0,0 +1,78 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_TEXTURE_CACHE_PRIVATE_H
+#define QSK_TEXTURE_CACHE_PRIVATE_H
+
+/*
+    Code shared by QskTextureCache and QskTextureAtlas,
+    that identify their entries the same way.
+ */
+
+#include "QskGlobal.h"
+
+#include <qhash.h>
+#include <qsize.h>
+
+#ifndef QT_NO_DEBUG_STREAM
+#include <qdebug.h>
+#endif
+
+#include <initializer_list>
+#include <utility>
+
+class QskTextureKey
+{
+  public:
+    inline bool operator==( const QskTextureKey& other ) const
+    {
+        /*
+            The ratio is compared exactly as it is hashed exactly:
+            fuzzy comparisons do not match a hash.
+         */
+        return ( category == other.category ) && ( hash == other.hash )
+            && ( size == other.size ) && ( ratio == other.ratio );
+    }
+
+    const void* category;
+    QskHashValue hash;
+    QSize size;
+    qreal ratio;
+};
+
+inline size_t qHash( const QskTextureKey& key, size_t seed = 0 )
+{
+    auto h = ::qHash( key.category, seed );
+    h = ::qHash( key.hash, h );
+    h = ::qHash( key.size.width(), h );
+    h = ::qHash( key.size.height(), h );
+
+    return ::qHash( key.ratio, h );
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+
+static inline void qskDebugStatistics( QDebug debug,
+    std::initializer_list< std::pair< const char*, qint64 > > values )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << '(';
+
+    for ( auto it = values.begin(); it != values.end(); ++it )
+    {
+        if ( it != values.begin() )
+            debug << ", ";
+
+        debug << it->first << ": " << it->second;
+    }
+
+    debug << ')';
+}
+
+#endif
+
+#endif
@@ -179,6 +179,23 @@ quint32 QskTextureRenderer::createTextureGL(
     return qskTakeTexture( fbo );
 }
 
+void QskTextureRenderer::paintRaster( QImage& image, const QPoint& pos,
+    const QSize& size, qreal devicePixelRatio, PaintHelper* helper )
+{
+    QPainter painter( &image );
+
+    painter.translate( pos );
+
+    /*
+        setting a devicePixelRatio for the image only works for
+        value >= 1.0. So we have to scale manually.
+     */
+    painter.scale( devicePixelRatio, devicePixelRatio );
+
+    painter.setClipRect( QRectF( QPointF(), size ) );
+    helper->paint( &painter, size );
+}
+
 QSGTexture* QskTextureRenderer::createTextureRaster( QQuickWindow* window,
     const QSize& size, PaintHelper* helper )
 {
@@ -187,17 +204,7 @@ QSGTexture* QskTextureRenderer::createTextureRaster( QQuickWindow* window,
     QImage image( size * ratio, QImage::Format_RGBA8888_Premultiplied );
     image.fill( Qt::transparent );
 
-    {
-        QPainter painter( &image );
-
-        /*
-            setting a devicePixelRatio for the image only works for
-            value >= 1.0. So we have to scale manually.
-         */
-        painter.scale( ratio, ratio );
-
-        helper->paint( &painter, size );
-    }
+    paintRaster( image, QPoint(), size, ratio, helper );
 
     return window->createTextureFromImage( image, QQuickWindow::TextureHasAlphaChannel );
 }
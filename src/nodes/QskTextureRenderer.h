@@ -9,6 +9,8 @@
 #include "QskGlobal.h"
 
 class QSize;
+class QPoint;
+class QImage;
 class QPainter;
 class QSGTexture;
 class QQuickWindow;
@@ -32,6 +34,14 @@ namespace QskTextureRenderer
 
     quint32 createTextureGL( QQuickWindow*, const QSize&, PaintHelper* );
     QSGTexture* createTextureRaster( QQuickWindow*, const QSize&, PaintHelper* );
+
+    /*
+        Paints into the area of an image, that starts at pos and has
+        the size size * devicePixelRatio. The image is expected to be
+        cleared before.
+     */
+    void paintRaster( QImage&, const QPoint& pos,
+        const QSize& size, qreal devicePixelRatio, PaintHelper* );
 }
 
 #endif
@@ -0,0 +1,475 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskVectorGraphicNode.h"
+#include "QskColorFilter.h"
+#include "QskGradient.h"
+#include "QskGraphic.h"
+#include "QskPainterCommand.h"
+#include "QskShapeNode.h"
+#include "QskStrokeNode.h"
+#include "QskSGNode.h"
+#include "QskVertex.h"
+
+#include <qquickwindow.h>
+#include <qsgimagenode.h>
+#include <qsgtexture.h>
+
+namespace
+{
+    /*
+        The subset of the QPainter state, that is relevant for
+        compiling the commands
+     */
+    class PaintState
+    {
+      public:
+        void update( const QskPainterCommand::StateData& data )
+        {
+            if ( data.flags & QPaintEngine::DirtyPen )
+                pen = data.pen;
+
+            if ( data.flags & QPaintEngine::DirtyBrush )
+                brush = data.brush;
+
+            if ( data.flags & QPaintEngine::DirtyTransform )
+                transform = data.transform;
+
+            if ( data.flags & QPaintEngine::DirtyOpacity )
+                opacity = data.opacity;
+
+            if ( data.flags & QPaintEngine::DirtyCompositionMode )
+                compositionMode = data.compositionMode;
+
+            if ( data.flags & QPaintEngine::DirtyClipEnabled )
+                isClipping = data.isClipEnabled;
+
+            if ( data.flags & ( QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyClipPath ) )
+                isClipping = ( data.clipOperation != Qt::NoClip );
+        }
+
+        QPen pen = QPen( Qt::black );
+        QBrush brush;
+        QTransform transform;
+        qreal opacity = 1.0;
+
+        QPainter::CompositionMode compositionMode = QPainter::CompositionMode_SourceOver;
+        bool isClipping = false;
+    };
+
+    class Element
+    {
+      public:
+        QskFillNode* node = nullptr;
+
+        // the brush of the filling or the pen - before applying the color filter
+        QBrush brush;
+
+        // the bounding rectangle of the path for gradients
+        QRectF rect;
+
+        qreal opacity = 1.0;
+        bool isStroke = false;
+    };
+}
+
+static inline bool qskIsBrushSupported( const QBrush& brush,
+    const QTransform& transform, qreal opacity )
+{
+    switch( brush.style() )
+    {
+        case Qt::NoBrush:
+        case Qt::SolidPattern:
+            return true;
+
+        case Qt::LinearGradientPattern:
+        case Qt::RadialGradientPattern:
+        case Qt::ConicalGradientPattern:
+        {
+            if ( opacity < 1.0 )
+                return false;
+
+            switch( brush.gradient()->coordinateMode() )
+            {
+                case QGradient::StretchToDeviceMode:
+                    return false;
+
+                case QGradient::LogicalMode:
+                {
+                    /*
+                        The coordinates of the gradient would have to
+                        be transformed like the path. TODO ...
+                     */
+                    return transform.isIdentity();
+                }
+
+                default:
+                    return true;
+            }
+        }
+
+        default:
+            return false;
+    }
+}
+
+static inline bool qskIsPathSupported( const PaintState& state )
+{
+    if ( state.isClipping )
+        return false;
+
+    if ( state.compositionMode != QPainter::CompositionMode_SourceOver )
+        return false;
+
+    if ( !state.transform.isAffine() )
+        return false;
+
+    if ( !qskIsBrushSupported( state.brush, state.transform, state.opacity ) )
+        return false;
+
+    if ( state.pen.style() != Qt::NoPen )
+    {
+        // the width of cosmetic pens does not scale with the matrix of the node
+        if ( state.pen.isCosmetic() )
+            return false;
+
+        if ( !qskIsBrushSupported( state.pen.brush(), state.transform, state.opacity ) )
+            return false;
+    }
+
+    return true;
+}
+
+static inline bool qskIsRasterSupported( const PaintState& state )
+{
+    return !state.isClipping && ( state.opacity >= 1.0 )
+        && ( state.compositionMode == QPainter::CompositionMode_SourceOver )
+        && ( state.transform.type() <= QTransform::TxScale );
+}
+
+static inline QColor qskEffectiveColor( const QColor& color, qreal opacity )
+{
+    if ( opacity >= 1.0 )
+        return color;
+
+    auto c = color;
+    c.setAlphaF( c.alphaF() * opacity );
+
+    return c;
+}
+
+static inline QskGradient qskEffectiveGradient(
+    const QBrush& brush, qreal opacity, bool isStroke )
+{
+    if ( const auto gradient = brush.gradient() )
+    {
+        QskGradient effectiveGradient( *gradient );
+
+        if ( isStroke )
+        {
+            // see QskStrokeNode::updatePath
+            effectiveGradient.setStretchMode( QskGradient::StretchToSize );
+        }
+
+        return effectiveGradient;
+    }
+
+    return QskGradient( qskEffectiveColor( brush.color(), opacity ) );
+}
+
+static void qskSetVertexColors( QskFillNode* node, const QColor& color )
+{
+    if ( !node->isGeometryColored() )
+    {
+        node->setColoring( color );
+        return;
+    }
+
+    /*
+        The geometry stays the same and we only need to recolor the
+        vertices instead of triangulating the path again.
+     */
+    auto& geometry = *node->geometry();
+
+    const QskVertex::Color c( color );
+
+    auto points = geometry.vertexDataAsColoredPoint2D();
+    for ( int i = 0; i < geometry.vertexCount(); i++ )
+    {
+        auto& p = points[i];
+        p.set( p.x, p.y, c.r, c.g, c.b, c.a );
+    }
+
+    geometry.markVertexDataDirty();
+    node->markDirty( QSGNode::DirtyGeometry );
+}
+
+static QSGNode* qskCreateImageNode( QQuickWindow* window,
+    const QRectF& rect, const QImage& image, const QRectF& subRect )
+{
+    if ( window == nullptr || image.isNull() )
+        return nullptr;
+
+    auto texture = window->createTextureFromImage( image );
+    if ( texture == nullptr )
+        return nullptr;
+
+    auto imageNode = window->createImageNode();
+
+    imageNode->setTexture( texture );
+    imageNode->setOwnsTexture( true );
+    imageNode->setFiltering( QSGTexture::Linear );
+    imageNode->setRect( rect );
+    imageNode->setSourceRect( subRect.isEmpty() ? QRectF( image.rect() ) : subRect );
+
+    return imageNode;
+}
+
+class QskVectorGraphicNode::PrivateData
+{
+  public:
+    QskGraphic graphic;
+    QskColorFilter colorFilter;
+
+    QRectF rect;
+    Qt::Orientations mirrored;
+
+    QVector< Element > elements;
+
+    // viewport transformation, parent of the compiled nodes
+    QSGTransformNode* transformNode = nullptr;
+};
+
+QskVectorGraphicNode::QskVectorGraphicNode()
+    : m_data( new PrivateData() )
+{
+    m_data->transformNode = new QSGTransformNode();
+    appendChildNode( m_data->transformNode );
+}
+
+QskVectorGraphicNode::~QskVectorGraphicNode()
+{
+}
+
+void QskVectorGraphicNode::setMirrored( Qt::Orientations orientations )
+{
+    if ( orientations != m_data->mirrored )
+    {
+        m_data->mirrored = orientations;
+        updateMatrix();
+    }
+}
+
+Qt::Orientations QskVectorGraphicNode::mirrored() const
+{
+    return m_data->mirrored;
+}
+
+void QskVectorGraphicNode::setGraphic( QQuickWindow* window,
+    const QskGraphic& graphic, const QskColorFilter& colorFilter, const QRectF& rect )
+{
+    const bool isGraphicDirty = ( graphic != m_data->graphic );
+    const bool isColorFilterDirty = ( colorFilter != m_data->colorFilter );
+
+    m_data->graphic = graphic;
+    m_data->colorFilter = colorFilter;
+
+    if ( isGraphicDirty )
+        compile( window );
+    else if ( isColorFilterDirty )
+        updateColors();
+
+    if ( isGraphicDirty || ( rect != m_data->rect ) )
+    {
+        m_data->rect = rect;
+        updateMatrix();
+    }
+}
+
+void QskVectorGraphicNode::compile( QQuickWindow* window )
+{
+    auto transformNode = m_data->transformNode;
+
+    QskSGNode::removeAllChildNodesFrom( transformNode, transformNode->firstChild() );
+    m_data->elements.clear();
+
+    const auto& colorFilter = m_data->colorFilter;
+
+    PaintState state;
+
+    for ( const auto& command : m_data->graphic.commands() )
+    {
+        switch( command.type() )
+        {
+            case QskPainterCommand::State:
+            {
+                state.update( *command.stateData() );
+                break;
+            }
+
+            case QskPainterCommand::Path:
+            {
+                const auto& path = *command.path();
+                if ( path.isEmpty() )
+                    break;
+
+                const auto rect = state.transform.mapRect( path.boundingRect() );
+
+                // like QPainter: filling first, then the outline
+
+                if ( state.brush.style() != Qt::NoBrush )
+                {
+                    const auto brush = colorFilter.substituted( state.brush );
+
+                    auto shapeNode = new QskShapeNode();
+                    shapeNode->updatePath( path, state.transform, rect,
+                        qskEffectiveGradient( brush, state.opacity, false ) );
+
+                    transformNode->appendChildNode( shapeNode );
+                    m_data->elements += { shapeNode, state.brush, rect, state.opacity, false };
+                }
+
+                if ( state.pen.style() != Qt::NoPen )
+                {
+                    auto pen = colorFilter.substituted( state.pen );
+                    if ( pen.brush().gradient() == nullptr )
+                        pen.setColor( qskEffectiveColor( pen.color(), state.opacity ) );
+
+                    auto strokeNode = new QskStrokeNode();
+                    strokeNode->updatePath( path, state.transform, pen );
+
+                    transformNode->appendChildNode( strokeNode );
+                    m_data->elements += { strokeNode,
+                        state.pen.brush(), rect, state.opacity, true };
+                }
+
+                break;
+            }
+
+            case QskPainterCommand::Pixmap:
+            {
+                const auto data = command.pixmapData();
+
+                const auto node = qskCreateImageNode( window,
+                    state.transform.mapRect( data->rect ),
+                    data->pixmap.toImage(), data->subRect );
+
+                if ( node )
+                    transformNode->appendChildNode( node );
+
+                break;
+            }
+
+            case QskPainterCommand::Image:
+            {
+                const auto data = command.imageData();
+
+                const auto node = qskCreateImageNode( window,
+                    state.transform.mapRect( data->rect ),
+                    data->image, data->subRect );
+
+                if ( node )
+                    transformNode->appendChildNode( node );
+
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+}
+
+void QskVectorGraphicNode::updateColors()
+{
+    const auto& colorFilter = m_data->colorFilter;
+
+    for ( const auto& element : std::as_const( m_data->elements ) )
+    {
+        const auto brush = colorFilter.substituted( element.brush );
+
+        if ( brush.gradient() )
+        {
+            const auto gradient = qskEffectiveGradient(
+                brush, element.opacity, element.isStroke );
+
+            element.node->setColoring( element.rect, gradient );
+        }
+        else
+        {
+            qskSetVertexColors( element.node,
+                qskEffectiveColor( brush.color(), element.opacity ) );
+        }
+    }
+}
+
+void QskVectorGraphicNode::updateMatrix()
+{
+    const auto& rect = m_data->rect;
+
+    auto transform = m_data->graphic.viewportTransform( rect );
+
+    if ( m_data->mirrored )
+    {
+        const auto sx = ( m_data->mirrored & Qt::Horizontal ) ? -1.0 : 1.0;
+        const auto sy = ( m_data->mirrored & Qt::Vertical ) ? -1.0 : 1.0;
+
+        QTransform mirror;
+        mirror.translate( rect.center().x(), rect.center().y() );
+        mirror.scale( sx, sy );
+        mirror.translate( -rect.center().x(), -rect.center().y() );
+
+        transform *= mirror;
+    }
+
+    const QMatrix4x4 matrix( transform );
+    if ( matrix != m_data->transformNode->matrix() )
+        m_data->transformNode->setMatrix( matrix );
+}
+
+bool QskVectorGraphicNode::isSupported( const QskGraphic& graphic )
+{
+    if ( graphic.isNull() )
+        return false;
+
+    if ( graphic.testRenderHint( QskGraphic::RenderPensUnscaled ) )
+        return false;
+
+    PaintState state;
+
+    for ( const auto& command : graphic.commands() )
+    {
+        switch( command.type() )
+        {
+            case QskPainterCommand::State:
+            {
+                state.update( *command.stateData() );
+                break;
+            }
+
+            case QskPainterCommand::Path:
+            {
+                if ( !qskIsPathSupported( state ) )
+                    return false;
+
+                break;
+            }
+
+            case QskPainterCommand::Pixmap:
+            case QskPainterCommand::Image:
+            {
+                if ( !qskIsRasterSupported( state ) )
+                    return false;
+
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    return true;
+}
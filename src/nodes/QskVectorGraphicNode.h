@@ -0,0 +1,56 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_VECTOR_GRAPHIC_NODE_H
+#define QSK_VECTOR_GRAPHIC_NODE_H
+
+#include "QskGlobal.h"
+#include <qsgnode.h>
+#include <memory>
+
+class QskGraphic;
+class QskColorFilter;
+class QQuickWindow;
+
+/*
+    QskVectorGraphicNode is an alternative to QskGraphicNode, that does not
+    rasterize the graphic. Instead the painter commands are compiled into
+    triangulated geometries ( QskShapeNode, QskStrokeNode ) in the coordinate
+    system of the graphic. The target rectangle is applied by the matrix
+    of an inner transform node, so that resizing does not require to compile
+    the commands again, while changing the color filter only updates the vertex
+    colors or the materials. The node itself is no QSGTransformNode and can
+    be translated by its parent like any other node.
+
+    Raster commands are rendered as textures. Graphics with commands, that can't
+    be done without QPainter ( clipping, composition modes, cosmetic pens ... ),
+    are not supported - see isSupported().
+ */
+class QSK_EXPORT QskVectorGraphicNode : public QSGNode
+{
+    using Inherited = QSGNode;
+
+  public:
+    QskVectorGraphicNode();
+    ~QskVectorGraphicNode() override;
+
+    void setMirrored( Qt::Orientations );
+    Qt::Orientations mirrored() const;
+
+    void setGraphic( QQuickWindow*, const QskGraphic&,
+        const QskColorFilter&, const QRectF& );
+
+    static bool isSupported( const QskGraphic& );
+
+  private:
+    void compile( QQuickWindow* );
+    void updateColors();
+    void updateMatrix();
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#version 440
+
+layout( location = 0 ) in vec2 coord;
+layout( location = 0 ) out vec4 fragColor;
+
+layout( std140, binding = 0 ) uniform buf
+{
+    mat4 matrix;
+    vec4 fillColor1;
+    vec4 fillColor2;
+    vec4 borderColor;
+    vec4 arc; // outer radius, inner radius, start angle, span angle
+    float borderWidth;
+    float pixelScale;
+    float opacity;
+} ubuf;
+
+const float PI = 3.14159265359;
+
+float capDistance( in vec2 point, in float angle )
+{
+    // distance to the ray from the center in direction of angle
+    vec2 v = vec2( cos( angle ), -sin( angle ) );
+
+    float s = dot( point, v );
+    return ( s > 0.0 ) ? abs( v.x * point.y - v.y * point.x ) : length( point );
+}
+
+void main()
+{
+    float r = length( coord );
+
+    // signed distance to the ring
+    float d = max( r - ubuf.arc.x, ubuf.arc.y - r );
+
+    float span = abs( ubuf.arc.w );
+
+    // counter clockwise angle relative to the start of the arc
+    float angle = atan( -coord.y, coord.x ) - ubuf.arc.z;
+    if ( ubuf.arc.w < 0.0 )
+        angle = -angle;
+
+    angle = mod( angle, 2.0 * PI );
+
+    float t = angle / max( span, 0.0001 );
+
+    if ( span < 2.0 * PI )
+    {
+        float dc = min( capDistance( coord, ubuf.arc.z ),
+            capDistance( coord, ubuf.arc.z + ubuf.arc.w ) );
+
+        d = max( d, ( angle <= span ) ? -dc : dc );
+    }
+
+    float aa = 0.5 / ubuf.pixelScale;
+
+    float outer = 1.0 - smoothstep( -aa, aa, d );
+    float inner = 1.0 - smoothstep( -aa, aa, d + ubuf.borderWidth );
+
+    vec4 fillColor = mix( ubuf.fillColor1, ubuf.fillColor2, clamp( t, 0.0, 1.0 ) );
+
+    fragColor = mix( ubuf.borderColor, fillColor, inner ) * outer * ubuf.opacity;
+}
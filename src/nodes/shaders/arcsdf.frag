@@ -0,0 +1,56 @@
+uniform lowp float opacity;
+uniform highp float pixelScale;
+uniform lowp vec4 fillColor1;
+uniform lowp vec4 fillColor2;
+uniform lowp vec4 borderColor;
+uniform highp vec4 arc; // outer radius, inner radius, start angle, span angle
+uniform highp float borderWidth;
+
+varying mediump vec2 coord;
+
+const highp float PI = 3.14159265359;
+
+highp float capDistance( in highp vec2 point, in highp float angle )
+{
+    // distance to the ray from the center in direction of angle
+    highp vec2 v = vec2( cos( angle ), -sin( angle ) );
+
+    highp float s = dot( point, v );
+    return ( s > 0.0 ) ? abs( v.x * point.y - v.y * point.x ) : length( point );
+}
+
+void main()
+{
+    highp float r = length( coord );
+
+    // signed distance to the ring
+    highp float d = max( r - arc.x, arc.y - r );
+
+    highp float span = abs( arc.w );
+
+    // counter clockwise angle relative to the start of the arc
+    highp float angle = atan( -coord.y, coord.x ) - arc.z;
+    if ( arc.w < 0.0 )
+        angle = -angle;
+
+    angle = mod( angle, 2.0 * PI );
+
+    lowp float t = angle / max( span, 0.0001 );
+
+    if ( span < 2.0 * PI )
+    {
+        highp float dc = min( capDistance( coord, arc.z ),
+            capDistance( coord, arc.z + arc.w ) );
+
+        d = max( d, ( angle <= span ) ? -dc : dc );
+    }
+
+    highp float aa = 0.5 / pixelScale;
+
+    lowp float outer = 1.0 - smoothstep( -aa, aa, d );
+    lowp float inner = 1.0 - smoothstep( -aa, aa, d + borderWidth );
+
+    lowp vec4 fillColor = mix( fillColor1, fillColor2, clamp( t, 0.0, 1.0 ) );
+
+    gl_FragColor = mix( borderColor, fillColor, inner ) * outer * opacity;
+}
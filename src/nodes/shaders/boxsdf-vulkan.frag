@@ -0,0 +1,65 @@
+#version 440
+
+layout( location = 0 ) in vec2 coord;
+layout( location = 0 ) out vec4 fragColor;
+
+layout( std140, binding = 0 ) uniform buf
+{
+    mat4 matrix;
+    vec4 radius;
+    vec4 innerRadius;
+    vec4 fillColor1;
+    vec4 fillColor2;
+    vec4 borderColor;
+    vec4 gradientVector;
+    vec2 size;
+    vec2 innerOffset;
+    vec2 innerSize;
+    float pixelScale;
+    float opacity;
+} ubuf;
+
+float effectiveRadius( in vec4 radii, in vec2 point )
+{
+    if ( point.x > 0.0 )
+        return ( point.y > 0.0 ) ? radii.x : radii.y;
+    else
+        return ( point.y > 0.0 ) ? radii.z : radii.w;
+}
+
+float boxDistance( in vec2 point, in vec2 size, in vec4 radii )
+{
+    // signed distance to a box with rounded corners, centered at ( 0, 0 )
+    float r = effectiveRadius( radii, point );
+
+    vec2 d = abs( point ) - size + r;
+    return min( max( d.x, d.y ), 0.0 ) + length( max( d, 0.0 ) ) - r;
+}
+
+void main()
+{
+    float aa = 0.5 / ubuf.pixelScale;
+
+    float outer = 1.0 - smoothstep( -aa, aa,
+        boxDistance( coord, ubuf.size, ubuf.radius ) );
+
+    float inner = 0.0;
+    if ( ubuf.innerSize.x > 0.0 )
+    {
+        vec2 p = coord - ubuf.innerOffset;
+        inner = 1.0 - smoothstep( -aa, aa,
+            boxDistance( p, ubuf.innerSize, ubuf.innerRadius ) );
+    }
+
+    vec2 v = ubuf.gradientVector.zw - ubuf.gradientVector.xy;
+
+    float t = 0.0;
+
+    float l = dot( v, v );
+    if ( l > 0.0 )
+        t = clamp( dot( coord - ubuf.gradientVector.xy, v ) / l, 0.0, 1.0 );
+
+    vec4 fillColor = mix( ubuf.fillColor1, ubuf.fillColor2, t );
+
+    fragColor = mix( ubuf.borderColor, fillColor, inner ) * outer * ubuf.opacity;
+}
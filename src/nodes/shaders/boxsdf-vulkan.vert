@@ -0,0 +1,30 @@
+#version 440
+
+layout( location = 0 ) in vec4 in_vertex;
+layout( location = 1 ) in vec2 in_coord;
+
+layout( location = 0 ) out vec2 coord;
+
+layout( std140, binding = 0 ) uniform buf
+{
+    mat4 matrix;
+    vec4 radius;
+    vec4 innerRadius;
+    vec4 fillColor1;
+    vec4 fillColor2;
+    vec4 borderColor;
+    vec4 gradientVector;
+    vec2 size;
+    vec2 innerOffset;
+    vec2 innerSize;
+    float pixelScale;
+    float opacity;
+} ubuf;
+
+out gl_PerVertex { vec4 gl_Position; };
+
+void main()
+{
+    coord = in_coord;
+    gl_Position = ubuf.matrix * in_vertex;
+}
@@ -0,0 +1,57 @@
+uniform lowp float opacity;
+uniform highp float pixelScale;
+uniform highp vec4 radius;
+uniform highp vec4 innerRadius;
+uniform lowp vec4 fillColor1;
+uniform lowp vec4 fillColor2;
+uniform lowp vec4 borderColor;
+uniform highp vec4 gradientVector;
+uniform highp vec2 size;
+uniform highp vec2 innerOffset;
+uniform highp vec2 innerSize;
+
+varying highp vec2 coord;
+
+highp float effectiveRadius( in highp vec4 radii, in highp vec2 point )
+{
+    if ( point.x > 0.0 )
+        return ( point.y > 0.0 ) ? radii.x : radii.y;
+    else
+        return ( point.y > 0.0 ) ? radii.z : radii.w;
+}
+
+highp float boxDistance( in highp vec2 point, in highp vec2 size, in highp vec4 radii )
+{
+    // signed distance to a box with rounded corners, centered at ( 0, 0 )
+    highp float r = effectiveRadius( radii, point );
+
+    highp vec2 d = abs( point ) - size + r;
+    return min( max( d.x, d.y ), 0.0 ) + length( max( d, 0.0 ) ) - r;
+}
+
+void main()
+{
+    highp float aa = 0.5 / pixelScale;
+
+    lowp float outer = 1.0 - smoothstep( -aa, aa,
+        boxDistance( coord, size, radius ) );
+
+    lowp float inner = 0.0;
+    if ( innerSize.x > 0.0 )
+    {
+        inner = 1.0 - smoothstep( -aa, aa,
+            boxDistance( coord - innerOffset, innerSize, innerRadius ) );
+    }
+
+    highp vec2 v = gradientVector.zw - gradientVector.xy;
+
+    lowp float t = 0.0;
+
+    highp float l = dot( v, v );
+    if ( l > 0.0 )
+        t = clamp( dot( coord - gradientVector.xy, v ) / l, 0.0, 1.0 );
+
+    lowp vec4 fillColor = mix( fillColor1, fillColor2, t );
+
+    gl_FragColor = mix( borderColor, fillColor, inner ) * outer * opacity;
+}
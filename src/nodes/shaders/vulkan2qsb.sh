@@ -9,9 +9,15 @@ function qsbcompile {
 qsbcompile arcshadow-vulkan.vert
 qsbcompile arcshadow-vulkan.frag
 
+qsbcompile arcsdf-vulkan.vert
+qsbcompile arcsdf-vulkan.frag
+
 qsbcompile boxshadow-vulkan.vert
 qsbcompile boxshadow-vulkan.frag
 
+qsbcompile boxsdf-vulkan.vert
+qsbcompile boxsdf-vulkan.frag
+
 qsbcompile gradientconic-vulkan.vert
 qsbcompile gradientconic-vulkan.frag
 
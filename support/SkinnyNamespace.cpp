@@ -12,9 +12,14 @@
 #include <QGuiApplication>
 #include <QByteArray>
 #include <QDir>
+#include <QFile>
 #include <QFont>
 #include <QDebug>
 
+#if defined( Q_OS_LINUX )
+    #include <unistd.h>
+#endif
+
 #if defined( PLUGIN_PATH )
 
 #define STRINGIFY(x) #x
@@ -158,3 +163,25 @@ void Skinny::init()
         the lib and all initializaion take place
      */
 }
+
+qint64 Skinny::residentBytes()
+{
+#if defined( Q_OS_LINUX )
+    const auto pageSize = sysconf( _SC_PAGESIZE );
+    if ( pageSize <= 0 )
+        return -1;
+
+    // size and resident pages
+    QFile file( QStringLiteral( "/proc/self/statm" ) );
+    if ( !file.open( QIODevice::ReadOnly ) )
+        return -1;
+
+    const auto fields = file.readAll().split( ' ' );
+    if ( fields.size() < 2 )
+        return -1;
+
+    return fields[1].toLongLong() * pageSize;
+#else
+    return -1;
+#endif
+}
@@ -14,4 +14,7 @@ namespace Skinny
     SKINNY_EXPORT void changeColorScheme();
     SKINNY_EXPORT void changeFonts( int increment );
     SKINNY_EXPORT void init();
+
+    // resident set size of the process ( Linux only ), -1 when unknown
+    SKINNY_EXPORT qint64 residentBytes();
 }
@@ -22,7 +22,7 @@
 
 static void usage( const char* appName )
 {
-    qWarning() << "usage: " << appName << "<svgfile> <qvgfile>";
+    qWarning() << "usage: " << appName << "[-v2] <svgfile> <qvgfile>";
 }
 
 static QRectF viewBox( QSvgRenderer& renderer )
@@ -65,12 +65,26 @@ class Graphic : public QskGraphic
 
 int main( int argc, char* argv[] )
 {
-    if ( argc != 3 )
+    auto version = QskGraphicIO::Version1;
+
+    int argIndex = 1;
+
+    if ( argc == 4 && qstrcmp( argv[1], "-v2" ) == 0 )
+    {
+        // the flat format, that is decoded lazily
+        version = QskGraphicIO::Version2;
+        argIndex++;
+    }
+
+    if ( argc - argIndex != 2 )
     {
         usage( argv[0] );
         return -1;
     }
 
+    const auto svgFile = argv[ argIndex ];
+    const auto qvgFile = argv[ argIndex + 1 ];
+
 #if 0
     /*
         When there are no "text" parts in the SVGs we can avoid
@@ -90,7 +104,7 @@ int main( int argc, char* argv[] )
 #endif
 
     QSvgRenderer renderer;
-    if ( !renderer.load( QString( argv[1] ) ) )
+    if ( !renderer.load( QString( svgFile ) ) )
         return -2;
 
     Graphic graphic;
@@ -101,9 +115,9 @@ int main( int argc, char* argv[] )
     painter.end();
 
     if ( graphic.commandTypes() & QskGraphic::RasterData )
-        qWarning() << argv[1] << "contains non scalable parts.";
+        qWarning() << svgFile << "contains non scalable parts.";
 
-    QskGraphicIO::write( graphic, argv[2] );
+    QskGraphicIO::write( graphic, qvgFile, version );
 
     return 0;
 }